@@ -0,0 +1,138 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+// Accuracy audit, Benchmark.exe --accuracy: runs the float functions and their double precision versions from Double.h
+// on the same random inputs and reports how far the float results are off, in ULPs (units in the last place).
+// Every call counts the worst component of its result, measured in float ULPs at the largest component of the reference
+// (per column for matrices), so a component that cancels to nearly 0 does not show up as millions of ULPs.
+#include "Benchmark.h"
+#include <MMath/Friends.h>
+#include <MMath/Double.h>
+#include <float.h>
+#include <math.h>
+
+// Calls per function, the inputs are the first ACCURACY_CASES of the shared benchmark inputs
+static const unsigned int ACCURACY_CASES = 1 << 16;
+
+// Inputs are converted exactly, so only the math itself differs
+static double AccuracyToDouble(const float v) { return (double)v; }
+static __m256d AccuracyToDouble(const __m128 v) { return VecToVecD(v); }
+static QuatD AccuracyToDouble(const Quat& q) { return QuatToQuatD(q); }
+static Mat44D AccuracyToDouble(const Mat44& m) { return Mat44ToMat44D(m); }
+static ERotateOrder AccuracyToDouble(const ERotateOrder rotateOrder) { return rotateOrder; }
+
+// The Mode functions with a fixed mode, so they take the same arguments as their reference
+template<ENormalizeMode MODE> static Vec Vec4NormalizedAs(const __m128 v, const __m128 fallback) { return Vec4NormalizedMode(v, fallback, MODE); }
+template<ENormalizeMode MODE> static Vec Vec3NormalizedAs(const __m128 v, const __m128 fallback) { return Vec3NormalizedMode(v, fallback, MODE); }
+template<ENormalizeMode MODE> static Quat QuatNormalizedAs(const Quat q, const Quat fallback) { return QuatNormalizedMode(q, fallback, MODE); }
+
+// Distance between two adjacent floats at the magnitude of reference
+static double AccuracyUlp(const double reference)
+{
+	int exponent;
+	frexp(fmax(fabs(reference), (double)FLT_MIN), &exponent);
+	return ldexp(1.0, exponent - 24);
+}
+
+static double AccuracyUlps(const float* result, const double* reference, const unsigned int count)
+{
+	double scale = 0.0;
+	double error = 0.0;
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		scale = fmax(scale, fabs(reference[i]));
+		error = fmax(error, fabs((double)result[i] - reference[i]));
+	}
+	return error / AccuracyUlp(scale);
+}
+static double AccuracyUlps(const float result, const double reference) { return AccuracyUlps(&result, &reference, 1); }
+static double AccuracyUlps(const Vec& result, const VecD& reference) { return AccuracyUlps(&result.x, &reference.x, 4); }
+static double AccuracyUlps(const Quat& result, const QuatD& reference) { return AccuracyUlps(result.s, reference.s, 4); }
+static double AccuracyUlps(const Mat44& result, const Mat44D& reference)
+{
+	double ulps = 0.0;
+	for (unsigned int column = 0; column < 4; ++column)
+		ulps = fmax(ulps, AccuracyUlps(&result.m[column * 4], &reference.m[column * 4], 4));
+	return ulps;
+}
+
+template<typename R, typename RD, typename... A, typename... AD, size_t... I>
+static void _BenchmarkAccuracy(const char* name, R(*fn)(A...), RD(*reference)(AD...), std::index_sequence<I...>)
+{
+	const std::tuple<const A*...> in(BenchmarkInput<A>((unsigned int)I)...);
+	double maxUlps = 0.0;
+	double sumUlps = 0.0;
+	unsigned int worstCase = 0;
+	for (unsigned int i = 0; i < ACCURACY_CASES; ++i)
+	{
+		const double ulps = AccuracyUlps(fn(std::get<I>(in)[i]...), reference(AccuracyToDouble(std::get<I>(in)[i])...));
+		if (!(ulps <= maxUlps)) // NaN counts as the worst
+		{
+			maxUlps = ulps;
+			worstCase = i;
+		}
+		sumUlps += ulps;
+	}
+	BenchmarkRecordAccuracy(name, ACCURACY_CASES, maxUlps, sumUlps / ACCURACY_CASES, worstCase);
+}
+
+// Compares fn against reference, its double precision version taking the same arguments
+template<typename R, typename RD, typename... A, typename... AD>
+static void BenchmarkAccuracy(const char* name, R(*fn)(A...), RD(*reference)(AD...))
+{
+	static_assert(sizeof...(A) == sizeof...(AD), "the reference must take the same arguments");
+	if (BenchmarkEnabled(name))
+		_BenchmarkAccuracy(name, fn, reference, std::index_sequence_for<A...>{});
+}
+
+void RunAccuracyAudit()
+{
+	// Vector.h
+	BenchmarkAccuracy("Vec4Dot", &Vec4Dot, &Vec4DotD);
+	BenchmarkAccuracy("Vec4Magnitude", &Vec4Magnitude, &Vec4MagnitudeD);
+	BenchmarkAccuracy("Vec4Normalized", &Vec4Normalized, &Vec4NormalizedD);
+	BenchmarkAccuracy("Vec4NormalizedMode (Refined)", &Vec4NormalizedAs<ENormalizeMode::Refined>, &Vec4NormalizedD);
+	BenchmarkAccuracy("Vec4NormalizedMode (Exact)", &Vec4NormalizedAs<ENormalizeMode::Exact>, &Vec4NormalizedD);
+	BenchmarkAccuracy("Vec3Dot", &Vec3Dot, &Vec3DotD);
+	BenchmarkAccuracy("Vec3Cross", &Vec3Cross, &Vec3CrossD);
+	BenchmarkAccuracy("Vec3Magnitude", &Vec3Magnitude, &Vec3MagnitudeD);
+	BenchmarkAccuracy("Vec3Normalized", &Vec3Normalized, &Vec3NormalizedD);
+	BenchmarkAccuracy("Vec3NormalizedMode (Refined)", &Vec3NormalizedAs<ENormalizeMode::Refined>, &Vec3NormalizedD);
+	BenchmarkAccuracy("Vec3NormalizedMode (Exact)", &Vec3NormalizedAs<ENormalizeMode::Exact>, &Vec3NormalizedD);
+	BenchmarkAccuracy("Vec2Dot", &Vec2Dot, &Vec2DotD);
+	BenchmarkAccuracy("Vec2Cross", &Vec2Cross, &Vec2CrossD);
+	BenchmarkAccuracy("Vec2Magnitude", &Vec2Magnitude, &Vec2MagnitudeD);
+	BenchmarkAccuracy("Vec2Normalized", &Vec2Normalized, &Vec2NormalizedD);
+
+	// Quat.h
+	BenchmarkAccuracy("QuatRotateX", &QuatRotateX, &QuatRotateXD);
+	BenchmarkAccuracy("QuatMul", &QuatMul, &QuatMulD);
+	BenchmarkAccuracy("QuatMagnitude", &QuatMagnitude, &QuatMagnitudeD);
+	BenchmarkAccuracy("QuatNormalized", &QuatNormalized, &QuatNormalizedD);
+	BenchmarkAccuracy("QuatNormalizedMode (Fast)", &QuatNormalizedAs<ENormalizeMode::Fast>, &QuatNormalizedD);
+	BenchmarkAccuracy("QuatNormalizedMode (Refined)", &QuatNormalizedAs<ENormalizeMode::Refined>, &QuatNormalizedD);
+	BenchmarkAccuracy("QuatSlerp", &QuatSlerp, &QuatSlerpD);
+	BenchmarkAccuracy("QuatVectorTransform", &QuatVectorTransform, &QuatVectorTransformD);
+	BenchmarkAccuracy("QuatToMat44", &QuatToMat44, &QuatToMat44D);
+
+	// Mat44.h
+	BenchmarkAccuracy("Mat44RotateX", &Mat44RotateX, &Mat44RotateXD);
+	BenchmarkAccuracy("Mat44Rotate", &Mat44Rotate, &Mat44RotateD);
+	BenchmarkAccuracy("Mat44TRS", &Mat44TRS, &Mat44TRSD);
+	BenchmarkAccuracy("Mat44Mul", &Mat44Mul, &Mat44MulD);
+	BenchmarkAccuracy("Mat44Inversed", &Mat44Inversed, &Mat44InversedD);
+	// The random matrices are TRS without shear, which is all Mat44InversedFast needs
+	BenchmarkAccuracy("Mat44InversedFast", &Mat44InversedFast, &Mat44InversedD);
+	BenchmarkAccuracy("Mat44Determinant", &Mat44Determinant, &Mat44DeterminantD);
+	BenchmarkAccuracy("Mat44VectorTransform", &Mat44VectorTransform, &Mat44VectorTransformD);
+	BenchmarkAccuracy("Mat44ToScale", &Mat44ToScale, &Mat44ToScaleD);
+}
@@ -0,0 +1,1200 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+// Functions that take pointers to whole arrays. They are only timed in throughput mode, per element.
+// Where a loop over the scalar functions is the reference the results are validated as well.
+// Vec3StreamAlloc, Vec3StreamFree and the Dispatch functions are not timed.
+#include "Benchmark.h"
+#include <MMath/MMath.h>
+#include <MMath/SIMD.h>
+#include <MMath/Friends.h>
+#include <MMath/Stream.h>
+#include <MMath/Hierarchy.h>
+#include <MMath/Skinning.h>
+#include <MMath/XForm.h>
+#include <MMath/Culling.h>
+#include <MMath/Intersect.h>
+#include <MMath/BVH.h>
+#include <MMath/Parallel.h>
+#include <MMath/Double.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#undef min
+#undef max
+
+// Joints in the palette of the skinning benchmark, a detailed character
+static const unsigned int BENCHMARK_PALETTE_COUNT = 128;
+
+static void BenchmarkMat44Arrays()
+{
+	const Mat44* children = BenchmarkInput<Mat44>(0);
+	const Mat44* parents = BenchmarkInput<Mat44>(1);
+	Mat44* result = BenchmarkOutput<Mat44>();
+	BenchmarkBatch("Mat44MulArray", [&](const unsigned int count) { Mat44MulArray(children, parents, result, count); });
+	if (BenchmarkEnabled("Mat44MulArray"))
+	{
+		// Both paths do the exact same float operations, so the results must match bit for bit
+		Mat44MulArray(children, parents, result, BENCHMARK_COLD_COUNT);
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			const Mat44 looped = Mat44Mul(children[i], parents[i]);
+			if (memcmp(&looped, &result[i], sizeof(Mat44)) != 0)
+			{
+				BenchmarkFail("Mat44MulArray does not match Mat44Mul at %u\n", i);
+				break;
+			}
+		}
+	}
+
+	const Mat34* affineChildren = BenchmarkInput<Mat34>(0);
+	const Mat34* affineParents = BenchmarkInput<Mat34>(1);
+	Mat34* affineResult = BenchmarkOutput<Mat34>();
+	BenchmarkBatch("Mat34MulArray", [&](const unsigned int count) { Mat34MulArray(affineChildren, affineParents, affineResult, count); });
+	if (BenchmarkEnabled("Mat34MulArray"))
+	{
+		// Skipping the fourth row reorders the additions, so allow for rounding
+		Mat34MulArray(affineChildren, affineParents, affineResult, BENCHMARK_COLD_COUNT);
+		float maxError = 0.0f;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			const Mat44 looped = Mat44Mul(Mat34ToMat44(affineChildren[i]), Mat34ToMat44(affineParents[i]));
+			const Mat44 affine = Mat34ToMat44(affineResult[i]);
+			for (unsigned int k = 0; k < 16; ++k)
+				maxError = fmaxf(maxError, fabsf(looped.m[k] - affine.m[k]) / (1.0f + fabsf(looped.m[k])));
+		}
+		if (maxError > 1e-5f)
+			BenchmarkFail("Mat34MulArray deviates %e from Mat44Mul\n", maxError);
+	}
+
+	BenchmarkBatch("Mat44InversedArray", [&](const unsigned int count) { Mat44InversedArray(children, result, count); });
+	float* determinants = BenchmarkOutput<float>();
+	unsigned char* singular = (unsigned char*)BenchmarkOutput<float>(1);
+	BenchmarkBatch("Mat44InversedCheckedArray", [&](const unsigned int count) { Mat44InversedCheckedArray(children, 1e-6f, result, determinants, singular, count); });
+	if (BenchmarkEnabled("Mat44InversedCheckedArray"))
+	{
+		// The random TRS matrices are all well conditioned, the cofactor expansion only rounds differently
+		Mat44InversedCheckedArray(children, 1e-6f, result, determinants, singular, BENCHMARK_COLD_COUNT);
+		float maxError = 0.0f;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			if (singular[i / 8] & (1 << (i % 8)))
+			{
+				BenchmarkFail("Mat44InversedCheckedArray flagged invertible matrix %u\n", i);
+				break;
+			}
+			const Mat44 inverse = Mat44Inversed(children[i]);
+			for (unsigned int k = 0; k < 16; ++k)
+				maxError = fmaxf(maxError, fabsf(inverse.m[k] - result[i].m[k]) / (1.0f + fabsf(inverse.m[k])));
+			maxError = fmaxf(maxError, fabsf(determinants[i] - Mat44Determinant(children[i])) / fabsf(determinants[i]));
+		}
+		if (maxError > 1e-5f)
+			BenchmarkFail("Mat44InversedCheckedArray deviates %e from Mat44Inversed\n", maxError);
+
+		// Bad matrices between good ones, in full blocks and in the partial block at the end (37 = 4 * 9 + 1 = 8 * 4 + 5).
+		// diag(1, 1, d, 1) has 1 / (|m| * |inverse|) = 1 / sqrt((3 + d * d) * (3 + 1 / (d * d))), which crosses 1e-6 at d = 1.73e-6.
+		const unsigned int checkedCount = 37;
+		Mat44 checked[checkedCount];
+		Mat44 checkedResult[checkedCount];
+		float checkedDeterminants[checkedCount];
+		unsigned char checkedSingular[(checkedCount + 7) / 8];
+		unsigned char expectedSingular[(checkedCount + 7) / 8] = {};
+		for (unsigned int i = 0; i < checkedCount; ++i)
+			checked[i] = children[i];
+		auto flag = [&](const unsigned int i) { expectedSingular[i / 8] |= 1 << (i % 8); };
+		checked[0].col1 = F32_ZERO; // zero column
+		flag(0);
+		checked[7].col2 = checked[7].col0; // equal columns
+		flag(7);
+		checked[13] = Mat44Scale(1.0f, 1.0f, 1.9e-6f); // just under the threshold
+		checked[14] = Mat44Scale(1.0f, 1.0f, 1.6e-6f); // just over
+		flag(14);
+		checked[20].m[5] = NAN;
+		flag(20);
+		checked[26].m[12] = INFINITY;
+		flag(26);
+		checked[33].col3 = F32_ZERO; // zero column in the partial block
+		flag(33);
+		checked[35].m[10] = NAN;
+		flag(35);
+		checked[36] = Mat44Scale(1.0f, 1.0f, 1.9e-6f);
+		Mat44InversedCheckedArray(checked, 1e-6f, checkedResult, checkedDeterminants, checkedSingular, checkedCount);
+		if (memcmp(checkedSingular, expectedSingular, sizeof(checkedSingular)) != 0)
+			BenchmarkFail("Mat44InversedCheckedArray singular mask %02x %02x %02x %02x %02x, expected %02x %02x %02x %02x %02x\n",
+				checkedSingular[0], checkedSingular[1], checkedSingular[2], checkedSingular[3], checkedSingular[4],
+				expectedSingular[0], expectedSingular[1], expectedSingular[2], expectedSingular[3], expectedSingular[4]);
+		const Mat44 zero = { F32_ZERO, F32_ZERO, F32_ZERO, F32_ZERO };
+		for (unsigned int i = 0; i < checkedCount; ++i)
+		{
+			if (expectedSingular[i / 8] & (1 << (i % 8)))
+			{
+				if (memcmp(&checkedResult[i], &zero, sizeof(Mat44)) != 0)
+					BenchmarkFail("Mat44InversedCheckedArray wrote a non-zero inverse for singular matrix %u\n", i);
+				continue;
+			}
+			const Mat44 inverse = Mat44Inversed(checked[i]);
+			float error = fabsf(checkedDeterminants[i] - Mat44Determinant(checked[i])) / fabsf(checkedDeterminants[i]);
+			for (unsigned int k = 0; k < 16; ++k)
+				error = fmaxf(error, fabsf(inverse.m[k] - checkedResult[i].m[k]) / (1.0f + fabsf(inverse.m[k])));
+			if (!(error <= 1e-5f))
+				BenchmarkFail("Mat44InversedCheckedArray deviates %e from Mat44Inversed at %u, next to singular matrices\n", error, i);
+		}
+	}
+
+	const __m128* vectors = BenchmarkInput<__m128>(0);
+	Vec* vecs = BenchmarkOutput<Vec>();
+	BenchmarkBatch("Mat44VectorTransformArray", [&](const unsigned int count) { Mat44VectorTransformArray(children[0], vectors, vecs, count); });
+
+	const __m128* translates = BenchmarkInput<__m128>(1);
+	const __m128* radians = BenchmarkInput<__m128>(2);
+	const __m128* scales = BenchmarkInput<__m128>(3);
+	BenchmarkBatch("Mat44TRSArray", [&](const unsigned int count) { Mat44TRSArray(translates, radians, scales, ERotateOrder::XYZ, result, count); });
+	Vec* outTranslates = BenchmarkOutput<Vec>(1);
+	Vec* outRadians = BenchmarkOutput<Vec>(2);
+	Vec* outScales = BenchmarkOutput<Vec>(3);
+	BenchmarkBatch("Mat44ToTRSArray", [&](const unsigned int count) { Mat44ToTRSArray(children, ERotateOrder::XYZ, outTranslates, outRadians, outScales, count); });
+}
+
+static void BenchmarkConversionArrays()
+{
+	const Quat* quats = BenchmarkInput<Quat>(0);
+	const Mat44* matrices = BenchmarkInput<Mat44>(0);
+	Mat44* outMatrices = BenchmarkOutput<Mat44>();
+	Quat* outQuats = BenchmarkOutput<Quat>();
+	DualQuat* outDualQuats = BenchmarkOutput<DualQuat>();
+	BenchmarkBatch("QuatToMat44Array", [&](const unsigned int count) { QuatToMat44Array(quats, outMatrices, count); });
+	BenchmarkBatch("Mat44ToQuatArray", [&](const unsigned int count) { Mat44ToQuatArray(matrices, outQuats, count); });
+	if (BenchmarkEnabled("Mat44ToQuatArray"))
+	{
+		// Round trip the random rotations (all 4 branches), then the rotations halfway to them.
+		// normalize(q + identity) turns at most 90 degrees, so w >= cos(45) and the trace 4 * w * w - 1 is positive.
+		Quat* halfway = BenchmarkOutput<Quat>(1);
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			const Quat q = quats[i].w < 0.0f ? Quat{ _mm_neg_ps(quats[i].q) } : quats[i];
+			halfway[i] = QuatNormalized({ _mm_add_ps(q.q, F32_UNIT_W) }, { F32_UNIT_W });
+		}
+		for (const Quat* input : { quats, (const Quat*)halfway })
+		{
+			QuatToMat44Array(input, outMatrices, BENCHMARK_COLD_COUNT);
+			Mat44ToQuatArray(outMatrices, outQuats, BENCHMARK_COLD_COUNT);
+			for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+			{
+				// q and -q are the same rotation
+				const float sign = QuatDot(input[i], outQuats[i]) < 0.0f ? -1.0f : 1.0f;
+				float error = 0.0f;
+				for (unsigned int k = 0; k < 4; ++k)
+					error = fmaxf(error, fabsf(outQuats[i].s[k] * sign - input[i].s[k]));
+				// Mat44ToQuat normalizes with _mm_rsqrt_ps, which is off by up to 1.5 * 2^-12
+				if (!(error <= 4e-4f) || (input == halfway && !(outMatrices[i].m00 + outMatrices[i].m11 + outMatrices[i].m22 > 0.0f)))
+				{
+					BenchmarkFail("Mat44ToQuat(QuatToMat44(q)) deviates %e from q at %u (trace %f)\n", error, i, outMatrices[i].m00 + outMatrices[i].m11 + outMatrices[i].m22);
+					break;
+				}
+			}
+		}
+	}
+	BenchmarkBatch("Mat44ToDualQuatArray", [&](const unsigned int count) { Mat44ToDualQuatArray(matrices, outDualQuats, count); });
+	BenchmarkBatch("XFormToMat44Array", [&](const unsigned int count) { XFormToMat44Array(BenchmarkInput<XForm>(0), outMatrices, count); });
+	BenchmarkBatch("XFormScaleToMat44Array", [&](const unsigned int count) { XFormScaleToMat44Array(BenchmarkInput<XFormScale>(0), outMatrices, count); });
+}
+
+static void BenchmarkXFormLayering()
+{
+	// Composing TRS values through matrices, as we had to before XFormScale, against composing them directly
+	const XFormScale* children = BenchmarkInput<XFormScale>(0);
+	const XFormScale* parents = BenchmarkInput<XFormScale>(1);
+	XFormScale* result = BenchmarkOutput<XFormScale>();
+	Mat44* childMatrices = BenchmarkOutput<Mat44>(0);
+	Mat44* parentMatrices = BenchmarkOutput<Mat44>(1);
+	BenchmarkBatch("XFormScaleMulArray (through Mat44)", [&](const unsigned int count)
+	{
+		XFormScaleToMat44Array(children, childMatrices, count);
+		XFormScaleToMat44Array(parents, parentMatrices, count);
+		Mat44MulArray(childMatrices, parentMatrices, childMatrices, count);
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = Mat44ToXFormScale(childMatrices[i]);
+	});
+	BenchmarkBatch("XFormScaleMulArray", [&](const unsigned int count) { XFormScaleMulArray(children, parents, result, count); });
+	if (BenchmarkEnabled("XFormScaleMulArray"))
+	{
+		// The random inputs have uniform scale, so composing them directly is exact
+		XFormScaleMulArray(children, parents, result, BENCHMARK_COLD_COUNT);
+		float maxError = 0.0f;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			const Mat44 looped = Mat44Mul(XFormScaleToMat44(children[i]), XFormScaleToMat44(parents[i]));
+			const Mat44 direct = XFormScaleToMat44(result[i]);
+			for (unsigned int k = 0; k < 16; ++k)
+				maxError = fmaxf(maxError, fabsf(looped.m[k] - direct.m[k]) / (1.0f + fabsf(looped.m[k])));
+		}
+		if (maxError > 1e-5f)
+			BenchmarkFail("XFormScaleMulArray deviates %e from Mat44Mul\n", maxError);
+	}
+	if (BenchmarkEnabled("XFormScaleInversed"))
+	{
+		// A mirrored x axis, rotating around x keeps the scale uniform in the plane it rotates so the inverse is exact
+		const float* angles = BenchmarkInput<float>(0);
+		float maxError = 0.0f;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			const XFormScale x = { QuatRotateX(angles[i]), children[i].translate, _mm_set_ps(0.0f, 3.0f, 3.0f, -2.0f) };
+			const Mat44 m = Mat44Mul(XFormScaleToMat44(x), XFormScaleToMat44(XFormScaleInversed(x)));
+			for (unsigned int k = 0; k < 16; ++k)
+			{
+				const float e = fabsf(m.m[k] - ((k % 5) == 0 ? 1.0f : 0.0f));
+				if (!(e <= maxError))
+					maxError = e;
+			}
+		}
+		if (!(maxError <= 1e-5f))
+			BenchmarkFail("XFormScaleInversed with a negative scale axis deviates %e from identity\n", maxError);
+		// Collapsed axes (and w) stay 0
+		const XFormScale collapsed = { QuatIdentity(), F32_ZERO, _mm_set_ps(0.0f, 2.0f, -2.0f, 0.0f) };
+		const __m128 inverseScale = XFormScaleInversed(collapsed).scale;
+		if (inverseScale.m128_f32[0] != 0.0f || inverseScale.m128_f32[1] != -0.5f || inverseScale.m128_f32[2] != 0.5f || inverseScale.m128_f32[3] != 0.0f)
+			BenchmarkFail("XFormScaleInversed inverts scale (0, -2, 2) to (%f, %f, %f, %f)\n", inverseScale.m128_f32[0], inverseScale.m128_f32[1], inverseScale.m128_f32[2], inverseScale.m128_f32[3]);
+	}
+}
+
+static void BenchmarkQuatBlend()
+{
+	const Quat* a = BenchmarkInput<Quat>(0);
+	const Quat* b = BenchmarkInput<Quat>(1);
+	const float* t = BenchmarkInput<float>(2);
+	Quat* result = BenchmarkOutput<Quat>();
+	BenchmarkBatch("QuatSlerpArray", [&](const unsigned int count) { QuatSlerpArray(a, b, t, result, count); });
+	BenchmarkBatch("QuatNlerpArray", [&](const unsigned int count) { QuatNlerpArray(a, b, t, result, count, false); });
+	BenchmarkBatch("QuatNlerpArray (corrected)", [&](const unsigned int count) { QuatNlerpArray(a, b, t, result, count, true); });
+	if (!BenchmarkEnabled("QuatSlerpArray") && !BenchmarkEnabled("QuatNlerpArray"))
+		return;
+
+	// The inputs span -PI to PI, blending (and the nlerp correction in particular) is only meant for 0 to 1
+	float* fraction = new float[BENCHMARK_COLD_COUNT];
+	for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		fraction[i] = fabsf(t[i]) / PI;
+
+	// Pairs that take the other branches, in full blocks and in the partial block at the end (37 = 4 * 9 + 1 = 8 * 4 + 5).
+	// The linear fallback starts at a rotation of 2 * acos(QUAT_SLERP_LINEAR_THRESHOLD) = 8.94e-3 radians.
+	const unsigned int edgeCount = 37;
+	Quat edgeA[edgeCount], edgeB[edgeCount];
+	float edgeT[edgeCount];
+	for (unsigned int i = 0; i < edgeCount; ++i)
+	{
+		const float angles[] = { 0.3f, 2.5f, 8.9e-3f, 9.0e-3f, 1e-4f, 0.0f };
+		const float angle = angles[i % 6];
+		// identical pairs use the identity, where the dot product is exactly 1
+		edgeA[i] = angle == 0.0f ? QuatIdentity() : a[i];
+		edgeB[i] = QuatMul(edgeA[i], QuatRotateX(angle));
+		if (i % 4 == 1)
+			edgeB[i].q = _mm_neg_ps(edgeB[i].q); // negative dot, the same rotation the long way around
+		edgeT[i] = (i % 5 == 0) ? (float)(i % 2) : fraction[i];
+	}
+
+	// Worst component difference with the normalized double precision result, NaN if any component is NaN
+	auto deviation = [](const Quat& q, QuatD reference)
+	{
+		const double length = sqrt(reference.x * reference.x + reference.y * reference.y + reference.z * reference.z + reference.w * reference.w);
+		double error = 0.0;
+		for (unsigned int k = 0; k < 4; ++k)
+		{
+			const double e = fabs(q.s[k] - reference.s[k] / length);
+			if (!(e <= error) && error == error)
+				error = e;
+		}
+		return error;
+	};
+	// Normalized lerp along the shortest path, what QuatNlerpArray computes without the correction
+	auto nlerp = [](const Quat& l, const Quat& r, const float weight)
+	{
+		const QuatD ld = QuatToQuatD(l);
+		QuatD rd = QuatToQuatD(r);
+		const double sign = QuatDotD(ld, rd) < 0.0 ? -1.0 : 1.0;
+		QuatD q;
+		for (unsigned int k = 0; k < 4; ++k)
+			q.s[k] = ld.s[k] * (1.0 - weight) + rd.s[k] * sign * weight;
+		return q;
+	};
+	auto check = [&](const char* name, const Quat* l, const Quat* r, const float* s, const unsigned int count, const int mode, const double tolerance)
+	{
+		if (mode == 0)
+			QuatSlerpArray(l, r, s, result, count);
+		else
+			QuatNlerpArray(l, r, s, result, count, mode == 2);
+		// Report the first pair out of tolerance, NaN included
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const double error = deviation(result[i], mode == 1 ? nlerp(l[i], r[i], s[i]) : QuatSlerpD(QuatToQuatD(l[i]), QuatToQuatD(r[i]), s[i]));
+			// QuatSlerp skips the normalization of the linear fallback
+			const double scalarError = mode == 0 ? deviation(result[i], QuatToQuatD(QuatSlerp(l[i], r[i], s[i]))) : 0.0;
+			if (!(error <= tolerance) || !(scalarError <= tolerance))
+			{
+				BenchmarkFail("%s deviates %e from the double precision reference and %e from QuatSlerp at %u of %u\n", name, error, scalarError, i, count);
+				break;
+			}
+		}
+	};
+	// 5e-7 radians of rotation is 2.5e-7 in the components, plus rounding. The correction stays within 1e-3 radians.
+	if (BenchmarkEnabled("QuatSlerpArray"))
+	{
+		check("QuatSlerpArray", a, b, fraction, BENCHMARK_COLD_COUNT, 0, 1e-6);
+		check("QuatSlerpArray", edgeA, edgeB, edgeT, edgeCount, 0, 1e-6);
+	}
+	if (BenchmarkEnabled("QuatNlerpArray"))
+	{
+		check("QuatNlerpArray", a, b, fraction, BENCHMARK_COLD_COUNT, 1, 1e-6);
+		check("QuatNlerpArray", edgeA, edgeB, edgeT, edgeCount, 1, 1e-6);
+		check("QuatNlerpArray (corrected)", a, b, fraction, BENCHMARK_COLD_COUNT, 2, 5e-4);
+		check("QuatNlerpArray (corrected)", edgeA, edgeB, edgeT, edgeCount, 2, 5e-4);
+	}
+	delete[] fraction;
+}
+
+static void BenchmarkQuatNormalized()
+{
+	const ENormalizeMode modes[] = { ENormalizeMode::Fast, ENormalizeMode::Refined, ENormalizeMode::Exact };
+	const char* names[] = { "QuatNormalizedArray (Fast)", "QuatNormalizedArray (Refined)", "QuatNormalizedArray (Exact)" };
+	const Quat* quats = BenchmarkInput<Quat>(0);
+	const Quat fallback = QuatIdentity();
+	Quat* result = BenchmarkOutput<Quat>();
+	for (unsigned int k = 0; k < 3; ++k)
+	{
+		const ENormalizeMode mode = modes[k];
+		BenchmarkBatch(names[k], [&](const unsigned int count) { QuatNormalizedArray(quats, fallback, result, count, mode); });
+		if (!BenchmarkEnabled(names[k]))
+			continue;
+		// Same operations in the same order as the scalar version, so the results must be identical
+		QuatNormalizedArray(quats, fallback, result, BENCHMARK_COLD_COUNT, mode);
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			const Quat expected = QuatNormalizedMode(quats[i], fallback, mode);
+			if (memcmp(&result[i], &expected, sizeof(Quat)) == 0)
+				continue;
+			BenchmarkFail("%s differs from QuatNormalizedMode at %u\n", names[k], i);
+			break;
+		}
+	}
+}
+
+static void BenchmarkVec3Stream()
+{
+	Vec3Stream a = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3Stream b = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3Stream result = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3StreamFromVecs(BenchmarkInput<Vec>(0), &a);
+	Vec3StreamFromVecs(BenchmarkInput<Vec>(1), &b);
+	float* floats = BenchmarkOutput<float>();
+	Vec* vecs = BenchmarkOutput<Vec>();
+	const Mat44 m = BenchmarkInput<Mat44>(0)[0];
+
+	// The streams are allocated once for the largest count, every call works on the first count elements
+	auto resize = [&](const unsigned int count) { a.count = count; b.count = count; result.count = count; };
+	// Sums in a different order can land _mm_rsqrt_ps on another step of its estimate, so where the kernel and the
+	// Vec3 function both use it they may differ by twice its error of 1.5 * 2^-12
+	const float rsqrtTolerance = 2.0f * 1.5f / 4096.0f;
+	// Worst component difference, NaN stays NaN (fmaxf would drop it)
+	auto deviation = [&](const Vec& expected, const unsigned int i)
+	{
+		const float got[] = { result.x[i], result.y[i], result.z[i] };
+		const float want[] = { expected.x, expected.y, expected.z };
+		float error = 0.0f;
+		for (unsigned int c = 0; c < 3; ++c)
+		{
+			const float e = fabsf(got[c] - want[c]);
+			if (!(e <= error) && error == error)
+				error = e;
+		}
+		return error;
+	};
+	BenchmarkBatch("Vec3StreamFromVecs", [&](const unsigned int count) { resize(count); Vec3StreamFromVecs(BenchmarkInput<Vec>(0), &result); });
+	BenchmarkBatch("Vec3StreamToVecs", [&](const unsigned int count) { resize(count); Vec3StreamToVecs(&a, vecs); });
+	BenchmarkBatch("Vec3StreamDot", [&](const unsigned int count) { resize(count); Vec3StreamDot(&a, &b, floats); });
+	BenchmarkBatch("Vec3StreamCross", [&](const unsigned int count) { resize(count); Vec3StreamCross(&a, &b, &result); });
+	BenchmarkBatch("Vec3StreamMagnitude", [&](const unsigned int count) { resize(count); Vec3StreamMagnitude(&a, floats); });
+	BenchmarkBatch("Vec3StreamNormalized", [&](const unsigned int count) { resize(count); Vec3StreamNormalized(&a, F32_UNIT_X, &result); });
+	BenchmarkBatch("Vec3StreamNormalizedMode (Refined)", [&](const unsigned int count) { resize(count); Vec3StreamNormalizedMode(&a, F32_UNIT_X, &result, ENormalizeMode::Refined); });
+	BenchmarkBatch("Vec3StreamNormalizedMode (Exact)", [&](const unsigned int count) { resize(count); Vec3StreamNormalizedMode(&a, F32_UNIT_X, &result, ENormalizeMode::Exact); });
+	BenchmarkBatch("Vec3StreamPerpendicular", [&](const unsigned int count) { resize(count); Vec3StreamPerpendicular(&a, &result); });
+	if (BenchmarkEnabled("Vec3StreamPerpendicular"))
+	{
+		resize(BENCHMARK_COLD_COUNT);
+		Vec3StreamPerpendicular(&a, &result);
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			const float error = deviation(Vec3Perpendicular(BenchmarkInput<Vec>(0)[i].s), i);
+			if (!(error <= rsqrtTolerance))
+			{
+				BenchmarkFail("Vec3StreamPerpendicular deviates %e from Vec3Perpendicular at %u\n", error, i);
+				break;
+			}
+		}
+	}
+	BenchmarkBatch("Vec3StreamLerp", [&](const unsigned int count) { resize(count); Vec3StreamLerp(&a, &b, 0.5f, &result); });
+	BenchmarkBatch("Vec3StreamTransform", [&](const unsigned int count) { resize(count); Vec3StreamTransform(&a, m, 1.0f, &result); });
+
+	// Element by element against the Vec3 functions, on a count that is not a multiple of 8 and with zero vectors
+	// in a full block and in the partial block at the end. The FMA kernels fuse the sums, so allow for the last bits.
+	const unsigned int checkCount = BENCHMARK_COLD_COUNT - 3;
+	resize(checkCount);
+	for (const unsigned int i : { 1u, checkCount - 1 })
+		a.x[i] = a.y[i] = a.z[i] = 0.0f;
+	auto element = [](const Vec3Stream& stream, const unsigned int i) { return _mm_set_ps(0.0f, stream.z[i], stream.y[i], stream.x[i]); };
+	auto verify = [&](const char* name, const float tolerance, auto run, auto error)
+	{
+		if (!BenchmarkEnabled(name))
+			return;
+		run();
+		for (unsigned int i = 0; i < checkCount; ++i)
+		{
+			const float e = error(i);
+			if (!(e <= tolerance))
+			{
+				BenchmarkFail("%s deviates %e at %u of %u\n", name, e, i, checkCount);
+				return;
+			}
+		}
+	};
+	verify("Vec3StreamDot", 1e-6f, [&] { Vec3StreamDot(&a, &b, floats); }, [&](const unsigned int i) { return fabsf(floats[i] - Vec3Dot(element(a, i), element(b, i))); });
+	verify("Vec3StreamCross", 1e-6f, [&] { Vec3StreamCross(&a, &b, &result); }, [&](const unsigned int i) { return deviation(Vec3Cross(element(a, i), element(b, i)), i); });
+	verify("Vec3StreamMagnitude", 1e-6f, [&] { Vec3StreamMagnitude(&a, floats); }, [&](const unsigned int i) { return fabsf(floats[i] - Vec3Magnitude(element(a, i))); });
+	verify("Vec3StreamNormalized", rsqrtTolerance, [&] { Vec3StreamNormalized(&a, F32_UNIT_X, &result); }, [&](const unsigned int i) { return deviation(Vec3Normalized(element(a, i), F32_UNIT_X), i); });
+	// The Newton step and the division leave only a few bits of rounding, however the sums were ordered
+	verify("Vec3StreamNormalizedMode (Refined)", 1e-6f, [&] { Vec3StreamNormalizedMode(&a, F32_UNIT_X, &result, ENormalizeMode::Refined); }, [&](const unsigned int i) { return deviation(Vec3NormalizedMode(element(a, i), F32_UNIT_X, ENormalizeMode::Refined), i); });
+	verify("Vec3StreamNormalizedMode (Exact)", 1e-6f, [&] { Vec3StreamNormalizedMode(&a, F32_UNIT_X, &result, ENormalizeMode::Exact); }, [&](const unsigned int i) { return deviation(Vec3NormalizedMode(element(a, i), F32_UNIT_X, ENormalizeMode::Exact), i); });
+	verify("Vec3StreamLerp", 1e-6f, [&] { Vec3StreamLerp(&a, &b, 0.3f, &result); }, [&](const unsigned int i) { return deviation(VecLerp(element(a, i), element(b, i), _mm_set_ps1(0.3f)), i); });
+
+	Vec3StreamFree(&a);
+	Vec3StreamFree(&b);
+	Vec3StreamFree(&result);
+}
+
+static void BenchmarkCulling()
+{
+	// Objects in the unit cube, seen from 1.5 units away so about half of them are visible
+	Vec3Stream centers = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3Stream extents = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3StreamFromVecs(BenchmarkInput<Vec>(0), &centers);
+	Vec3StreamFromVecs(BenchmarkInput<Vec>(1), &extents);
+	float* radii = BenchmarkOutput<float>(0);
+	for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+	{
+		radii[i] = fabsf(BenchmarkInput<float>(0)[i]) * 0.02f;
+		extents.x[i] = fabsf(extents.x[i]) * 0.05f;
+		extents.y[i] = fabsf(extents.y[i]) * 0.05f;
+		extents.z[i] = fabsf(extents.z[i]) * 0.05f;
+	}
+	const Frustum frustum = Mat44ToFrustum(Mat44Mul(Mat44Translate(0.0f, 0.0f, -1.5f), Mat44PerspectiveY(1.0f, 1.5f, 0.1f, 10.0f)));
+	unsigned char* visible = (unsigned char*)BenchmarkOutput<float>(1);
+	unsigned int* visibleIndices = (unsigned int*)BenchmarkOutput<float>(2);
+
+	auto resize = [&](const unsigned int count) { centers.count = count; extents.count = count; };
+	BenchmarkBatch("FrustumCullSpheres", [&](const unsigned int count) { resize(count); FrustumCullSpheres(frustum, &centers, radii, visible, nullptr); });
+	BenchmarkBatch("FrustumCullSpheres (indices)", [&](const unsigned int count) { resize(count); FrustumCullSpheres(frustum, &centers, radii, visible, visibleIndices); });
+	BenchmarkBatch("FrustumCullBoxes", [&](const unsigned int count) { resize(count); FrustumCullBoxes(frustum, &centers, &extents, visible, nullptr); });
+	BenchmarkBatch("FrustumCullBoxes (indices)", [&](const unsigned int count) { resize(count); FrustumCullBoxes(frustum, &centers, &extents, visible, visibleIndices); });
+	if (BenchmarkEnabled("FrustumCullSpheres"))
+	{
+		resize(BENCHMARK_COLD_COUNT);
+		const unsigned int visibleCount = FrustumCullSpheres(frustum, &centers, radii, visible, visibleIndices);
+		unsigned int expected = 0;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			const bool marked = ((visible[i / 8] >> (i % 8)) & 1) != 0;
+			if (marked && (expected >= visibleCount || visibleIndices[expected] != i))
+			{
+				BenchmarkFail("FrustumCullSpheres visibleIndices does not match the mask at %u\n", i);
+				break;
+			}
+			expected += marked;
+			// Distance to the plane the sphere is furthest outside of, the kernels round differently so only clear cases must agree
+			float nearest = FLT_MAX;
+			for (unsigned int p = 0; p < 6; ++p)
+				nearest = fminf(nearest, Vec3Dot(frustum.planes[p], _mm_set_ps(0.0f, centers.z[i], centers.y[i], centers.x[i])) + frustum.planes[p].m128_f32[3] + radii[i]);
+			if ((nearest >= 0.0f) != marked && fabsf(nearest) > 1e-5f)
+			{
+				BenchmarkFail("FrustumCullSpheres is wrong about sphere %u\n", i);
+				break;
+			}
+		}
+		if (expected != visibleCount)
+			BenchmarkFail("FrustumCullSpheres counted %u visible spheres, the mask has %u\n", visibleCount, expected);
+	}
+
+	Vec3StreamFree(&centers);
+	Vec3StreamFree(&extents);
+}
+
+// The threaded batch functions once more on a single thread, next to their normal rows these show how well they scale
+static void BenchmarkParallel()
+{
+	const unsigned int threads = ParallelThreadCount();
+	const Mat44* children = BenchmarkInput<Mat44>(0);
+	const Mat44* parents = BenchmarkInput<Mat44>(1);
+	Mat44* result = BenchmarkOutput<Mat44>();
+	Vec3Stream a = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3Stream transformed = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3StreamFromVecs(BenchmarkInput<Vec>(0), &a);
+	const Mat44 m = BenchmarkInput<Mat44>(0)[0];
+	float* radii = BenchmarkOutput<float>(0);
+	for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		radii[i] = fabsf(BenchmarkInput<float>(0)[i]) * 0.02f;
+	const Frustum frustum = Mat44ToFrustum(Mat44Mul(Mat44Translate(0.0f, 0.0f, -1.5f), Mat44PerspectiveY(1.0f, 1.5f, 0.1f, 10.0f)));
+	unsigned char* visible = (unsigned char*)BenchmarkOutput<float>(1);
+	unsigned int* visibleIndices = (unsigned int*)BenchmarkOutput<float>(2);
+
+	ParallelSetThreadCount(1);
+	BenchmarkBatch("Mat44MulArray (1 thread)", [&](const unsigned int count) { Mat44MulArray(children, parents, result, count); });
+	BenchmarkBatch("Vec3StreamTransform (1 thread)", [&](const unsigned int count) { a.count = count; Vec3StreamTransform(&a, m, 1.0f, &transformed); });
+	BenchmarkBatch("FrustumCullSpheres (indices, 1 thread)", [&](const unsigned int count) { a.count = count; FrustumCullSpheres(frustum, &a, radii, visible, visibleIndices); });
+
+	if (BenchmarkEnabled("FrustumCullSpheres (indices, 1 thread)") && threads > 1)
+	{
+		// Every element is computed by the same kernel whichever thread it lands on, so the results must match bit for bit.
+		// A small grain makes sure the culled index lists of many chunks are stitched together.
+		a.count = BENCHMARK_COLD_COUNT;
+		Vec3Stream expected = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+		unsigned char* expectedVisible = (unsigned char*)BenchmarkOutput<float>(3);
+		unsigned int* expectedIndices = (unsigned int*)BenchmarkOutput<float>(4);
+		Vec3StreamTransform(&a, m, 1.0f, &expected);
+		const unsigned int expectedCount = FrustumCullSpheres(frustum, &a, radii, expectedVisible, expectedIndices);
+		ParallelSetThreadCount(threads);
+		ParallelSetGrain(1000);
+		Vec3StreamTransform(&a, m, 1.0f, &transformed);
+		const unsigned int visibleCount = FrustumCullSpheres(frustum, &a, radii, visible, visibleIndices);
+		ParallelSetGrain(0);
+		if (transformed.count != expected.count || memcmp(transformed.x, expected.x, sizeof(float) * 3 * expected.capacity) != 0)
+			BenchmarkFail("Vec3StreamTransform on %u threads does not match 1 thread\n", threads);
+		if (visibleCount != expectedCount || memcmp(visible, expectedVisible, (BENCHMARK_COLD_COUNT + 7) / 8) != 0 ||
+			memcmp(visibleIndices, expectedIndices, sizeof(unsigned int) * expectedCount) != 0)
+			BenchmarkFail("FrustumCullSpheres on %u threads does not match 1 thread\n", threads);
+		Vec3StreamFree(&expected);
+	}
+	ParallelSetThreadCount(threads);
+
+	Vec3StreamFree(&a);
+	Vec3StreamFree(&transformed);
+}
+
+// What picking code looks like without packets, one ray and one triangle at a time out of the exported vector functions
+static bool RayTriangleReference(const __m128 origin, const __m128 direction, const __m128 a, const __m128 b, const __m128 c, float& t, float& u, float& v)
+{
+	const __m128 e1 = _mm_sub_ps(b, a);
+	const __m128 e2 = _mm_sub_ps(c, a);
+	const Vec p = Vec3Cross(direction, e2);
+	const float invDet = 1.0f / Vec3Dot(e1, p.s);
+	const __m128 s = _mm_sub_ps(origin, a);
+	u = Vec3Dot(s, p.s) * invDet;
+	const Vec q = Vec3Cross(s, e1);
+	v = Vec3Dot(direction, q.s) * invDet;
+	t = Vec3Dot(e2, q.s) * invDet;
+	return u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t > 0.0f;
+}
+
+static void BenchmarkIntersect()
+{
+	// Small triangles in the unit cube and boxes around them, shot at by 8 rays from z = -3 that mostly go through it
+	Vec3Stream v0 = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3Stream v1 = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3Stream v2 = Vec3StreamAlloc(BENCHMARK_COLD_COUNT);
+	Vec3StreamFromVecs(BenchmarkInput<Vec>(0), &v0);
+	Vec3StreamFromVecs(BenchmarkInput<Vec>(1), &v1);
+	Vec3StreamFromVecs(BenchmarkInput<Vec>(2), &v2);
+	for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+	{
+		v1.x[i] = v0.x[i] + v1.x[i] * 0.1f; v1.y[i] = v0.y[i] + v1.y[i] * 0.1f; v1.z[i] = v0.z[i] + v1.z[i] * 0.1f;
+		v2.x[i] = v0.x[i] + v2.x[i] * 0.1f; v2.y[i] = v0.y[i] + v2.y[i] * 0.1f; v2.z[i] = v0.z[i] + v2.z[i] * 0.1f;
+	}
+	Vec origins[8], directions[8];
+	const Vec* jitter = BenchmarkInput<Vec>(3);
+	for (unsigned int i = 0; i < 8; ++i)
+	{
+		origins[i].s = _mm_set_ps(1.0f, -3.0f, jitter[i].y * 0.5f, jitter[i].x * 0.5f);
+		directions[i].s = _mm_set_ps(0.0f, 1.0f, jitter[i].w * 0.2f, jitter[i].z * 0.2f);
+	}
+	RayPacket8 rays;
+	RayHit8 hits;
+
+	BenchmarkBatch("RayPacket8IntersectTriangles", [&](const unsigned int count)
+	{
+		v0.count = count; v1.count = count; v2.count = count;
+		RayPacket8FromRays(origins, directions, FLT_MAX, 8, &rays, &hits);
+		RayPacket8IntersectTriangles(&rays, &v0, &v1, &v2, &hits);
+	});
+	BenchmarkBatch("8 rays x triangle (reference)", [&](const unsigned int count)
+	{
+		for (unsigned int r = 0; r < 8; ++r)
+		{
+			hits.t[r] = FLT_MAX;
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				float t, u, v;
+				if (RayTriangleReference(origins[r].s, directions[r].s, _mm_set_ps(0.0f, v0.z[i], v0.y[i], v0.x[i]), _mm_set_ps(0.0f, v1.z[i], v1.y[i], v1.x[i]), _mm_set_ps(0.0f, v2.z[i], v2.y[i], v2.x[i]), t, u, v) && t < hits.t[r])
+				{
+					hits.t[r] = t; hits.u[r] = u; hits.v[r] = v; hits.index[r] = i;
+				}
+			}
+		}
+	});
+
+	// Boxes of 0.1 units from the first triangle inputs, the hit count keeps the calls from being optimized out
+	const Vec* boxMin = BenchmarkInput<Vec>(0);
+	Vec* boxMax = BenchmarkOutput<Vec>(0);
+	for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		boxMax[i].s = _mm_add_ps(boxMin[i].s, _mm_set_ps1(0.1f));
+	float tNear[8];
+	unsigned int boxHits = 0;
+	BenchmarkBatch("RayPacket8IntersectBox", [&](const unsigned int count)
+	{
+		RayPacket8FromRays(origins, directions, FLT_MAX, 8, &rays, &hits);
+		for (unsigned int i = 0; i < count; ++i)
+			boxHits += RayPacket8IntersectBox(&rays, boxMin[i].s, boxMax[i].s, &hits, tNear);
+	});
+
+	if (BenchmarkEnabled("RayPacket8IntersectTriangles"))
+	{
+		// Compare the closest hit with the reference, ties between triangles can go either way so those only need the same distance
+		const unsigned int count = 1 << 14;
+		v0.count = count; v1.count = count; v2.count = count;
+		RayPacket8FromRays(origins, directions, FLT_MAX, 7, &rays, &hits);
+		const unsigned int mask = RayPacket8IntersectTriangles(&rays, &v0, &v1, &v2, &hits);
+		for (unsigned int r = 0; r < 8; ++r)
+		{
+			float bestT = r < 7 ? FLT_MAX : -1.0f, bestU = 0.0f, bestV = 0.0f;
+			unsigned int bestIndex = ~0u;
+			for (unsigned int i = 0; i < count && r < 7; ++i)
+			{
+				float t, u, v;
+				if (RayTriangleReference(origins[r].s, directions[r].s, _mm_set_ps(0.0f, v0.z[i], v0.y[i], v0.x[i]), _mm_set_ps(0.0f, v1.z[i], v1.y[i], v1.x[i]), _mm_set_ps(0.0f, v2.z[i], v2.y[i], v2.x[i]), t, u, v) && t < bestT)
+				{
+					bestT = t; bestU = u; bestV = v; bestIndex = i;
+				}
+			}
+			if (((mask >> r) & 1) != (bestIndex != ~0u) || fabsf(hits.t[r] - bestT) > 1e-4f ||
+				(hits.index[r] == bestIndex && (fabsf(hits.u[r] - bestU) > 1e-3f || fabsf(hits.v[r] - bestV) > 1e-3f)))
+			{
+				BenchmarkFail("RayPacket8IntersectTriangles ray %u hit triangle %u at %f, expected %u at %f\n", r, hits.index[r], hits.t[r], bestIndex, bestT);
+				break;
+			}
+		}
+	}
+	if (BenchmarkEnabled("RayPacket8IntersectBox"))
+	{
+		RayPacket8FromRays(origins, directions, FLT_MAX, 8, &rays, &hits);
+		for (unsigned int i = 0; i < BENCHMARK_HOT_COUNT; ++i)
+		{
+			const unsigned int mask = RayPacket8IntersectBox(&rays, boxMin[i].s, boxMax[i].s, &hits, tNear);
+			for (unsigned int r = 0; r < 8; ++r)
+			{
+				// Slabs in double precision, only clear cases must agree
+				double enter = 0.0, leave = DBL_MAX;
+				for (unsigned int k = 0; k < 3; ++k)
+				{
+					const double o = origins[r].s.m128_f32[k], d = directions[r].s.m128_f32[k];
+					double t0 = (boxMin[i].s.m128_f32[k] - o) / d, t1 = (boxMax[i].s.m128_f32[k] - o) / d;
+					if (t0 > t1) { const double swap = t0; t0 = t1; t1 = swap; }
+					enter = fmax(enter, t0);
+					leave = fmin(leave, t1);
+				}
+				const double margin = fabs(leave - enter);
+				const bool expected = enter <= leave;
+				if (((mask >> r) & 1) != (unsigned int)expected && margin > 1e-4)
+				{
+					BenchmarkFail("RayPacket8IntersectBox is wrong about ray %u and box %u\n", r, i);
+					break;
+				}
+				if (expected && fabs(tNear[r] - enter) > 1e-4 * fmax(1.0, enter))
+				{
+					BenchmarkFail("RayPacket8IntersectBox ray %u enters box %u at %f, expected %f\n", r, i, tNear[r], enter);
+					break;
+				}
+			}
+		}
+
+		// Axis parallel rays against the unit box, a 0 direction component makes the inverse +-infinity
+		const float axisRays[8][7] =
+		{
+			// origin, direction, entry distance or -1 for a miss
+			{ -5.0f, 0.5f, 0.5f, 1.0f, 0.0f, 0.0f, 5.0f },
+			{ 0.5f, -5.0f, 0.5f, 0.0f, 1.0f, 0.0f, 5.0f },
+			{ 0.5f, 0.5f, 7.0f, 0.0f, 0.0f, -1.0f, 6.0f },
+			{ 0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 1.0f, 0.0f },
+			{ -5.0f, -4.5f, 0.5f, 1.0f, 1.0f, 0.0f, 5.0f },
+			{ -5.0f, 0.5f, -5.5f, 1.0f, 0.0f, 1.0f, 5.5f },
+			{ -5.0f, 2.0f, 0.5f, 1.0f, 0.0f, 0.0f, -1.0f },
+			{ -5.0f, 0.5f, 0.5f, -1.0f, 0.0f, 0.0f, -1.0f },
+		};
+		Vec axisOrigins[8], axisDirections[8];
+		for (unsigned int r = 0; r < 8; ++r)
+		{
+			axisOrigins[r].s = _mm_set_ps(1.0f, axisRays[r][2], axisRays[r][1], axisRays[r][0]);
+			axisDirections[r].s = _mm_set_ps(0.0f, axisRays[r][5], axisRays[r][4], axisRays[r][3]);
+		}
+		RayPacket8FromRays(axisOrigins, axisDirections, FLT_MAX, 8, &rays, &hits);
+		const unsigned int mask = RayPacket8IntersectBox(&rays, _mm_setzero_ps(), _mm_set_ps1(1.0f), &hits, tNear);
+		for (unsigned int r = 0; r < 8; ++r)
+		{
+			const float enter = axisRays[r][6];
+			if (((mask >> r) & 1) != (unsigned int)(enter >= 0.0f) || (enter >= 0.0f && !(fabsf(tNear[r] - enter) <= 1e-5f)))
+			{
+				BenchmarkFail("RayPacket8IntersectBox axis parallel ray %u returned %u at %f, expected %f\n", r, (mask >> r) & 1, tNear[r], enter);
+				break;
+			}
+		}
+	}
+
+	Vec3StreamFree(&v0);
+	Vec3StreamFree(&v1);
+	Vec3StreamFree(&v2);
+}
+
+static void BenchmarkBVH()
+{
+	// A bumpy terrain of about a million triangles over [-1, 1] in x and y, shot at from above and a bit sideways
+	const unsigned int gridSize = 708;
+	const unsigned int triangleCount = 2 * (gridSize - 1) * (gridSize - 1);
+	Vec3Stream v0 = Vec3StreamAlloc(triangleCount);
+	Vec3Stream v1 = Vec3StreamAlloc(triangleCount);
+	Vec3Stream v2 = Vec3StreamAlloc(triangleCount);
+	auto height = [](const float x, const float y) { return 0.2f * sinf(6.0f * x) * cosf(5.0f * y) + 0.05f * sinf(23.0f * x + 17.0f * y); };
+	auto vertex = [&](const unsigned int x, const unsigned int y, const unsigned int corner, Vec3Stream& stream)
+	{
+		const float fx = x * 2.0f / (gridSize - 1) - 1.0f, fy = y * 2.0f / (gridSize - 1) - 1.0f;
+		stream.x[corner] = fx;
+		stream.y[corner] = fy;
+		stream.z[corner] = height(fx, fy);
+	};
+	for (unsigned int y = 0, t = 0; y < gridSize - 1; ++y)
+	{
+		for (unsigned int x = 0; x < gridSize - 1; ++x, t += 2)
+		{
+			vertex(x, y, t, v0); vertex(x + 1, y, t, v1); vertex(x + 1, y + 1, t, v2);
+			vertex(x, y, t + 1, v0); vertex(x + 1, y + 1, t + 1, v1); vertex(x, y + 1, t + 1, v2);
+		}
+	}
+
+	BVH4 bvh = BVH4Build(&v0, &v1, &v2);
+	if (BenchmarkEnabled("BVH4Build") && BenchmarkCacheEnabled(EBenchmarkCache::Cold))
+	{
+		BenchmarkTime time = BenchmarkMeasure([&]() { BVH4 rebuilt = BVH4Build(&v0, &v1, &v2); BVH4Free(&rebuilt); }, EBenchmarkCache::Cold);
+		BenchmarkRecord("BVH4Build", EBenchmarkMode::Throughput, EBenchmarkCache::Cold, triangleCount, triangleCount, time);
+	}
+
+	const unsigned int rayCount = 4096;
+	const Vec* jitter = BenchmarkInput<Vec>(0);
+	Vec* origins = BenchmarkOutput<Vec>(0);
+	Vec* directions = BenchmarkOutput<Vec>(1);
+	for (unsigned int i = 0; i < rayCount; ++i)
+	{
+		// Packets are as coherent as a 2 x 4 pixel tile: 8 rays from one spot, fanning out a little
+		const Vec& spot = jitter[i & ~7u];
+		origins[i].s = _mm_set_ps(1.0f, 2.0f, spot.y, spot.x);
+		directions[i].s = _mm_set_ps(0.0f, -1.0f, spot.w * 0.3f + jitter[i].y * 0.001f, spot.z * 0.3f + jitter[i].x * 0.001f);
+	}
+	RayHit* rayHits = BenchmarkOutput<RayHit>(0);
+	RayPacket8 rays;
+	RayHit8* packetHits = BenchmarkOutput<RayHit8>(0);
+	auto record = [](const char* name, const unsigned int ops, const std::function<void()>& fn)
+	{
+		if (BenchmarkEnabled(name))
+			BenchmarkRecord(name, EBenchmarkMode::Throughput, EBenchmarkCache::Hot, ops, ops, BenchmarkMeasure(fn, EBenchmarkCache::Hot));
+	};
+	record("BVH4IntersectRay", rayCount, [&]()
+	{
+		for (unsigned int i = 0; i < rayCount; ++i)
+		{
+			rayHits[i] = { FLT_MAX, 0.0f, 0.0f, ~0u };
+			BVH4IntersectRay(&bvh, origins[i].s, directions[i].s, &rayHits[i]);
+		}
+	});
+	record("BVH4IntersectRays", rayCount, [&]()
+	{
+		for (unsigned int i = 0; i < rayCount; i += 8)
+		{
+			RayPacket8FromRays(origins + i, directions + i, FLT_MAX, 8, &rays, &packetHits[i / 8]);
+			BVH4IntersectRays(&bvh, &rays, &packetHits[i / 8]);
+		}
+	});
+	// What the editor tools did before, every ray against every triangle
+	record("BVH4IntersectRays (every triangle)", 8, [&]()
+	{
+		RayPacket8FromRays(origins, directions, FLT_MAX, 8, &rays, &packetHits[0]);
+		RayPacket8IntersectTriangles(&rays, &v0, &v1, &v2, &packetHits[0]);
+	});
+	// Snapping, so points close to the surface
+	ClosestPoint* closest = BenchmarkOutput<ClosestPoint>(0);
+	Vec* points = BenchmarkOutput<Vec>(2);
+	for (unsigned int i = 0; i < rayCount; ++i)
+		points[i].s = _mm_set_ps(0.0f, height(jitter[i].x, jitter[i].y) + jitter[i].w * 0.01f, jitter[i].y, jitter[i].x);
+	record("BVH4ClosestPoint", rayCount, [&]()
+	{
+		for (unsigned int i = 0; i < rayCount; ++i)
+		{
+			closest[i].distanceSquared = FLT_MAX;
+			BVH4ClosestPoint(&bvh, points[i].s, &closest[i]);
+		}
+	});
+
+	if (BenchmarkEnabled("BVH4IntersectRay"))
+	{
+		// Against every triangle for the first few packets, the single ray and packet traversals must agree with that and each other
+		for (unsigned int i = 0; i < 64; i += 8)
+		{
+			RayHit8 expected;
+			RayPacket8FromRays(origins + i, directions + i, FLT_MAX, 8, &rays, &expected);
+			RayPacket8IntersectTriangles(&rays, &v0, &v1, &v2, &expected);
+			RayHit8 packet;
+			RayPacket8FromRays(origins + i, directions + i, FLT_MAX, 8, &rays, &packet);
+			BVH4IntersectRays(&bvh, &rays, &packet);
+			for (unsigned int r = 0; r < 8; ++r)
+			{
+				RayHit hit = { FLT_MAX, 0.0f, 0.0f, ~0u };
+				const bool found = BVH4IntersectRay(&bvh, origins[i + r].s, directions[i + r].s, &hit);
+				if (found != (expected.index[r] != ~0u) || fabsf(hit.t - expected.t[r]) > 1e-5f || fabsf(packet.t[r] - expected.t[r]) > 1e-5f)
+				{
+					BenchmarkFail("BVH4IntersectRay ray %u hit at %f (packet %f), expected %f\n", i + r, hit.t, packet.t[r], expected.t[r]);
+					break;
+				}
+			}
+		}
+	}
+	if (BenchmarkEnabled("BVH4ClosestPoint"))
+	{
+		// The closest point must be on the triangle it reports and no farther away than the point straight below
+		for (unsigned int i = 0; i < 256; ++i)
+		{
+			const __m128 point = _mm_set_ps(0.0f, 1.0f, jitter[i].y * 0.9f, jitter[i].x * 0.9f);
+			ClosestPoint result;
+			result.distanceSquared = FLT_MAX;
+			RayHit below = { FLT_MAX, 0.0f, 0.0f, ~0u };
+			if (!BVH4ClosestPoint(&bvh, point, &result) || !BVH4IntersectRay(&bvh, point, _mm_set_ps(0.0f, -1.0f, 0.0f, 0.0f), &below))
+			{
+				BenchmarkFail("BVH4ClosestPoint missed the terrain from point %u\n", i);
+				break;
+			}
+			const unsigned int t = result.index;
+			const float w = 1.0f - result.u - result.v;
+			const float x = w * v0.x[t] + result.u * v1.x[t] + result.v * v2.x[t];
+			const float y = w * v0.y[t] + result.u * v1.y[t] + result.v * v2.y[t];
+			const float z = w * v0.z[t] + result.u * v1.z[t] + result.v * v2.z[t];
+			if (fabsf(x - result.position.x) + fabsf(y - result.position.y) + fabsf(z - result.position.z) > 1e-5f || sqrtf(result.distanceSquared) > below.t + 1e-5f)
+			{
+				BenchmarkFail("BVH4ClosestPoint found %f away on triangle %u, the terrain below is %f away\n", sqrtf(result.distanceSquared), t, below.t);
+				break;
+			}
+		}
+	}
+	if (BenchmarkEnabled("BVH4IntersectRay"))
+	{
+		// What BVH4Build returns when it runs out of memory
+		BVH4 empty = {};
+		RayHit hit = { FLT_MAX, 0.0f, 0.0f, ~0u };
+		RayPacket8 rays;
+		RayHit8 hits;
+		RayPacket8FromRays(origins, directions, FLT_MAX, 8, &rays, &hits);
+		ClosestPoint result = {};
+		result.distanceSquared = FLT_MAX;
+		if (BVH4IntersectRay(&empty, origins[0].s, directions[0].s, &hit) || BVH4IntersectRays(&empty, &rays, &hits) || BVH4ClosestPoint(&empty, origins[0].s, &result))
+			BenchmarkFail("An empty BVH4 reported a hit\n");
+		BVH4Free(&empty);
+	}
+
+	BVH4Free(&bvh);
+	Vec3StreamFree(&v0);
+	Vec3StreamFree(&v1);
+	Vec3StreamFree(&v2);
+}
+
+static void BenchmarkSinCos()
+{
+	const float* angles = BenchmarkInput<float>(0);
+	float* sines = BenchmarkOutput<float>(0);
+	float* cosines = BenchmarkOutput<float>(1);
+	BenchmarkBatch("sinf + cosf (reference)", [&](const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			sines[i] = sinf(angles[i]);
+			cosines[i] = cosf(angles[i]);
+		}
+	});
+
+	__m128* vectorSines = BenchmarkOutput<__m128>(0);
+	__m128* vectorCosines = BenchmarkOutput<__m128>(1);
+	BenchmarkBatch("_mm_sincos_ps", [&](const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; i += 4)
+			_mm_sincos_ps(_mm_load_ps(&angles[i]), &vectorSines[i / 4], &vectorCosines[i / 4]);
+	});
+
+	if (BenchmarkEnabled("_mm_sincos_ps"))
+	{
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; i += 4)
+			_mm_sincos_ps(_mm_load_ps(&angles[i]), &vectorSines[i / 4], &vectorCosines[i / 4]);
+		float maxError = 0.0f;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			maxError = fmaxf(maxError, fabsf(((const float*)vectorSines)[i] - sinf(angles[i])));
+			maxError = fmaxf(maxError, fabsf(((const float*)vectorCosines)[i] - cosf(angles[i])));
+		}
+		if (maxError > 1e-6f)
+			BenchmarkFail("_mm_sincos_ps deviates %e from sinf/cosf\n", maxError);
+	}
+}
+
+static void BenchmarkHierarchy()
+{
+	// Skeleton-like: mostly chains, a new root every 100 joints and the odd branch off an earlier joint
+	int* parentIndices = new int[BENCHMARK_COLD_COUNT];
+	for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		parentIndices[i] = (i % 100 == 0) ? -1 : (rand() % 8 == 0) ? (int)(i - 1 - rand() % (i % 100)) : (int)i - 1;
+	unsigned char* dirty = new unsigned char[BENCHMARK_COLD_COUNT];
+
+	const Mat44* locals = BenchmarkInput<Mat44>(0);
+	Mat44* worlds = BenchmarkOutput<Mat44>(0);
+	BenchmarkBatch("Mat44HierarchyToWorld", [&](const unsigned int count) { Mat44HierarchyToWorld(locals, parentIndices, worlds, count); });
+	if (BenchmarkEnabled("Mat44HierarchyToWorld"))
+	{
+		Mat44HierarchyToWorld(locals, parentIndices, worlds, BENCHMARK_COLD_COUNT);
+		Mat44* looped = BenchmarkOutput<Mat44>(1);
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+			looped[i] = parentIndices[i] < 0 ? locals[i] : Mat44Parented(locals[i], looped[parentIndices[i]]);
+		if (memcmp(looped, worlds, sizeof(Mat44) * BENCHMARK_COLD_COUNT) != 0)
+			BenchmarkFail("Mat44HierarchyToWorld does not match Mat44Parented\n");
+	}
+
+	const Mat34* affineLocals = BenchmarkInput<Mat34>(0);
+	Mat34* affineWorlds = BenchmarkOutput<Mat34>(0);
+	BenchmarkBatch("Mat34HierarchyToWorld", [&](const unsigned int count) { Mat34HierarchyToWorld(affineLocals, parentIndices, affineWorlds, count); });
+	if (BenchmarkEnabled("Mat34HierarchyToWorld"))
+	{
+		Mat34HierarchyToWorld(affineLocals, parentIndices, affineWorlds, BENCHMARK_COLD_COUNT);
+		Mat34* looped = BenchmarkOutput<Mat34>(1);
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+			looped[i] = parentIndices[i] < 0 ? affineLocals[i] : Mat34Mul(affineLocals[i], looped[parentIndices[i]]);
+		if (memcmp(looped, affineWorlds, sizeof(Mat34) * BENCHMARK_COLD_COUNT) != 0)
+			BenchmarkFail("Mat34HierarchyToWorld does not match Mat34Mul\n");
+	}
+
+	BenchmarkBatch("Mat44HierarchyTRSToWorld", [&](const unsigned int count)
+	{
+		Mat44HierarchyTRSToWorld(BenchmarkInput<__m128>(0), BenchmarkInput<__m128>(1), BenchmarkInput<__m128>(2), ERotateOrder::XYZ, parentIndices, worlds, count);
+	});
+
+	// Animate 1% of the joints, flagging them is part of the timing but cheap in comparison
+	Mat44HierarchyToWorld(locals, parentIndices, worlds, BENCHMARK_COLD_COUNT);
+	BenchmarkBatch("Mat44HierarchyUpdate (1% dirty)", [&](const unsigned int count)
+	{
+		memset(dirty, 0, count);
+		for (unsigned int i = 50; i < count; i += 100)
+			dirty[i] = 1;
+		Mat44HierarchyUpdate(locals, parentIndices, dirty, worlds, count);
+	});
+
+	delete[] parentIndices;
+	delete[] dirty;
+}
+
+// Scalar reference: one Mat44VectorTransform per influence and attribute, blended afterwards
+static void SkinReference(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influences, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		__m128 position = _mm_blend_ps(positions[i].s, F32_ONE, 0b1000);
+		__m128 normal = _mm_blend_ps(normals[i].s, F32_ZERO, 0b1000);
+		__m128 skinnedPosition = F32_ZERO, skinnedNormal = F32_ZERO;
+		for (unsigned int k = 0; k < influences; ++k)
+		{
+			const Mat44& m = palette[jointIndices[i * influences + k]];
+			__m128 weight = _mm_set_ps1(weights[i * influences + k]);
+			skinnedPosition = _mm_add_ps(skinnedPosition, _mm_mul_ps(Mat44VectorTransform(m, position).s, weight));
+			skinnedNormal = _mm_add_ps(skinnedNormal, _mm_mul_ps(Mat44VectorTransform(m, normal).s, weight));
+		}
+		outPositions[i].s = skinnedPosition;
+		// Vec3Normalized uses the approximate rsqrt, the reference needs the exact length
+		outNormals[i].s = _mm_div_ps(skinnedNormal, _mm_set_ps1(Vec3Magnitude(skinnedNormal)));
+	}
+}
+
+// Scalar dual quaternion reference: blend the palette entries in the hemisphere of the first one, normalize, transform
+static void SkinDualQuatReference(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influences, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const DualQuat& first = palette[jointIndices[i * influences]];
+		DualQuat blended = {};
+		for (unsigned int k = 0; k < influences; ++k)
+		{
+			const DualQuat& dq = palette[jointIndices[i * influences + k]];
+			const float weight = QuatDot(dq.real, first.real) < 0.0f ? -weights[i * influences + k] : weights[i * influences + k];
+			for (unsigned int c = 0; c < 4; ++c)
+			{
+				blended.real.s[c] += dq.real.s[c] * weight;
+				blended.dual.s[c] += dq.dual.s[c] * weight;
+			}
+		}
+		blended = DualQuatNormalized(blended);
+		outPositions[i] = DualQuatPointTransform(blended, positions[i].s);
+		outNormals[i] = DualQuatVectorTransform(blended, normals[i].s);
+	}
+}
+
+static void BenchmarkSkinning(const unsigned int influences)
+{
+	const Vec* positions = BenchmarkInput<Vec>(0);
+	Vec* normals = (Vec*)_aligned_malloc(sizeof(Vec) * BENCHMARK_COLD_COUNT, 16);
+	unsigned int* jointIndices = new unsigned int[BENCHMARK_COLD_COUNT * influences];
+	float* weights = new float[BENCHMARK_COLD_COUNT * influences];
+	for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+	{
+		normals[i] = Vec3Normalized(BenchmarkInput<Vec>(1)[i].s, F32_UNIT_X);
+		float total = 0.0f;
+		for (unsigned int k = 0; k < influences; ++k)
+		{
+			jointIndices[i * influences + k] = rand() % BENCHMARK_PALETTE_COUNT;
+			weights[i * influences + k] = (float)rand() / (float)RAND_MAX + 0.01f;
+			total += weights[i * influences + k];
+		}
+		for (unsigned int k = 0; k < influences; ++k)
+			weights[i * influences + k] /= total;
+	}
+	// The random TRS matrices are not rigid, so the dual quaternion palette gets its own rigid matrices
+	const Mat44* palette = BenchmarkInput<Mat44>(0);
+	Mat34* affinePalette = (Mat34*)_aligned_malloc(sizeof(Mat34) * BENCHMARK_PALETTE_COUNT, 16);
+	Mat44ToMat34Array(palette, affinePalette, BENCHMARK_PALETTE_COUNT);
+	DualQuat* dualQuatPalette = (DualQuat*)_aligned_malloc(sizeof(DualQuat) * BENCHMARK_PALETTE_COUNT, 16);
+	for (unsigned int i = 0; i < BENCHMARK_PALETTE_COUNT; ++i)
+		dualQuatPalette[i] = BenchmarkInput<DualQuat>(0)[i];
+
+	Vec* outPositions = BenchmarkOutput<Vec>(0);
+	Vec* outNormals = BenchmarkOutput<Vec>(1);
+	Vec* referencePositions = BenchmarkOutput<Vec>(2);
+	Vec* referenceNormals = BenchmarkOutput<Vec>(3);
+	char name[64];
+	sprintf_s(name, "SkinLinearBlend (%u influences, reference)", influences);
+	BenchmarkBatch(name, [&](const unsigned int count) { SkinReference(positions, normals, jointIndices, weights, influences, palette, referencePositions, referenceNormals, count); });
+	sprintf_s(name, "SkinLinearBlend (%u influences)", influences);
+	BenchmarkBatch(name, [&](const unsigned int count) { SkinLinearBlend(positions, normals, jointIndices, weights, influences, palette, outPositions, outNormals, count); });
+	if (BenchmarkEnabled(name))
+	{
+		// Blending matrices instead of results reorders the additions, so allow for rounding
+		SkinReference(positions, normals, jointIndices, weights, influences, palette, referencePositions, referenceNormals, BENCHMARK_COLD_COUNT);
+		SkinLinearBlend(positions, normals, jointIndices, weights, influences, palette, outPositions, outNormals, BENCHMARK_COLD_COUNT);
+		float maxError = 0.0f;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				maxError = fmaxf(maxError, fabsf(outPositions[i].s.m128_f32[c] - referencePositions[i].s.m128_f32[c]));
+				maxError = fmaxf(maxError, fabsf(outNormals[i].s.m128_f32[c] - referenceNormals[i].s.m128_f32[c]));
+			}
+		}
+		// The palette scales up to 2x per axis, so the error budget is relative to 10 units of translation
+		if (maxError > 1e-4f)
+			BenchmarkFail("SkinLinearBlend deviates %e from the Mat44VectorTransform reference\n", maxError);
+	}
+	sprintf_s(name, "SkinLinearBlend (%u influences, 1 thread)", influences);
+	const unsigned int threads = ParallelThreadCount();
+	ParallelSetThreadCount(1);
+	BenchmarkBatch(name, [&](const unsigned int count) { SkinLinearBlend(positions, normals, jointIndices, weights, influences, palette, outPositions, outNormals, count); });
+	ParallelSetThreadCount(threads);
+	sprintf_s(name, "SkinLinearBlendMat34 (%u influences)", influences);
+	BenchmarkBatch(name, [&](const unsigned int count) { SkinLinearBlendMat34(positions, normals, jointIndices, weights, influences, affinePalette, outPositions, outNormals, count); });
+	if (BenchmarkEnabled(name))
+	{
+		SkinReference(positions, normals, jointIndices, weights, influences, palette, referencePositions, referenceNormals, BENCHMARK_COLD_COUNT);
+		SkinLinearBlendMat34(positions, normals, jointIndices, weights, influences, affinePalette, outPositions, outNormals, BENCHMARK_COLD_COUNT);
+		float maxError = 0.0f;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				maxError = fmaxf(maxError, fabsf(outPositions[i].s.m128_f32[c] - referencePositions[i].s.m128_f32[c]));
+				maxError = fmaxf(maxError, fabsf(outNormals[i].s.m128_f32[c] - referenceNormals[i].s.m128_f32[c]));
+			}
+		}
+		if (maxError > 1e-4f)
+			BenchmarkFail("SkinLinearBlendMat34 deviates %e from the Mat44VectorTransform reference\n", maxError);
+	}
+	// The dual quaternion result differs from linear blending by design, it gets its own reference
+	sprintf_s(name, "SkinDualQuat (%u influences)", influences);
+	BenchmarkBatch(name, [&](const unsigned int count) { SkinDualQuat(positions, normals, jointIndices, weights, influences, dualQuatPalette, outPositions, outNormals, count); });
+	if (BenchmarkEnabled(name))
+	{
+		SkinDualQuatReference(positions, normals, jointIndices, weights, influences, dualQuatPalette, referencePositions, referenceNormals, BENCHMARK_COLD_COUNT);
+		SkinDualQuat(positions, normals, jointIndices, weights, influences, dualQuatPalette, outPositions, outNormals, BENCHMARK_COLD_COUNT);
+		float maxError = 0.0f;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				maxError = fmaxf(maxError, fabsf(outPositions[i].s.m128_f32[c] - referencePositions[i].s.m128_f32[c]));
+				maxError = fmaxf(maxError, fabsf(outNormals[i].s.m128_f32[c] - referenceNormals[i].s.m128_f32[c]));
+			}
+		}
+		// Same operations in a different order, the positions reach about 15 units
+		if (!(maxError <= 2e-5f))
+			BenchmarkFail("SkinDualQuat deviates %e from the DualQuatPointTransform reference\n", maxError);
+
+		// With a single influence there is nothing to blend, both methods apply the same rigid transform
+		unsigned int* singleIndices = new unsigned int[BENCHMARK_COLD_COUNT];
+		float* singleWeights = new float[BENCHMARK_COLD_COUNT];
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			singleIndices[i] = jointIndices[i * influences];
+			singleWeights[i] = 1.0f;
+		}
+		Mat44* rigidPalette = (Mat44*)_aligned_malloc(sizeof(Mat44) * BENCHMARK_PALETTE_COUNT, 16);
+		for (unsigned int i = 0; i < BENCHMARK_PALETTE_COUNT; ++i)
+			rigidPalette[i] = DualQuatToMat44(dualQuatPalette[i]);
+		SkinLinearBlend(positions, normals, singleIndices, singleWeights, 1, rigidPalette, referencePositions, referenceNormals, BENCHMARK_COLD_COUNT);
+		SkinDualQuat(positions, normals, singleIndices, singleWeights, 1, dualQuatPalette, outPositions, outNormals, BENCHMARK_COLD_COUNT);
+		float maxPositionError = 0.0f, maxNormalError = 0.0f;
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+		{
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				maxPositionError = fmaxf(maxPositionError, fabsf(outPositions[i].s.m128_f32[c] - referencePositions[i].s.m128_f32[c]));
+				maxNormalError = fmaxf(maxNormalError, fabsf(outNormals[i].s.m128_f32[c] - referenceNormals[i].s.m128_f32[c]));
+			}
+		}
+		// Only rounding for the positions, SkinLinearBlend renormalizes the normals with _mm_rsqrt_ps (off by up to 1.5 * 2^-12)
+		if (!(maxPositionError <= 1e-5f) || !(maxNormalError <= 4e-4f))
+			BenchmarkFail("SkinDualQuat with 1 influence deviates %e (positions) and %e (normals) from SkinLinearBlend\n", maxPositionError, maxNormalError);
+		_aligned_free(rigidPalette);
+		delete[] singleIndices;
+		delete[] singleWeights;
+	}
+
+	_aligned_free(normals);
+	_aligned_free(affinePalette);
+	_aligned_free(dualQuatPalette);
+	delete[] jointIndices;
+	delete[] weights;
+}
+
+void RunBatchBenchmarks()
+{
+	BenchmarkMat44Arrays();
+	BenchmarkConversionArrays();
+	BenchmarkXFormLayering();
+	BenchmarkQuatBlend();
+	BenchmarkQuatNormalized();
+	BenchmarkVec3Stream();
+	BenchmarkCulling();
+	BenchmarkParallel();
+	BenchmarkIntersect();
+	BenchmarkBVH();
+	BenchmarkSinCos();
+	BenchmarkHierarchy();
+	BenchmarkSkinning(4);
+	BenchmarkSkinning(8);
+}
@@ -0,0 +1,210 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Benchmark.h"
+#include <MMath/MMath.h>
+#include <MMath/SIMD.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <windows.h>
+#undef min
+#undef max
+
+volatile unsigned int gBenchmarkZero = 0;
+volatile unsigned int gBenchmarkSink = 0;
+
+static std::vector<BenchmarkResult> gResults;
+static std::string gFilter;
+static std::string gKernels;
+static bool gHotOnly = false;
+static unsigned int gFailures = 0;
+
+void BenchmarkSetFilter(const char* filter) { gFilter = filter; }
+void BenchmarkSetKernels(const char* kernels) { gKernels = kernels; }
+void BenchmarkSetHotOnly(const bool hotOnly) { gHotOnly = hotOnly; }
+const std::vector<BenchmarkResult>& BenchmarkResults() { return gResults; }
+unsigned int BenchmarkFailures() { return gFailures; }
+
+double BenchmarkNow()
+{
+	static double invFrequency = 0.0;
+	LARGE_INTEGER t;
+	if (invFrequency == 0.0)
+	{
+		QueryPerformanceFrequency(&t);
+		invFrequency = 1.0 / (double)t.QuadPart;
+	}
+	QueryPerformanceCounter(&t);
+	return (double)t.QuadPart * invFrequency;
+}
+
+bool BenchmarkEnabled(const char* name)
+{
+	return gFilter.empty() || strstr(name, gFilter.c_str()) != nullptr;
+}
+
+bool BenchmarkCacheEnabled(const EBenchmarkCache cache)
+{
+	return !gHotOnly || cache == EBenchmarkCache::Hot;
+}
+
+BenchmarkTime BenchmarkMeasure(const std::function<void()>& fn, const EBenchmarkCache cache)
+{
+	fn();
+	BenchmarkTime best = { 1e30, ~0ull };
+	const unsigned int repeats = cache == EBenchmarkCache::Hot ? BENCHMARK_HOT_REPEATS : BENCHMARK_COLD_REPEATS;
+	for (unsigned int repeat = 0; repeat < repeats; ++repeat)
+	{
+		const double start = BenchmarkNow();
+		const unsigned long long startCycles = __rdtsc();
+		fn();
+		const unsigned long long cycles = __rdtsc() - startCycles;
+		const double seconds = BenchmarkNow() - start;
+		if (seconds < best.seconds)
+			best = { seconds, cycles };
+	}
+	return best;
+}
+
+void BenchmarkRecord(const char* name, const EBenchmarkMode mode, const EBenchmarkCache cache, const unsigned int elements, const unsigned int ops, const BenchmarkTime time)
+{
+	BenchmarkResult result = { gKernels, name, mode, cache, elements, time.seconds * 1e9 / (double)ops, (double)time.cycles / (double)ops };
+	printf("%-10s %-40s %-10s %-4s %10.2f ns %10.1f cycles\n", gKernels.c_str(), name,
+		mode == EBenchmarkMode::Latency ? "latency" : "throughput", cache == EBenchmarkCache::Hot ? "hot" : "cold",
+		result.nsPerOp, result.cyclesPerOp);
+	gResults.push_back(result);
+}
+
+void BenchmarkFail(const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+	vfprintf(stderr, fmt, args);
+	va_end(args);
+	++gFailures;
+}
+
+void BenchmarkRecordAccuracy(const char* name, const unsigned int cases, const double maxUlps, const double meanUlps, const unsigned int worstCase)
+{
+	printf("%-10s %-40s %8u calls %12.2f ulp max (call %u) %10.3f ulp mean\n", gKernels.c_str(), name, cases, maxUlps, worstCase, meanUlps);
+}
+
+void BenchmarkBatch(const char* name, const std::function<void(const unsigned int count)>& fn)
+{
+	if (!BenchmarkEnabled(name))
+		return;
+	if (BenchmarkCacheEnabled(EBenchmarkCache::Hot))
+	{
+		BenchmarkTime time = BenchmarkMeasure([&]()
+		{
+			for (unsigned int i = 0; i < BENCHMARK_HOT_OPS; i += BENCHMARK_HOT_COUNT)
+				fn(BENCHMARK_HOT_COUNT);
+		}, EBenchmarkCache::Hot);
+		BenchmarkRecord(name, EBenchmarkMode::Throughput, EBenchmarkCache::Hot, BENCHMARK_HOT_COUNT, BENCHMARK_HOT_OPS, time);
+	}
+	if (BenchmarkCacheEnabled(EBenchmarkCache::Cold))
+	{
+		BenchmarkTime time = BenchmarkMeasure([&]() { fn(BENCHMARK_COLD_COUNT); }, EBenchmarkCache::Cold);
+		BenchmarkRecord(name, EBenchmarkMode::Throughput, EBenchmarkCache::Cold, BENCHMARK_COLD_COUNT, BENCHMARK_COLD_COUNT, time);
+	}
+}
+
+static float RandomFloat(const float lo, const float hi)
+{
+	return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+void BenchmarkRandom(float& v, const unsigned int slot)
+{
+	v = RandomFloat(-PI, PI);
+}
+
+void BenchmarkRandom(__m128& v, const unsigned int slot)
+{
+	v = _mm_set_ps(RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f));
+}
+
+void BenchmarkRandom(Vec& v, const unsigned int slot)
+{
+	BenchmarkRandom(v.s, slot);
+}
+
+void BenchmarkRandom(Quat& q, const unsigned int slot)
+{
+	__m128 v;
+	BenchmarkRandom(v, slot);
+	q = QuatNormalized({ v }, { F32_UNIT_W });
+}
+
+void BenchmarkRandom(Mat44& m, const unsigned int slot)
+{
+	m = Mat44TRS(RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f),
+		RandomFloat(-PI, PI), RandomFloat(-PI, PI), RandomFloat(-PI, PI),
+		RandomFloat(0.5f, 2.0f), RandomFloat(0.5f, 2.0f), RandomFloat(0.5f, 2.0f), ERotateOrder::XYZ);
+}
+
+void BenchmarkRandom(Mat34& m, const unsigned int slot)
+{
+	Mat44 affine;
+	BenchmarkRandom(affine, slot);
+	m = Mat44ToMat34(affine);
+}
+
+void BenchmarkRandom(DualQuat& dq, const unsigned int slot)
+{
+	Quat q;
+	BenchmarkRandom(q, slot);
+	dq = DualQuatFromQuatTranslation(q, _mm_set_ps(0.0f, RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f)));
+}
+
+void BenchmarkRandom(XForm& x, const unsigned int slot)
+{
+	BenchmarkRandom(x.rotation, slot);
+	x.translate = _mm_set_ps(0.0f, RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f));
+}
+
+void BenchmarkRandom(XFormScale& x, const unsigned int slot)
+{
+	// Uniform scale, XFormScaleMul is only exact for those
+	BenchmarkRandom(x.rotation, slot);
+	x.translate = _mm_set_ps(0.0f, RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f));
+	const float scale = RandomFloat(0.5f, 2.0f);
+	x.scale = _mm_set_ps(0.0f, scale, scale, scale);
+}
+
+void BenchmarkRandom(ERotateOrder& rotateOrder, const unsigned int slot)
+{
+	// Always the same order, a mix would mostly measure branch mispredictions
+	rotateOrder = ERotateOrder::XYZ;
+}
+
+void BenchmarkRandom(EAxis& axis, const unsigned int slot)
+{
+	// Mat44LookAt is the only user, its forward axis comes first
+	axis = (slot & 1) ? EAxis::Y : EAxis::Z;
+}
+
+void BenchmarkRandom(Mat44ValidationFlags& flags, const unsigned int slot)
+{
+	flags = (Mat44ValidationFlags)0b11111;
+}
+
+void BenchmarkRandom(ENormalizeMode& mode, const unsigned int slot)
+{
+	// The Normalized functions without a mode already cover Fast (vectors) and Exact (quaternions)
+	mode = ENormalizeMode::Refined;
+}
+
+void BenchmarkRandom(bool& b, const unsigned int slot)
+{
+	b = true;
+}
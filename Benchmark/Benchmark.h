@@ -0,0 +1,198 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include <MMath/Vector.h>
+#include <MMath/Quat.h>
+#include <MMath/Mat44.h>
+#include <MMath/Mat34.h>
+#include <MMath/DualQuat.h>
+#include <MMath/XForm.h>
+#include <MMath/Enums.h>
+#include <intrin.h>
+#include <malloc.h>
+#include <string.h>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Hot inputs fit in L1/L2 and are cycled over until BENCHMARK_HOT_OPS calls have been made.
+// Cold inputs are far larger than any last level cache and are streamed through once per run.
+static const unsigned int BENCHMARK_HOT_COUNT = 1 << 8;
+static const unsigned int BENCHMARK_HOT_OPS = 1 << 16;
+static const unsigned int BENCHMARK_COLD_COUNT = 1 << 20;
+// Best of N runs, to filter out scheduler noise
+static const unsigned int BENCHMARK_HOT_REPEATS = 32;
+static const unsigned int BENCHMARK_COLD_REPEATS = 4;
+// Number of distinct inputs pools per type, one per function argument
+static const unsigned int BENCHMARK_SLOTS = 12;
+
+enum class EBenchmarkMode { Latency, Throughput };
+enum class EBenchmarkCache { Hot, Cold };
+
+struct BenchmarkTime
+{
+	double seconds;
+	unsigned long long cycles; // time stamp counter, which ticks at a fixed rate regardless of the actual clock speed
+};
+
+struct BenchmarkResult
+{
+	std::string kernels;
+	std::string name;
+	EBenchmarkMode mode;
+	EBenchmarkCache cache;
+	unsigned int elements;
+	double nsPerOp;
+	double cyclesPerOp;
+};
+
+// Options from the command line, see Main.cpp
+void BenchmarkSetFilter(const char* filter);
+void BenchmarkSetKernels(const char* kernels); // label for the rows that follow, e.g. SSE
+void BenchmarkSetHotOnly(const bool hotOnly);
+const std::vector<BenchmarkResult>& BenchmarkResults();
+unsigned int BenchmarkFailures();
+
+// High resolution timestamp in seconds
+double BenchmarkNow();
+// False if the --filter option excludes this benchmark
+bool BenchmarkEnabled(const char* name);
+// False if the --hot-only option excludes this cache mode
+bool BenchmarkCacheEnabled(const EBenchmarkCache cache);
+// Best of BENCHMARK_*_REPEATS runs of fn, after one untimed run to warm up
+BenchmarkTime BenchmarkMeasure(const std::function<void()>& fn, const EBenchmarkCache cache);
+// Adds a result row, ns and cycles are divided by ops
+void BenchmarkRecord(const char* name, const EBenchmarkMode mode, const EBenchmarkCache cache, const unsigned int elements, const unsigned int ops, const BenchmarkTime time);
+// Reports a failed validation, the process exits with a non zero code at the end
+void BenchmarkFail(const char* fmt, ...);
+// Prints a row of the accuracy audit, see Accuracy.cpp
+void BenchmarkRecordAccuracy(const char* name, const unsigned int cases, const double maxUlps, const double meanUlps, const unsigned int worstCase);
+
+// Times fn(count) in throughput mode with count = BENCHMARK_HOT_COUNT and BENCHMARK_COLD_COUNT, results are per element.
+// Inputs must be allocated for BENCHMARK_COLD_COUNT elements.
+void BenchmarkBatch(const char* name, const std::function<void(const unsigned int count)>& fn);
+
+void RunScalarBenchmarks();
+void RunStridedBenchmarks();
+void RunBatchBenchmarks();
+void RunAccuracyAudit();
+
+// Random, but valid, inputs: unit quaternions, invertible TRS matrices and so on. Slot is the argument index.
+void BenchmarkRandom(float& v, const unsigned int slot);
+void BenchmarkRandom(__m128& v, const unsigned int slot);
+void BenchmarkRandom(Vec& v, const unsigned int slot);
+void BenchmarkRandom(Quat& q, const unsigned int slot);
+void BenchmarkRandom(Mat44& m, const unsigned int slot);
+void BenchmarkRandom(Mat34& m, const unsigned int slot);
+void BenchmarkRandom(DualQuat& dq, const unsigned int slot);
+void BenchmarkRandom(XForm& x, const unsigned int slot);
+void BenchmarkRandom(XFormScale& x, const unsigned int slot);
+void BenchmarkRandom(ERotateOrder& rotateOrder, const unsigned int slot);
+void BenchmarkRandom(EAxis& axis, const unsigned int slot);
+void BenchmarkRandom(Mat44ValidationFlags& flags, const unsigned int slot);
+void BenchmarkRandom(ENormalizeMode& mode, const unsigned int slot);
+void BenchmarkRandom(bool& b, const unsigned int slot);
+
+// BENCHMARK_COLD_COUNT random inputs for one argument slot, shared by all benchmarks and never freed
+template<typename T>
+const T* BenchmarkInput(const unsigned int slot)
+{
+	static T* pools[BENCHMARK_SLOTS] = {};
+	if (!pools[slot])
+	{
+		pools[slot] = (T*)_aligned_malloc(sizeof(T) * BENCHMARK_COLD_COUNT, 64);
+		for (unsigned int i = 0; i < BENCHMARK_COLD_COUNT; ++i)
+			BenchmarkRandom(pools[slot][i], slot);
+	}
+	return pools[slot];
+}
+
+// Room for BENCHMARK_COLD_COUNT results, shared by all benchmarks and never freed
+template<typename T>
+T* BenchmarkOutput(const unsigned int slot = 0)
+{
+	static T* pools[BENCHMARK_SLOTS] = {};
+	if (!pools[slot])
+	{
+		pools[slot] = (T*)_aligned_malloc(sizeof(T) * BENCHMARK_COLD_COUNT, 64);
+		memset(pools[slot], 0, sizeof(T) * BENCHMARK_COLD_COUNT);
+	}
+	return pools[slot];
+}
+
+// Always 0, but the compiler can not know that, used to make the next call depend on the previous result
+extern volatile unsigned int gBenchmarkZero;
+// Written once per run so the compiler can not drop the calls when they are inlined
+extern volatile unsigned int gBenchmarkSink;
+
+template<typename R>
+__forceinline unsigned int _BenchmarkDepend(const R& r)
+{
+	unsigned int bits;
+	if constexpr (sizeof(R) >= sizeof(bits))
+		memcpy(&bits, &r, sizeof(bits));
+	else
+		bits = (unsigned int)r;
+	return bits;
+}
+
+template<typename R, typename... A, size_t... I>
+void _BenchmarkScalar(const char* name, R(*fn)(A...), std::index_sequence<I...>)
+{
+	const std::tuple<const A*...> in(BenchmarkInput<A>((unsigned int)I)...);
+	R* out = BenchmarkOutput<R>();
+	for (EBenchmarkCache cache : { EBenchmarkCache::Hot, EBenchmarkCache::Cold })
+	{
+		if (!BenchmarkCacheEnabled(cache))
+			continue;
+		const unsigned int elements = cache == EBenchmarkCache::Hot ? BENCHMARK_HOT_COUNT : BENCHMARK_COLD_COUNT;
+		const unsigned int ops = cache == EBenchmarkCache::Hot ? BENCHMARK_HOT_OPS : BENCHMARK_COLD_COUNT;
+		const unsigned int mask = elements - 1;
+
+		// Latency: every call reads its inputs at an index that depends on the previous result.
+		// This includes the harness overhead of a few cycles, see the "(harness)" row.
+		if constexpr (sizeof...(A) > 0)
+		{
+			BenchmarkTime time = BenchmarkMeasure([&]()
+			{
+				const unsigned int zero = gBenchmarkZero;
+				unsigned int index = 0;
+				for (unsigned int i = 1; i <= ops; ++i)
+				{
+					const R r = fn(std::get<I>(in)[index]...);
+					index = (i & mask) + (_BenchmarkDepend(r) & zero);
+				}
+				gBenchmarkSink = index;
+			}, cache);
+			BenchmarkRecord(name, EBenchmarkMode::Latency, cache, elements, ops, time);
+		}
+
+		// Throughput: independent calls, so the CPU can overlap as many as it likes
+		BenchmarkTime time = BenchmarkMeasure([&]()
+		{
+			for (unsigned int i = 0; i < ops; ++i)
+				out[i & mask] = fn(std::get<I>(in)[i & mask]...);
+		}, cache);
+		BenchmarkRecord(name, EBenchmarkMode::Throughput, cache, elements, ops, time);
+	}
+}
+
+// Times latency and throughput of a function that takes and returns values, with hot and cold inputs
+template<typename R, typename... A>
+void BenchmarkScalar(const char* name, R(*fn)(A...))
+{
+	if (BenchmarkEnabled(name))
+		_BenchmarkScalar(name, fn, std::index_sequence_for<A...>{});
+}
@@ -0,0 +1,291 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+// Generated by codegen.py, do not edit.
+#include "Benchmark.h"
+#include <MMath/MMath.h>
+#include <MMath/SIMD.h>
+#include <MMath/Friends.h>
+#include <MMath/Strided.h>
+
+// Exported by Vector.cpp for the bindings, but not declared in a header
+extern "C"
+{
+	DLL Vec VecAdd(const __m128 lhs, const __m128 rhs);
+	DLL Vec VecSub(const __m128 lhs, const __m128 rhs);
+	DLL Vec VecMul(const __m128 lhs, const __m128 rhs);
+	DLL Vec VecDiv(const __m128 lhs, const __m128 rhs);
+	DLL Vec VecMin(const __m128 lhs, const __m128 rhs);
+	DLL Vec VecMax(const __m128 lhs, const __m128 rhs);
+	DLL Vec VecAbs(const __m128 lhs);
+	DLL Vec VecSign(const __m128 lhs);
+	DLL Vec VecNegate(const __m128 lhs);
+	DLL Vec VecSin(const __m128 lhs);
+	DLL Vec VecCos(const __m128 lhs);
+	DLL Vec VecFloor(const __m128 lhs);
+	DLL Vec VecCeil(const __m128 lhs);
+	DLL Vec VecRound(const __m128 lhs);
+}
+
+void RunScalarBenchmarks()
+{
+	// MMath.h
+	BenchmarkScalar("Min", &Min);
+	BenchmarkScalar("Max", &Max);
+	BenchmarkScalar("Clamp", &Clamp);
+	BenchmarkScalar("SignZero", &SignZero);
+	BenchmarkScalar("SignNotZero", &SignNotZero);
+	BenchmarkScalar("Sqr", &Sqr);
+	BenchmarkScalar("Saturate", &Saturate);
+	BenchmarkScalar("Lerp", &Lerp);
+	BenchmarkScalar("InverseLerp", &InverseLerp);
+	BenchmarkScalar("AngleDelta", &AngleDelta);
+	BenchmarkScalar("Mod", &Mod);
+	BenchmarkScalar("LerpAngle", &LerpAngle);
+	BenchmarkScalar("InverseLerpAngle", &InverseLerpAngle);
+	BenchmarkScalar("VecClamp", &VecClamp);
+	BenchmarkScalar("VecSignZero", &VecSignZero);
+	BenchmarkScalar("VecSignNotZero", &VecSignNotZero);
+	BenchmarkScalar("VecSqr", &VecSqr);
+	BenchmarkScalar("VecSaturate", &VecSaturate);
+	BenchmarkScalar("VecLerp", &VecLerp);
+	BenchmarkScalar("VecInverseLerp", &VecInverseLerp);
+	BenchmarkScalar("VecAngleDelta", &VecAngleDelta);
+	BenchmarkScalar("VecMod", &VecMod);
+	BenchmarkScalar("VecLerpAngle", &VecLerpAngle);
+	BenchmarkScalar("VecInverseLerpAngle", &VecInverseLerpAngle);
+	// SIMD.h
+	BenchmarkScalar("_mm_abs_ps", &_mm_abs_ps);
+	BenchmarkScalar("_mm_sign_ps", &_mm_sign_ps);
+	BenchmarkScalar("_mm_neg_ps", &_mm_neg_ps);
+	BenchmarkScalar("_mm_arccos_ps", &_mm_arccos_ps);
+	// Vector.h
+	BenchmarkScalar("Vec4Dot", &Vec4Dot);
+	BenchmarkScalar("Vec4SqrMagnitude", &Vec4SqrMagnitude);
+	BenchmarkScalar("Vec4Magnitude", &Vec4Magnitude);
+	BenchmarkScalar("Vec4Normalized", &Vec4Normalized);
+	BenchmarkScalar("Vec4NormalizedMode", &Vec4NormalizedMode);
+	BenchmarkScalar("Vec4NormalizedUnsafe", &Vec4NormalizedUnsafe);
+	BenchmarkScalar("Vec4Perpendicular", &Vec4Perpendicular);
+	BenchmarkScalar("Vec3Dot", &Vec3Dot);
+	BenchmarkScalar("Vec3Cross", &Vec3Cross);
+	BenchmarkScalar("Vec3SqrMagnitude", &Vec3SqrMagnitude);
+	BenchmarkScalar("Vec3Magnitude", &Vec3Magnitude);
+	BenchmarkScalar("Vec3Normalized", &Vec3Normalized);
+	BenchmarkScalar("Vec3NormalizedMode", &Vec3NormalizedMode);
+	BenchmarkScalar("Vec3NormalizedUnsafe", &Vec3NormalizedUnsafe);
+	BenchmarkScalar("Vec3Perpendicular", &Vec3Perpendicular);
+	BenchmarkScalar("Vec2Dot", &Vec2Dot);
+	BenchmarkScalar("Vec2Cross", &Vec2Cross);
+	BenchmarkScalar("Vec2SqrMagnitude", &Vec2SqrMagnitude);
+	BenchmarkScalar("Vec2Magnitude", &Vec2Magnitude);
+	BenchmarkScalar("Vec2Normalized", &Vec2Normalized);
+	BenchmarkScalar("Vec2NormalizedMode", &Vec2NormalizedMode);
+	BenchmarkScalar("Vec2NormalizedUnsafe", &Vec2NormalizedUnsafe);
+	BenchmarkScalar("Vec2Perpendicular", &Vec2Perpendicular);
+	// Quat.h
+	BenchmarkScalar("QuatIdentity", &QuatIdentity);
+	BenchmarkScalar("QuatRotateX", &QuatRotateX);
+	BenchmarkScalar("QuatRotateY", &QuatRotateY);
+	BenchmarkScalar("QuatRotateZ", &QuatRotateZ);
+	BenchmarkScalar("QuatMul", &QuatMul);
+	BenchmarkScalar("QuatDot", &QuatDot);
+	BenchmarkScalar("QuatSqrMagnitude", &QuatSqrMagnitude);
+	BenchmarkScalar("QuatMagnitude", &QuatMagnitude);
+	BenchmarkScalar("QuatNormalized", &QuatNormalized);
+	BenchmarkScalar("QuatNormalizedMode", &QuatNormalizedMode);
+	BenchmarkScalar("QuatInversed", &QuatInversed);
+	BenchmarkScalar("QuatConjugated", &QuatConjugated);
+	BenchmarkScalar("QuatSlerp", &QuatSlerp);
+	BenchmarkScalar("QuatVectorTransform", &QuatVectorTransform);
+	BenchmarkScalar("QuatToEuler", &QuatToEuler);
+	// Mat44.h
+	BenchmarkScalar("Mat44Identity", &Mat44Identity);
+	BenchmarkScalar("Mat44Translate", &Mat44Translate);
+	BenchmarkScalar("Mat44RotateX", &Mat44RotateX);
+	BenchmarkScalar("Mat44RotateY", &Mat44RotateY);
+	BenchmarkScalar("Mat44RotateZ", &Mat44RotateZ);
+	BenchmarkScalar("Mat44Scale", &Mat44Scale);
+	BenchmarkScalar("Mat44Scale2", &Mat44Scale2);
+	BenchmarkScalar("Mat44Mul", &Mat44Mul);
+	BenchmarkScalar("Mat44Inversed", &Mat44Inversed);
+	BenchmarkScalar("Mat44InversedFast", &Mat44InversedFast);
+	BenchmarkScalar("Mat44InversedFastNoScale", &Mat44InversedFastNoScale);
+	BenchmarkScalar("Mat44Transposed", &Mat44Transposed);
+	BenchmarkScalar("Mat44Determinant", &Mat44Determinant);
+	BenchmarkScalar("Mat44VectorTransform", &Mat44VectorTransform);
+	BenchmarkScalar("Mat44ToEuler", &Mat44ToEuler);
+	BenchmarkScalar("Mat44AxisAngle", &Mat44AxisAngle);
+	BenchmarkScalar("Mat44Align", &Mat44Align);
+	BenchmarkScalar("Mat44RotateTowards", &Mat44RotateTowards);
+	BenchmarkScalar("Mat44LookAt", &Mat44LookAt);
+	BenchmarkScalar("Mat44FromVectors", &Mat44FromVectors);
+	BenchmarkScalar("Mat44ToTop33", &Mat44ToTop33);
+	BenchmarkScalar("Mat44Delta", &Mat44Delta);
+	BenchmarkScalar("Mat44Rotate", &Mat44Rotate);
+	BenchmarkScalar("Mat44Rotate2", &Mat44Rotate2);
+	BenchmarkScalar("EulerToMat44", &EulerToMat44);
+	BenchmarkScalar("Mat44TranslateRotate", &Mat44TranslateRotate);
+	BenchmarkScalar("Mat44TranslateRotate2", &Mat44TranslateRotate2);
+	BenchmarkScalar("Mat44TRS", &Mat44TRS);
+	BenchmarkScalar("Mat44TRS2", &Mat44TRS2);
+	BenchmarkScalar("Mat44Parented", &Mat44Parented);
+	BenchmarkScalar("Mat44Validate", &Mat44Validate);
+	BenchmarkScalar("Mat44MakeValid", &Mat44MakeValid);
+	BenchmarkScalar("Mat44ToScale", &Mat44ToScale);
+	BenchmarkScalar("Mat44ToTranslate", &Mat44ToTranslate);
+	BenchmarkScalar("Mat44Frustum", &Mat44Frustum);
+	BenchmarkScalar("Mat44PerspectiveX", &Mat44PerspectiveX);
+	BenchmarkScalar("Mat44PerspectiveY", &Mat44PerspectiveY);
+	BenchmarkScalar("Mat44Orthographic", &Mat44Orthographic);
+	BenchmarkScalar("Mat44OrthoSymmetric", &Mat44OrthoSymmetric);
+	// Mat34.h
+	BenchmarkScalar("Mat34Identity", &Mat34Identity);
+	BenchmarkScalar("Mat44ToMat34", &Mat44ToMat34);
+	BenchmarkScalar("Mat34ToMat44", &Mat34ToMat44);
+	BenchmarkScalar("Mat34Mul", &Mat34Mul);
+	BenchmarkScalar("Mat34Inversed", &Mat34Inversed);
+	BenchmarkScalar("Mat34InversedFast", &Mat34InversedFast);
+	BenchmarkScalar("Mat34InversedFastNoScale", &Mat34InversedFastNoScale);
+	BenchmarkScalar("Mat34PointTransform", &Mat34PointTransform);
+	BenchmarkScalar("Mat34VectorTransform", &Mat34VectorTransform);
+	// Friends.h
+	BenchmarkScalar("QuatToMat44", &QuatToMat44);
+	BenchmarkScalar("Mat44ToQuat", &Mat44ToQuat);
+	BenchmarkScalar("Mat44ToQuatMode", &Mat44ToQuatMode);
+	// DualQuat.h
+	BenchmarkScalar("DualQuatIdentity", &DualQuatIdentity);
+	BenchmarkScalar("DualQuatFromQuatTranslation", &DualQuatFromQuatTranslation);
+	BenchmarkScalar("DualQuatTranslation", &DualQuatTranslation);
+	BenchmarkScalar("DualQuatMul", &DualQuatMul);
+	BenchmarkScalar("DualQuatNormalized", &DualQuatNormalized);
+	BenchmarkScalar("DualQuatConjugated", &DualQuatConjugated);
+	BenchmarkScalar("DualQuatPointTransform", &DualQuatPointTransform);
+	BenchmarkScalar("DualQuatVectorTransform", &DualQuatVectorTransform);
+	BenchmarkScalar("Mat44ToDualQuat", &Mat44ToDualQuat);
+	BenchmarkScalar("DualQuatToMat44", &DualQuatToMat44);
+	// XForm.h
+	BenchmarkScalar("XFormIdentity", &XFormIdentity);
+	BenchmarkScalar("XFormMul", &XFormMul);
+	BenchmarkScalar("XFormInversed", &XFormInversed);
+	BenchmarkScalar("XFormPointTransform", &XFormPointTransform);
+	BenchmarkScalar("XFormVectorTransform", &XFormVectorTransform);
+	BenchmarkScalar("XFormToMat44", &XFormToMat44);
+	BenchmarkScalar("Mat44ToXForm", &Mat44ToXForm);
+	BenchmarkScalar("XFormScaleIdentity", &XFormScaleIdentity);
+	BenchmarkScalar("XFormScaleMul", &XFormScaleMul);
+	BenchmarkScalar("XFormScaleInversed", &XFormScaleInversed);
+	BenchmarkScalar("XFormScalePointTransform", &XFormScalePointTransform);
+	BenchmarkScalar("XFormScaleVectorTransform", &XFormScaleVectorTransform);
+	BenchmarkScalar("XFormScaleToMat44", &XFormScaleToMat44);
+	BenchmarkScalar("Mat44ToXFormScale", &Mat44ToXFormScale);
+	// Vector.cpp
+	BenchmarkScalar("VecAdd", &VecAdd);
+	BenchmarkScalar("VecSub", &VecSub);
+	BenchmarkScalar("VecMul", &VecMul);
+	BenchmarkScalar("VecDiv", &VecDiv);
+	BenchmarkScalar("VecMin", &VecMin);
+	BenchmarkScalar("VecMax", &VecMax);
+	BenchmarkScalar("VecAbs", &VecAbs);
+	BenchmarkScalar("VecSign", &VecSign);
+	BenchmarkScalar("VecNegate", &VecNegate);
+	BenchmarkScalar("VecSin", &VecSin);
+	BenchmarkScalar("VecCos", &VecCos);
+	BenchmarkScalar("VecFloor", &VecFloor);
+	BenchmarkScalar("VecCeil", &VecCeil);
+	BenchmarkScalar("VecRound", &VecRound);
+}
+
+void RunStridedBenchmarks()
+{
+	// Vector.h
+	BenchmarkBatch("Vec4DotStrided", [](const unsigned int count) { Vec4DotStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec4SqrMagnitudeStrided", [](const unsigned int count) { Vec4SqrMagnitudeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec4MagnitudeStrided", [](const unsigned int count) { Vec4MagnitudeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec4NormalizedStrided", [](const unsigned int count) { Vec4NormalizedStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec4NormalizedModeStrided", [](const unsigned int count) { Vec4NormalizedModeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkInput<ENormalizeMode>(2)[0], BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec4NormalizedUnsafeStrided", [](const unsigned int count) { Vec4NormalizedUnsafeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec4PerpendicularStrided", [](const unsigned int count) { Vec4PerpendicularStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec3DotStrided", [](const unsigned int count) { Vec3DotStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec3CrossStrided", [](const unsigned int count) { Vec3CrossStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec3SqrMagnitudeStrided", [](const unsigned int count) { Vec3SqrMagnitudeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec3MagnitudeStrided", [](const unsigned int count) { Vec3MagnitudeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec3NormalizedStrided", [](const unsigned int count) { Vec3NormalizedStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec3NormalizedModeStrided", [](const unsigned int count) { Vec3NormalizedModeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkInput<ENormalizeMode>(2)[0], BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec3NormalizedUnsafeStrided", [](const unsigned int count) { Vec3NormalizedUnsafeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec3PerpendicularStrided", [](const unsigned int count) { Vec3PerpendicularStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec2DotStrided", [](const unsigned int count) { Vec2DotStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec2CrossStrided", [](const unsigned int count) { Vec2CrossStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec2SqrMagnitudeStrided", [](const unsigned int count) { Vec2SqrMagnitudeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec2MagnitudeStrided", [](const unsigned int count) { Vec2MagnitudeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Vec2NormalizedStrided", [](const unsigned int count) { Vec2NormalizedStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec2NormalizedModeStrided", [](const unsigned int count) { Vec2NormalizedModeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkInput<ENormalizeMode>(2)[0], BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec2NormalizedUnsafeStrided", [](const unsigned int count) { Vec2NormalizedUnsafeStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Vec2PerpendicularStrided", [](const unsigned int count) { Vec2PerpendicularStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	// Quat.h
+	BenchmarkBatch("QuatRotateXStrided", [](const unsigned int count) { QuatRotateXStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("QuatRotateYStrided", [](const unsigned int count) { QuatRotateYStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("QuatRotateZStrided", [](const unsigned int count) { QuatRotateZStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("QuatMulStrided", [](const unsigned int count) { QuatMulStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkInput<Quat>(1), sizeof(Quat), BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("QuatDotStrided", [](const unsigned int count) { QuatDotStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkInput<Quat>(1), sizeof(Quat), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("QuatSqrMagnitudeStrided", [](const unsigned int count) { QuatSqrMagnitudeStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("QuatMagnitudeStrided", [](const unsigned int count) { QuatMagnitudeStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("QuatNormalizedStrided", [](const unsigned int count) { QuatNormalizedStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkInput<Quat>(1), sizeof(Quat), BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("QuatNormalizedModeStrided", [](const unsigned int count) { QuatNormalizedModeStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkInput<Quat>(1), sizeof(Quat), BenchmarkInput<ENormalizeMode>(2)[0], BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("QuatInversedStrided", [](const unsigned int count) { QuatInversedStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("QuatConjugatedStrided", [](const unsigned int count) { QuatConjugatedStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("QuatSlerpStrided", [](const unsigned int count) { QuatSlerpStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkInput<Quat>(1), sizeof(Quat), BenchmarkInput<float>(2), sizeof(float), BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("QuatVectorTransformStrided", [](const unsigned int count) { QuatVectorTransformStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("QuatToEulerStrided", [](const unsigned int count) { QuatToEulerStrided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkInput<ERotateOrder>(1)[0], BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	// Mat44.h
+	BenchmarkBatch("Mat44TranslateStrided", [](const unsigned int count) { Mat44TranslateStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44RotateXStrided", [](const unsigned int count) { Mat44RotateXStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44RotateYStrided", [](const unsigned int count) { Mat44RotateYStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44RotateZStrided", [](const unsigned int count) { Mat44RotateZStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44ScaleStrided", [](const unsigned int count) { Mat44ScaleStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44Scale2Strided", [](const unsigned int count) { Mat44Scale2Strided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44MulStrided", [](const unsigned int count) { Mat44MulStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkInput<Mat44>(1), sizeof(Mat44), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44InversedStrided", [](const unsigned int count) { Mat44InversedStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44InversedFastStrided", [](const unsigned int count) { Mat44InversedFastStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44InversedFastNoScaleStrided", [](const unsigned int count) { Mat44InversedFastNoScaleStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44TransposedStrided", [](const unsigned int count) { Mat44TransposedStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44DeterminantStrided", [](const unsigned int count) { Mat44DeterminantStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkOutput<float>(), sizeof(float), count); });
+	BenchmarkBatch("Mat44VectorTransformStrided", [](const unsigned int count) { Mat44VectorTransformStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Mat44ToEulerStrided", [](const unsigned int count) { Mat44ToEulerStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkInput<ERotateOrder>(1)[0], BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Mat44AxisAngleStrided", [](const unsigned int count) { Mat44AxisAngleStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<float>(1), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44AlignStrided", [](const unsigned int count) { Mat44AlignStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44RotateTowardsStrided", [](const unsigned int count) { Mat44RotateTowardsStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44LookAtStrided", [](const unsigned int count) { Mat44LookAtStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkInput<EAxis>(2)[0], BenchmarkInput<EAxis>(3)[0], BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44FromVectorsStrided", [](const unsigned int count) { Mat44FromVectorsStrided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkInput<__m128>(2), sizeof(__m128), BenchmarkInput<__m128>(3), sizeof(__m128), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44ToTop33Strided", [](const unsigned int count) { Mat44ToTop33Strided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44DeltaStrided", [](const unsigned int count) { Mat44DeltaStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkInput<Mat44>(1), sizeof(Mat44), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44RotateStrided", [](const unsigned int count) { Mat44RotateStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkInput<ERotateOrder>(3)[0], BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44Rotate2Strided", [](const unsigned int count) { Mat44Rotate2Strided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<ERotateOrder>(1)[0], BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("EulerToMat44Strided", [](const unsigned int count) { EulerToMat44Strided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<ERotateOrder>(1)[0], BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44TranslateRotateStrided", [](const unsigned int count) { Mat44TranslateRotateStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkInput<float>(3), sizeof(float), BenchmarkInput<float>(4), sizeof(float), BenchmarkInput<float>(5), sizeof(float), BenchmarkInput<ERotateOrder>(6)[0], BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44TranslateRotate2Strided", [](const unsigned int count) { Mat44TranslateRotate2Strided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkInput<ERotateOrder>(2)[0], BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44TRSStrided", [](const unsigned int count) { Mat44TRSStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkInput<float>(3), sizeof(float), BenchmarkInput<float>(4), sizeof(float), BenchmarkInput<float>(5), sizeof(float), BenchmarkInput<float>(6), sizeof(float), BenchmarkInput<float>(7), sizeof(float), BenchmarkInput<float>(8), sizeof(float), BenchmarkInput<ERotateOrder>(9)[0], BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44TRS2Strided", [](const unsigned int count) { Mat44TRS2Strided(BenchmarkInput<__m128>(0), sizeof(__m128), BenchmarkInput<__m128>(1), sizeof(__m128), BenchmarkInput<__m128>(2), sizeof(__m128), BenchmarkInput<ERotateOrder>(3)[0], BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44ParentedStrided", [](const unsigned int count) { Mat44ParentedStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkInput<Mat44>(1), sizeof(Mat44), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44MakeValidStrided", [](const unsigned int count) { Mat44MakeValidStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkInput<Mat44ValidationFlags>(1)[0], BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44ToScaleStrided", [](const unsigned int count) { Mat44ToScaleStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Mat44ToTranslateStrided", [](const unsigned int count) { Mat44ToTranslateStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkOutput<Vec>(), sizeof(Vec), count); });
+	BenchmarkBatch("Mat44FrustumStrided", [](const unsigned int count) { Mat44FrustumStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkInput<float>(3), sizeof(float), BenchmarkInput<float>(4), sizeof(float), BenchmarkInput<float>(5), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44PerspectiveXStrided", [](const unsigned int count) { Mat44PerspectiveXStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkInput<float>(3), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44PerspectiveYStrided", [](const unsigned int count) { Mat44PerspectiveYStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkInput<float>(3), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44OrthographicStrided", [](const unsigned int count) { Mat44OrthographicStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkInput<float>(3), sizeof(float), BenchmarkInput<float>(4), sizeof(float), BenchmarkInput<float>(5), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44OrthoSymmetricStrided", [](const unsigned int count) { Mat44OrthoSymmetricStrided(BenchmarkInput<float>(0), sizeof(float), BenchmarkInput<float>(1), sizeof(float), BenchmarkInput<float>(2), sizeof(float), BenchmarkInput<float>(3), sizeof(float), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	// Friends.h
+	BenchmarkBatch("QuatToMat44Strided", [](const unsigned int count) { QuatToMat44Strided(BenchmarkInput<Quat>(0), sizeof(Quat), BenchmarkOutput<Mat44>(), sizeof(Mat44), count); });
+	BenchmarkBatch("Mat44ToQuatStrided", [](const unsigned int count) { Mat44ToQuatStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+	BenchmarkBatch("Mat44ToQuatModeStrided", [](const unsigned int count) { Mat44ToQuatModeStrided(BenchmarkInput<Mat44>(0), sizeof(Mat44), BenchmarkInput<ENormalizeMode>(1)[0], BenchmarkOutput<Quat>(), sizeof(Quat), count); });
+}
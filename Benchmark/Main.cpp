@@ -0,0 +1,188 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+// Times every exported function and writes the results as CSV and / or JSON, so runs can be compared with compare.py.
+// Usage: Benchmark.exe [--csv path] [--json path] [--label text] [--filter substring] [--kernels sse|fma|both] [--threads count] [--hot-only] [--accuracy]
+// --label tags the results, e.g. with the name of an #if 0 alternative that was enabled for this build.
+// --threads is passed to ParallelSetThreadCount, 0 (the default) uses every logical processor.
+// --accuracy compares results against the double precision reference (see Accuracy.cpp) instead of timing anything.
+#include "Benchmark.h"
+#include <MMath/Dispatch.h>
+#include <MMath/Parallel.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+
+// Identity function that can not be inlined, its latency and throughput are the cost of the harness itself
+static __declspec(noinline) Vec BenchmarkHarness(const __m128 v)
+{
+	return { v };
+}
+
+static bool gAccuracy = false;
+
+static void RunBenchmarks()
+{
+	if (gAccuracy)
+	{
+		RunAccuracyAudit();
+		return;
+	}
+	BenchmarkScalar("(harness)", &BenchmarkHarness);
+	RunScalarBenchmarks();
+	RunStridedBenchmarks();
+	RunBatchBenchmarks();
+}
+
+static std::string CpuName()
+{
+	int info[4];
+	char name[49] = {};
+	__cpuid(info, 0x80000000);
+	if ((unsigned int)info[0] < 0x80000004)
+		return "unknown";
+	for (int i = 0; i < 3; ++i)
+	{
+		__cpuid(info, 0x80000002 + i);
+		memcpy(name + i * 16, info, 16);
+	}
+	return name;
+}
+
+// Escapes quotes and backslashes for JSON strings
+static std::string JsonQuoted(const std::string& text)
+{
+	std::string result = "\"";
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\')
+			result += '\\';
+		result += c;
+	}
+	return result + "\"";
+}
+
+// Doubles quotes for CSV strings, backslashes are kept as is
+static std::string CsvQuoted(const std::string& text)
+{
+	std::string result = "\"";
+	for (char c : text)
+	{
+		if (c == '"')
+			result += '"';
+		result += c;
+	}
+	return result + "\"";
+}
+
+static const char* ModeName(const EBenchmarkMode mode) { return mode == EBenchmarkMode::Latency ? "latency" : "throughput"; }
+static const char* CacheName(const EBenchmarkCache cache) { return cache == EBenchmarkCache::Hot ? "hot" : "cold"; }
+
+static bool WriteCsv(const char* path, const std::string& label, const std::string& cpu)
+{
+	FILE* fh;
+	if (fopen_s(&fh, path, "w") != 0)
+		return false;
+	fprintf(fh, "label,cpu,kernels,function,mode,cache,elements,ns_per_op,cycles_per_op\n");
+	for (const BenchmarkResult& result : BenchmarkResults())
+	{
+		fprintf(fh, "%s,%s,%s,%s,%s,%s,%u,%.4f,%.3f\n", CsvQuoted(label).c_str(), CsvQuoted(cpu).c_str(), result.kernels.c_str(), CsvQuoted(result.name).c_str(),
+			ModeName(result.mode), CacheName(result.cache), result.elements, result.nsPerOp, result.cyclesPerOp);
+	}
+	fclose(fh);
+	return true;
+}
+
+static bool WriteJson(const char* path, const std::string& label, const std::string& cpu)
+{
+	FILE* fh;
+	if (fopen_s(&fh, path, "w") != 0)
+		return false;
+	fprintf(fh, "{\n\t\"label\": %s,\n\t\"cpu\": %s,\n\t\"results\": [", JsonQuoted(label).c_str(), JsonQuoted(cpu).c_str());
+	const char* separator = "\n";
+	for (const BenchmarkResult& result : BenchmarkResults())
+	{
+		fprintf(fh, "%s\t\t{\"kernels\": %s, \"function\": %s, \"mode\": \"%s\", \"cache\": \"%s\", \"elements\": %u, \"ns_per_op\": %.4f, \"cycles_per_op\": %.3f}",
+			separator, JsonQuoted(result.kernels).c_str(), JsonQuoted(result.name).c_str(), ModeName(result.mode), CacheName(result.cache),
+			result.elements, result.nsPerOp, result.cyclesPerOp);
+		separator = ",\n";
+	}
+	fprintf(fh, "\n\t]\n}\n");
+	fclose(fh);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const char* csvPath = nullptr;
+	const char* jsonPath = nullptr;
+	std::string label;
+	std::string kernels = "both";
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "--csv") == 0 && hasValue)
+			csvPath = argv[++i];
+		else if (strcmp(argv[i], "--json") == 0 && hasValue)
+			jsonPath = argv[++i];
+		else if (strcmp(argv[i], "--label") == 0 && hasValue)
+			label = argv[++i];
+		else if (strcmp(argv[i], "--filter") == 0 && hasValue)
+			BenchmarkSetFilter(argv[++i]);
+		else if (strcmp(argv[i], "--kernels") == 0 && hasValue)
+			kernels = argv[++i];
+		else if (strcmp(argv[i], "--threads") == 0 && hasValue)
+			ParallelSetThreadCount((unsigned int)atoi(argv[++i]));
+		else if (strcmp(argv[i], "--hot-only") == 0)
+			BenchmarkSetHotOnly(true);
+		else if (strcmp(argv[i], "--accuracy") == 0)
+			gAccuracy = true;
+		else
+		{
+			fprintf(stderr, "Usage: %s [--csv path] [--json path] [--label text] [--filter substring] [--kernels sse|fma|both] [--threads count] [--hot-only] [--accuracy]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	// Less interference from the rest of the system
+	SetPriorityClass(GetCurrentProcess(), HIGH_PRIORITY_CLASS);
+
+	const bool fma = DispatchFMASupported();
+	if (kernels != "fma")
+	{
+		DispatchUseFMA(false);
+		BenchmarkSetKernels("SSE");
+		RunBenchmarks();
+	}
+	if (kernels != "sse")
+	{
+		if (fma)
+		{
+			DispatchUseFMA(true);
+			BenchmarkSetKernels("AVX2+FMA");
+			RunBenchmarks();
+		}
+		else if (kernels == "fma")
+		{
+			fprintf(stderr, "This CPU does not support AVX2 + FMA\n");
+			return 2;
+		}
+	}
+
+	const std::string cpu = CpuName();
+	if (csvPath && !WriteCsv(csvPath, label, cpu))
+		fprintf(stderr, "Could not write %s\n", csvPath);
+	if (jsonPath && !WriteJson(jsonPath, label, cpu))
+		fprintf(stderr, "Could not write %s\n", jsonPath);
+	return BenchmarkFailures() != 0 ? 1 : 0;
+}
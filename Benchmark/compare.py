@@ -0,0 +1,61 @@
+# Compares two runs of Benchmark.exe, e.g. the previous release against the current one, or a build with an #if 0
+# alternative enabled against one without. Accepts the --csv and --json output files in any combination.
+# Usage: python compare.py baseline.csv candidate.json [--threshold 5] [--metric cycles_per_op]
+# Exits with 1 if any benchmark got slower by more than the threshold (in percent).
+
+import argparse
+import csv
+import json
+import sys
+
+
+def load(path):
+    # returns {(kernels, function, mode, cache): row}
+    with open(path) as fh:
+        if path.lower().endswith('.json'):
+            rows = json.load(fh)['results']
+        else:
+            rows = list(csv.DictReader(fh))
+    return {(row['kernels'], row['function'], row['mode'], row['cache']): row for row in rows}
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('baseline')
+    parser.add_argument('candidate')
+    parser.add_argument('--threshold', type=float, default=5.0, help='percentage a benchmark may get slower')
+    parser.add_argument('--metric', default='ns_per_op', choices=('ns_per_op', 'cycles_per_op'))
+    parser.add_argument('--all', action='store_true', help='also print unchanged benchmarks')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    candidate = load(args.candidate)
+    regressions = 0
+    for key in sorted(set(baseline) & set(candidate)):
+        before = float(baseline[key][args.metric])
+        after = float(candidate[key][args.metric])
+        if before <= 0.0:
+            continue
+        change = (after - before) / before * 100.0
+        if change > args.threshold:
+            regressions += 1
+            status = 'SLOWER'
+        elif change < -args.threshold:
+            status = 'faster'
+        elif args.all:
+            status = ''
+        else:
+            continue
+        print('%-10s %-40s %-10s %-4s %10.2f -> %10.2f %+7.1f%% %s' % (key + (before, after, change, status)))
+
+    for key in sorted(set(baseline) - set(candidate)):
+        print('%-10s %-40s %-10s %-4s removed' % key)
+    for key in sorted(set(candidate) - set(baseline)):
+        print('%-10s %-40s %-10s %-4s added' % key)
+
+    print('%d regression(s) over %.1f%%' % (regressions, args.threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,631 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "BVH.h"
+#include "SIMD.h"
+#include "Dispatch.h"
+#include "Parallel.h"
+#include <float.h>
+#include <algorithm>
+#include <vector>
+
+// Leaves are tested with one ray against all their triangles in one SSE register
+static const unsigned int BVH_LEAF_SIZE = 4;
+static const unsigned int BVH_BINS = 16;
+// Nodes deeper than this are split at the median instead of by SAH, which halves every child from there on.
+// That bounds the depth to BVH_SAH_DEPTH + 32, and every level pushes at most 4 entries on the traversal stack.
+static const unsigned int BVH_SAH_DEPTH = 32;
+static const unsigned int BVH_STACK_SIZE = 4 * (BVH_SAH_DEPTH + 32);
+// Below this many triangles a subtree is not worth a thread of its own
+static const unsigned int BVH_TRIANGLES_PER_TASK = 1 << 14;
+
+struct _BVHBuilder
+{
+	std::vector<Vec> boundsMin;
+	std::vector<Vec> boundsMax;
+	std::vector<Vec> centroids;
+	std::vector<unsigned int> order; // triangles in leaf order, every range of it is owned by one node
+};
+
+struct _BVHRange
+{
+	Vec min;
+	Vec max;
+	unsigned int begin;
+	unsigned int end;
+};
+
+// A subtree that is built on its own thread into its own nodes, then appended to the tree and linked to child slot of node
+struct _BVHTask
+{
+	_BVHRange range;
+	unsigned int depth;
+	unsigned int node;
+	unsigned int slot;
+	std::vector<BVH4Node> nodes;
+};
+
+struct _BVHStackEntry
+{
+	unsigned int child;
+	unsigned int count;
+	float distance;
+};
+
+// Half the surface area of a box, which is all SAH needs to compare splits
+__forceinline float _BVHArea(const __m128 min, const __m128 max)
+{
+	Vec e;
+	e.s = _mm_max_ps(_mm_sub_ps(max, min), _mm_setzero_ps());
+	return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
+static _BVHRange _BVHBounds(const _BVHBuilder& builder, const unsigned int begin, const unsigned int end)
+{
+	__m128 min = _mm_set_ps1(FLT_MAX);
+	__m128 max = _mm_set_ps1(-FLT_MAX);
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		min = _mm_min_ps(min, builder.boundsMin[builder.order[i]].s);
+		max = _mm_max_ps(max, builder.boundsMax[builder.order[i]].s);
+	}
+	_BVHRange range;
+	range.min.s = min;
+	range.max.s = max;
+	range.begin = begin;
+	range.end = end;
+	return range;
+}
+
+// Splits range in two non empty halves and returns where the second one begins
+static unsigned int _BVHSplit(_BVHBuilder& builder, const _BVHRange& range, const unsigned int depth)
+{
+	unsigned int* order = builder.order.data();
+	__m128 centroidMin = _mm_set_ps1(FLT_MAX);
+	__m128 centroidMax = _mm_set_ps1(-FLT_MAX);
+	for (unsigned int i = range.begin; i < range.end; ++i)
+	{
+		centroidMin = _mm_min_ps(centroidMin, builder.centroids[order[i]].s);
+		centroidMax = _mm_max_ps(centroidMax, builder.centroids[order[i]].s);
+	}
+	Vec low, extent;
+	low.s = centroidMin;
+	extent.s = _mm_sub_ps(centroidMax, centroidMin);
+
+	int bestAxis = -1;
+	unsigned int bestBin = 0;
+	if (depth < BVH_SAH_DEPTH)
+	{
+		// Bin the centroids on all 3 axes in one pass, then sweep the bins from both sides for the cheapest split
+		struct Bin { __m128 min, max; unsigned int count; };
+		Bin bins[3][BVH_BINS];
+		float scale[3];
+		for (unsigned int axis = 0; axis < 3; ++axis)
+		{
+			scale[axis] = extent.s.m128_f32[axis] > 0.0f ? BVH_BINS * 0.9999f / extent.s.m128_f32[axis] : 0.0f;
+			for (unsigned int bin = 0; bin < BVH_BINS; ++bin)
+				bins[axis][bin] = { _mm_set_ps1(FLT_MAX), _mm_set_ps1(-FLT_MAX), 0 };
+		}
+		for (unsigned int i = range.begin; i < range.end; ++i)
+		{
+			const unsigned int triangle = order[i];
+			for (unsigned int axis = 0; axis < 3; ++axis)
+			{
+				Bin& bin = bins[axis][std::min((unsigned int)((builder.centroids[triangle].s.m128_f32[axis] - low.s.m128_f32[axis]) * scale[axis]), BVH_BINS - 1)];
+				bin.min = _mm_min_ps(bin.min, builder.boundsMin[triangle].s);
+				bin.max = _mm_max_ps(bin.max, builder.boundsMax[triangle].s);
+				++bin.count;
+			}
+		}
+		float bestCost = FLT_MAX;
+		for (unsigned int axis = 0; axis < 3; ++axis)
+		{
+			if (scale[axis] == 0.0f)
+				continue;
+			// rightCost[bin] is the cost of everything from bin onwards
+			float rightCost[BVH_BINS];
+			__m128 min = _mm_set_ps1(FLT_MAX), max = _mm_set_ps1(-FLT_MAX);
+			unsigned int count = 0;
+			for (unsigned int bin = BVH_BINS - 1; bin > 0; --bin)
+			{
+				min = _mm_min_ps(min, bins[axis][bin].min);
+				max = _mm_max_ps(max, bins[axis][bin].max);
+				count += bins[axis][bin].count;
+				rightCost[bin] = count ? _BVHArea(min, max) * count : -1.0f;
+			}
+			min = _mm_set_ps1(FLT_MAX), max = _mm_set_ps1(-FLT_MAX);
+			count = 0;
+			for (unsigned int bin = 1; bin < BVH_BINS; ++bin)
+			{
+				min = _mm_min_ps(min, bins[axis][bin - 1].min);
+				max = _mm_max_ps(max, bins[axis][bin - 1].max);
+				count += bins[axis][bin - 1].count;
+				const float cost = _BVHArea(min, max) * count + rightCost[bin];
+				if (count && rightCost[bin] >= 0.0f && cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = (int)axis;
+					bestBin = bin;
+				}
+			}
+		}
+	}
+
+	if (bestAxis >= 0)
+	{
+		const float axisLow = low.s.m128_f32[bestAxis];
+		const float axisScale = BVH_BINS * 0.9999f / extent.s.m128_f32[bestAxis];
+		const Vec* centroids = builder.centroids.data();
+		return (unsigned int)(std::partition(order + range.begin, order + range.end, [&](const unsigned int triangle)
+		{
+			return std::min((unsigned int)((centroids[triangle].s.m128_f32[bestAxis] - axisLow) * axisScale), BVH_BINS - 1) < bestBin;
+		}) - order);
+	}
+
+	// Too deep, or every centroid in one spot: median along the longest axis
+	const int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+	const unsigned int mid = range.begin + (range.end - range.begin) / 2;
+	const Vec* centroids = builder.centroids.data();
+	std::nth_element(order + range.begin, order + mid, order + range.end, [&](const unsigned int a, const unsigned int b)
+	{
+		return centroids[a].s.m128_f32[axis] < centroids[b].s.m128_f32[axis];
+	});
+	return mid;
+}
+
+// Splits range into up to 4 children, always splitting the child with the largest surface area that is too big for a leaf.
+// Children of at most taskSize triangles are left to tasks when there are any, all others are built right away.
+static unsigned int _BVHBuildNode(_BVHBuilder& builder, const _BVHRange& range, const unsigned int depth, std::vector<BVH4Node>& nodes, std::vector<_BVHTask>* tasks, const unsigned int taskSize)
+{
+	_BVHRange children[4] = { range };
+	unsigned int childCount = 1;
+	while (childCount < 4)
+	{
+		int largest = -1;
+		float largestArea = -1.0f;
+		for (unsigned int c = 0; c < childCount; ++c)
+		{
+			const float area = _BVHArea(children[c].min.s, children[c].max.s);
+			if (children[c].end - children[c].begin > BVH_LEAF_SIZE && area > largestArea)
+			{
+				largest = (int)c;
+				largestArea = area;
+			}
+		}
+		if (largest < 0)
+			break;
+		const _BVHRange parent = children[largest];
+		const unsigned int mid = _BVHSplit(builder, parent, depth);
+		children[largest] = _BVHBounds(builder, parent.begin, mid);
+		children[childCount++] = _BVHBounds(builder, mid, parent.end);
+	}
+
+	const unsigned int index = (unsigned int)nodes.size();
+	nodes.emplace_back();
+	for (unsigned int c = 0; c < 4; ++c)
+	{
+		// Empty slots get an inside out box, which is only ever used by the closest point query
+		const _BVHRange child = c < childCount ? children[c] : _BVHRange{ { _mm_set_ps1(FLT_MAX) }, { _mm_set_ps1(-FLT_MAX) }, 0, 0 };
+		const unsigned int count = child.end - child.begin;
+		unsigned int link = 0;
+		if (count > BVH_LEAF_SIZE)
+		{
+			if (tasks && count <= taskSize)
+				tasks->push_back({ child, depth + 1, index, c });
+			else
+				link = _BVHBuildNode(builder, child, depth + 1, nodes, tasks, taskSize);
+		}
+		// nodes may have grown during the recursion
+		BVH4Node& node = nodes[index];
+		node.minX[c] = child.min.x;
+		node.minY[c] = child.min.y;
+		node.minZ[c] = child.min.z;
+		node.maxX[c] = child.max.x;
+		node.maxY[c] = child.max.y;
+		node.maxZ[c] = child.max.z;
+		node.child[c] = count > BVH_LEAF_SIZE ? link : child.begin;
+		node.count[c] = count > BVH_LEAF_SIZE ? 0 : count;
+	}
+	return index;
+}
+
+// Pushes the children in mask farthest first, so the nearest one is popped next
+__forceinline void _BVHPush(const BVH4Node& node, unsigned int mask, const float* distances, _BVHStackEntry* stack, unsigned int& size)
+{
+	unsigned int sorted[4];
+	unsigned int count = 0;
+	for (; mask; mask &= mask - 1)
+	{
+		const unsigned int c = _tzcnt_u32(mask);
+		unsigned int j = count++;
+		for (; j > 0 && distances[sorted[j - 1]] < distances[c]; --j)
+			sorted[j] = sorted[j - 1];
+		sorted[j] = c;
+	}
+	for (unsigned int j = 0; j < count; ++j)
+		stack[size++] = { node.child[sorted[j]], node.count[sorted[j]], distances[sorted[j]] };
+}
+
+// Children that are actually used, see BVH4Node
+__forceinline __m128 _BVHValid(const BVH4Node& node)
+{
+	const __m128i links = _mm_or_si128(_mm_load_si128((const __m128i*)node.child), _mm_load_si128((const __m128i*)node.count));
+	return _mm_castsi128_ps(_mm_xor_si128(_mm_cmpeq_epi32(links, _mm_setzero_si128()), _mm_set1_epi32(-1)));
+}
+
+static bool _BVHIntersectRay(const BVH4* bvh, const __m128 origin, const __m128 direction, RayHit* hit)
+{
+	// a BVH4Build that ran out of memory has no nodes
+	if (!bvh->nodeCount)
+		return false;
+	const __m128 ox = _mm_swizzle_ps_0(origin), oy = _mm_swizzle_ps_1(origin), oz = _mm_swizzle_ps_2(origin);
+	const __m128 dx = _mm_swizzle_ps_0(direction), dy = _mm_swizzle_ps_1(direction), dz = _mm_swizzle_ps_2(direction);
+	const __m128 inverse = _mm_div_ps(_mm_set_ps1(1.0f), direction);
+	const __m128 ix = _mm_swizzle_ps_0(inverse), iy = _mm_swizzle_ps_1(inverse), iz = _mm_swizzle_ps_2(inverse);
+	float bestT = hit->t, bestU = 0.0f, bestV = 0.0f;
+	unsigned int best = ~0u;
+
+	_BVHStackEntry stack[BVH_STACK_SIZE];
+	unsigned int size = 0;
+	stack[size++] = { 0, 0, 0.0f };
+	while (size)
+	{
+		const _BVHStackEntry entry = stack[--size];
+		if (entry.distance >= bestT)
+			continue;
+		if (entry.count)
+		{
+			// All triangles of the leaf at once, lanes past its count read the next leaf or the stream padding
+			const unsigned int first = entry.child;
+			__m128 t, u, v;
+			__m128 hits = _RayTriangleSSE(ox, oy, oz, dx, dy, dz,
+				_mm_loadu_ps(bvh->v0.x + first), _mm_loadu_ps(bvh->v0.y + first), _mm_loadu_ps(bvh->v0.z + first),
+				_mm_loadu_ps(bvh->v1.x + first), _mm_loadu_ps(bvh->v1.y + first), _mm_loadu_ps(bvh->v1.z + first),
+				_mm_loadu_ps(bvh->v2.x + first), _mm_loadu_ps(bvh->v2.y + first), _mm_loadu_ps(bvh->v2.z + first), t, u, v);
+			hits = _mm_and_ps(hits, _mm_cmplt_ps(t, _mm_set_ps1(bestT)));
+			hits = _mm_and_ps(hits, _mm_castsi128_ps(_mm_cmplt_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32((int)entry.count))));
+			int mask = _mm_movemask_ps(hits);
+			if (!mask)
+				continue;
+			// nearest of the lanes that hit
+			const __m128 candidates = _mm_blendv_ps(_mm_set_ps1(FLT_MAX), t, hits);
+			__m128 nearest = _mm_min_ps(candidates, _mm_shuffle_ps(candidates, candidates, _MM_SHUFFLE(2, 3, 0, 1)));
+			nearest = _mm_min_ps(nearest, _mm_shuffle_ps(nearest, nearest, _MM_SHUFFLE(1, 0, 3, 2)));
+			mask &= _mm_movemask_ps(_mm_cmpeq_ps(candidates, nearest));
+			const unsigned int lane = _tzcnt_u32((unsigned int)mask);
+			bestT = t.m128_f32[lane];
+			bestU = u.m128_f32[lane];
+			bestV = v.m128_f32[lane];
+			best = first + lane;
+			continue;
+		}
+
+		const BVH4Node& node = bvh->nodes[entry.child];
+		const __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), ox), ix);
+		const __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), ox), ix);
+		const __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), oy), iy);
+		const __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), oy), iy);
+		const __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), oz), iz);
+		const __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), oz), iz);
+		const __m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)), _mm_max_ps(_mm_min_ps(z0, z1), _mm_setzero_ps()));
+		const __m128 leave = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_max_ps(z0, z1));
+		const __m128 hits = _mm_and_ps(_BVHValid(node), _mm_and_ps(_mm_cmple_ps(enter, leave), _mm_cmplt_ps(enter, _mm_set_ps1(bestT))));
+		float distances[4];
+		_mm_storeu_ps(distances, enter);
+		_BVHPush(node, (unsigned int)_mm_movemask_ps(hits), distances, stack, size);
+	}
+
+	if (best == ~0u)
+		return false;
+	hit->t = bestT;
+	hit->u = bestU;
+	hit->v = bestV;
+	hit->index = bvh->indices[best];
+	return true;
+}
+
+static unsigned int _BVHIntersectRays(const BVH4* bvh, const RayPacket8* rays, RayHit8* hits)
+{
+	if (!bvh->nodeCount)
+		return 0;
+	// Any child that one of the rays enters is visited by all of them, the triangle kernel does not record hits for the rays that missed it
+	unsigned int updated = 0;
+	float tNear[8];
+	_BVHStackEntry stack[BVH_STACK_SIZE];
+	unsigned int size = 0;
+	stack[size++] = { 0, 0, 0.0f };
+	while (size)
+	{
+		// Skip what is behind the farthest hit of the packet
+		const _BVHStackEntry entry = stack[--size];
+		__m128 farthest = _mm_max_ps(_mm_load_ps(hits->t), _mm_load_ps(hits->t + 4));
+		farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(2, 3, 0, 1)));
+		farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(1, 0, 3, 2)));
+		if (entry.distance >= _mm_cvtss_f32(farthest))
+			continue;
+		if (entry.count)
+		{
+			const Vec3Stream v0 = { bvh->v0.x + entry.child, bvh->v0.y + entry.child, bvh->v0.z + entry.child, entry.count, entry.count };
+			const Vec3Stream v1 = { bvh->v1.x + entry.child, bvh->v1.y + entry.child, bvh->v1.z + entry.child, entry.count, entry.count };
+			const Vec3Stream v2 = { bvh->v2.x + entry.child, bvh->v2.y + entry.child, bvh->v2.z + entry.child, entry.count, entry.count };
+			const unsigned int mask = DISPATCH(RayPacket8IntersectTriangles)(rays, &v0, &v1, &v2, hits);
+			// the kernel counts from the start of the leaf
+			for (unsigned int m = mask; m; m &= m - 1)
+				hits->index[_tzcnt_u32(m)] += entry.child;
+			updated |= mask;
+			continue;
+		}
+
+		const BVH4Node& node = bvh->nodes[entry.child];
+		const unsigned int valid = (unsigned int)_mm_movemask_ps(_BVHValid(node));
+		unsigned int mask = 0;
+		float distances[4];
+		for (unsigned int c = 0; c < 4; ++c)
+		{
+			if (!(valid & (1u << c)))
+				continue;
+			const __m128 boxMin = _mm_set_ps(0.0f, node.minZ[c], node.minY[c], node.minX[c]);
+			const __m128 boxMax = _mm_set_ps(0.0f, node.maxZ[c], node.maxY[c], node.maxX[c]);
+			const unsigned int rayMask = (unsigned int)(_RayBox4SSE(rays, boxMin, boxMax, hits, tNear, 0) | (_RayBox4SSE(rays, boxMin, boxMax, hits, tNear, 4) << 4));
+			if (!rayMask)
+				continue;
+			mask |= 1u << c;
+			distances[c] = FLT_MAX;
+			for (unsigned int m = rayMask; m; m &= m - 1)
+				distances[c] = std::min(distances[c], tNear[_tzcnt_u32(m)]);
+		}
+		_BVHPush(node, mask, distances, stack, size);
+	}
+
+	for (unsigned int m = updated; m; m &= m - 1)
+		hits->index[_tzcnt_u32(m)] = bvh->indices[hits->index[_tzcnt_u32(m)]];
+	return updated;
+}
+
+__forceinline float _BVHDot(const __m128 a, const __m128 b)
+{
+	return _mm_cvtss_f32(_mm_dp_ps(a, b, 0x71));
+}
+
+// Real-Time Collision Detection 5.1.5: find the Voronoi region of the triangle that p is in, u and v are the weights of b and c
+static __m128 _BVHClosestPointTriangle(const __m128 p, const __m128 a, const __m128 b, const __m128 c, float& u, float& v)
+{
+	const __m128 ab = _mm_sub_ps(b, a);
+	const __m128 ac = _mm_sub_ps(c, a);
+	const __m128 ap = _mm_sub_ps(p, a);
+	const float d1 = _BVHDot(ab, ap);
+	const float d2 = _BVHDot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+	{
+		u = 0.0f; v = 0.0f;
+		return a;
+	}
+	const __m128 bp = _mm_sub_ps(p, b);
+	const float d3 = _BVHDot(ab, bp);
+	const float d4 = _BVHDot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3)
+	{
+		u = 1.0f; v = 0.0f;
+		return b;
+	}
+	const float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	{
+		u = d1 / (d1 - d3); v = 0.0f;
+		return _mm_add_ps(a, _mm_mul_ps(ab, _mm_set_ps1(u)));
+	}
+	const __m128 cp = _mm_sub_ps(p, c);
+	const float d5 = _BVHDot(ab, cp);
+	const float d6 = _BVHDot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6)
+	{
+		u = 0.0f; v = 1.0f;
+		return c;
+	}
+	const float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	{
+		u = 0.0f; v = d2 / (d2 - d6);
+		return _mm_add_ps(a, _mm_mul_ps(ac, _mm_set_ps1(v)));
+	}
+	const float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+	{
+		v = (d4 - d3) / ((d4 - d3) + (d5 - d6)); u = 1.0f - v;
+		return _mm_add_ps(b, _mm_mul_ps(_mm_sub_ps(c, b), _mm_set_ps1(v)));
+	}
+	const float denominator = 1.0f / (va + vb + vc);
+	u = vb * denominator;
+	v = vc * denominator;
+	return _mm_add_ps(a, _mm_add_ps(_mm_mul_ps(ab, _mm_set_ps1(u)), _mm_mul_ps(ac, _mm_set_ps1(v))));
+}
+
+// Origin gets w = 1 and direction w = 0, t does not change because the direction is not normalized
+__forceinline void _BVHTransformRay(const Mat44& worldToObject, const __m128 origin, const __m128 direction, __m128& objectOrigin, __m128& objectDirection)
+{
+	objectOrigin = Mat44VectorTransform(worldToObject, _mm_blend_ps(origin, _mm_set_ps1(1.0f), 0b1000)).s;
+	objectDirection = Mat44VectorTransform(worldToObject, _mm_blend_ps(direction, _mm_setzero_ps(), 0b1000)).s;
+}
+
+extern "C"
+{
+	DLL BVH4 BVH4Build(const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2)
+	{
+		const unsigned int count = v0->count;
+		_BVHBuilder builder;
+		builder.boundsMin.resize(count);
+		builder.boundsMax.resize(count);
+		builder.centroids.resize(count);
+		builder.order.resize(count);
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const __m128 a = _mm_set_ps(0.0f, v0->z[i], v0->y[i], v0->x[i]);
+			const __m128 b = _mm_set_ps(0.0f, v1->z[i], v1->y[i], v1->x[i]);
+			const __m128 c = _mm_set_ps(0.0f, v2->z[i], v2->y[i], v2->x[i]);
+			builder.boundsMin[i].s = _mm_min_ps(_mm_min_ps(a, b), c);
+			builder.boundsMax[i].s = _mm_max_ps(_mm_max_ps(a, b), c);
+			builder.centroids[i].s = _mm_mul_ps(_mm_add_ps(builder.boundsMin[i].s, builder.boundsMax[i].s), _mm_set_ps1(0.5f));
+			builder.order[i] = i;
+		}
+
+		// The top of the tree is built here, the subtrees below it in parallel. Each task only reorders its own range of order.
+		const unsigned int threads = ParallelThreadCount();
+		const unsigned int taskSize = std::max(count / (threads * 4), BVH_TRIANGLES_PER_TASK);
+		std::vector<BVH4Node> nodes;
+		std::vector<_BVHTask> tasks;
+		_BVHBuildNode(builder, _BVHBounds(builder, 0, count), 0, nodes, threads > 1 ? &tasks : nullptr, taskSize);
+		ParallelFor(0, (unsigned int)tasks.size(), 1, [&](const unsigned int begin, const unsigned int end)
+		{
+			for (unsigned int t = begin; t < end; ++t)
+				_BVHBuildNode(builder, tasks[t].range, tasks[t].depth, tasks[t].nodes, nullptr, 0);
+		});
+		for (_BVHTask& task : tasks)
+		{
+			const unsigned int base = (unsigned int)nodes.size();
+			for (BVH4Node& node : task.nodes)
+			{
+				for (unsigned int c = 0; c < 4; ++c)
+				{
+					if (node.count[c] == 0 && node.child[c] != 0)
+						node.child[c] += base;
+				}
+				nodes.push_back(node);
+			}
+			nodes[task.node].child[task.slot] = base;
+		}
+
+		BVH4 bvh;
+		bvh.nodeCount = (unsigned int)nodes.size();
+		bvh.nodes = (BVH4Node*)_aligned_malloc(sizeof(BVH4Node) * bvh.nodeCount, 64);
+		// Leaves load 4 triangles at once, so make sure there is room past the last one
+		bvh.v0 = Vec3StreamAlloc(count + BVH_LEAF_SIZE - 1);
+		bvh.v1 = Vec3StreamAlloc(count + BVH_LEAF_SIZE - 1);
+		bvh.v2 = Vec3StreamAlloc(count + BVH_LEAF_SIZE - 1);
+		bvh.indices = (unsigned int*)_aligned_malloc(sizeof(unsigned int) * (count ? count : 1), 64);
+		if (!bvh.nodes || !bvh.v0.x || !bvh.v1.x || !bvh.v2.x || !bvh.indices)
+		{
+			BVH4Free(&bvh);
+			return {};
+		}
+		memcpy(bvh.nodes, nodes.data(), sizeof(BVH4Node) * bvh.nodeCount);
+		bvh.v0.count = bvh.v1.count = bvh.v2.count = count;
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const unsigned int triangle = builder.order[i];
+			bvh.v0.x[i] = v0->x[triangle]; bvh.v0.y[i] = v0->y[triangle]; bvh.v0.z[i] = v0->z[triangle];
+			bvh.v1.x[i] = v1->x[triangle]; bvh.v1.y[i] = v1->y[triangle]; bvh.v1.z[i] = v1->z[triangle];
+			bvh.v2.x[i] = v2->x[triangle]; bvh.v2.y[i] = v2->y[triangle]; bvh.v2.z[i] = v2->z[triangle];
+			bvh.indices[i] = triangle;
+		}
+		return bvh;
+	}
+	DLL void BVH4Free(BVH4* bvh)
+	{
+		_aligned_free(bvh->nodes);
+		_aligned_free(bvh->indices);
+		Vec3StreamFree(&bvh->v0);
+		Vec3StreamFree(&bvh->v1);
+		Vec3StreamFree(&bvh->v2);
+		bvh->nodes = nullptr;
+		bvh->indices = nullptr;
+		bvh->nodeCount = 0;
+	}
+	DLL bool BVH4IntersectRay(const BVH4* bvh, const __m128 origin, const __m128 direction, RayHit* hit)
+	{
+		return _BVHIntersectRay(bvh, origin, direction, hit);
+	}
+	DLL unsigned int BVH4IntersectRays(const BVH4* bvh, const RayPacket8* rays, RayHit8* hits)
+	{
+		return _BVHIntersectRays(bvh, rays, hits);
+	}
+	DLL bool BVH4ClosestPoint(const BVH4* bvh, const __m128 point, ClosestPoint* result)
+	{
+		if (!bvh->nodeCount)
+			return false;
+		const __m128 px = _mm_swizzle_ps_0(point), py = _mm_swizzle_ps_1(point), pz = _mm_swizzle_ps_2(point);
+		float best = result->distanceSquared;
+		bool found = false;
+
+		_BVHStackEntry stack[BVH_STACK_SIZE];
+		unsigned int size = 0;
+		stack[size++] = { 0, 0, 0.0f };
+		while (size)
+		{
+			const _BVHStackEntry entry = stack[--size];
+			if (entry.distance >= best)
+				continue;
+			if (entry.count)
+			{
+				for (unsigned int i = entry.child; i < entry.child + entry.count; ++i)
+				{
+					float u, v;
+					const __m128 closest = _BVHClosestPointTriangle(point,
+						_mm_set_ps(0.0f, bvh->v0.z[i], bvh->v0.y[i], bvh->v0.x[i]),
+						_mm_set_ps(0.0f, bvh->v1.z[i], bvh->v1.y[i], bvh->v1.x[i]),
+						_mm_set_ps(0.0f, bvh->v2.z[i], bvh->v2.y[i], bvh->v2.x[i]), u, v);
+					const __m128 delta = _mm_sub_ps(closest, point);
+					const float distanceSquared = _BVHDot(delta, delta);
+					if (distanceSquared < best)
+					{
+						best = distanceSquared;
+						result->position.s = _mm_blend_ps(closest, point, 0b1000);
+						result->distanceSquared = distanceSquared;
+						result->u = u;
+						result->v = v;
+						result->index = bvh->indices[i];
+						found = true;
+					}
+				}
+				continue;
+			}
+
+			// Squared distance from the point to each child box, 0 inside it
+			const BVH4Node& node = bvh->nodes[entry.child];
+			const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_load_ps(node.minX), px), _mm_sub_ps(px, _mm_load_ps(node.maxX))), _mm_setzero_ps());
+			const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_load_ps(node.minY), py), _mm_sub_ps(py, _mm_load_ps(node.maxY))), _mm_setzero_ps());
+			const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_load_ps(node.minZ), pz), _mm_sub_ps(pz, _mm_load_ps(node.maxZ))), _mm_setzero_ps());
+			const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			const __m128 closer = _mm_and_ps(_BVHValid(node), _mm_cmplt_ps(distanceSquared, _mm_set_ps1(best)));
+			float distances[4];
+			_mm_storeu_ps(distances, distanceSquared);
+			_BVHPush(node, (unsigned int)_mm_movemask_ps(closer), distances, stack, size);
+		}
+		return found;
+	}
+	DLL bool BVH4IntersectRayInstance(const BVH4* bvh, const Mat44 worldToObject, const __m128 origin, const __m128 direction, RayHit* hit)
+	{
+		__m128 objectOrigin, objectDirection;
+		_BVHTransformRay(worldToObject, origin, direction, objectOrigin, objectDirection);
+		return _BVHIntersectRay(bvh, objectOrigin, objectDirection, hit);
+	}
+	DLL unsigned int BVH4IntersectRaysInstance(const BVH4* bvh, const Mat44 worldToObject, const RayPacket8* rays, RayHit8* hits)
+	{
+		RayPacket8 objectRays;
+		for (unsigned int i = 0; i < 8; ++i)
+		{
+			__m128 objectOrigin, objectDirection;
+			_BVHTransformRay(worldToObject, _mm_set_ps(0.0f, rays->originZ[i], rays->originY[i], rays->originX[i]),
+				_mm_set_ps(0.0f, rays->directionZ[i], rays->directionY[i], rays->directionX[i]), objectOrigin, objectDirection);
+			const __m128 inverse = _mm_div_ps(_mm_set_ps1(1.0f), objectDirection);
+			objectRays.originX[i] = objectOrigin.m128_f32[0];
+			objectRays.originY[i] = objectOrigin.m128_f32[1];
+			objectRays.originZ[i] = objectOrigin.m128_f32[2];
+			objectRays.directionX[i] = objectDirection.m128_f32[0];
+			objectRays.directionY[i] = objectDirection.m128_f32[1];
+			objectRays.directionZ[i] = objectDirection.m128_f32[2];
+			objectRays.inverseDirectionX[i] = inverse.m128_f32[0];
+			objectRays.inverseDirectionY[i] = inverse.m128_f32[1];
+			objectRays.inverseDirectionZ[i] = inverse.m128_f32[2];
+		}
+		return _BVHIntersectRays(bvh, &objectRays, hits);
+	}
+}
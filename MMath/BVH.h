@@ -0,0 +1,86 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include "Vector.h"
+#include "Mat44.h"
+#include "Stream.h"
+#include "Intersect.h"
+
+extern "C"
+{
+	// One node of a 4 wide bounding volume hierarchy, 128 bytes so two cache lines. The child boxes are stored as structure
+	// of arrays so a ray or point is tested against all 4 of them at once.
+	// A child with count 0 is the inner node nodes[child], otherwise it is a leaf of count triangles starting at triangle child.
+	// Unused children have child = count = 0 (the root is never a child) and an empty box.
+	__declspec(align(64)) struct BVH4Node
+	{
+		float minX[4];
+		float minY[4];
+		float minZ[4];
+		float maxX[4];
+		float maxY[4];
+		float maxZ[4];
+		unsigned int child[4];
+		unsigned int count[4];
+	};
+
+	// nodes[0] is the root. The triangles are copied in leaf order, indices maps them back to the order they were built from.
+	struct BVH4
+	{
+		BVH4Node* nodes;
+		unsigned int nodeCount;
+		Vec3Stream v0;
+		Vec3Stream v1;
+		Vec3Stream v2;
+		unsigned int* indices;
+	};
+
+	// Closest hit of a single ray, like RayHit8: t starts out as the maximum distance and p = (1 - u - v) * v0 + u * v1 + v * v2.
+	struct RayHit
+	{
+		float t;
+		float u;
+		float v;
+		unsigned int index;
+	};
+
+	// Closest point on a mesh, distanceSquared starts out as the squared maximum distance. u and v are barycentrics as in RayHit.
+	struct ClosestPoint
+	{
+		Vec position;
+		float distanceSquared;
+		float u;
+		float v;
+		unsigned int index;
+	};
+
+	// Binned SAH build over the triangles (v0[i], v1[i], v2[i]), leaves hold up to 4 triangles. Large subtrees are built on separate threads.
+	// Returns an empty BVH4 (no nodes, the queries find nothing) when an allocation fails, BVH4Free is safe on it.
+	DLL BVH4 BVH4Build(const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2);
+	DLL void BVH4Free(BVH4* bvh);
+
+	// The queries only report results closer than what is already in hit / hits / result, so several BVHs can be queried in a row.
+	// Triangle indices are the indices of the BVH4Build input.
+	DLL bool BVH4IntersectRay(const BVH4* bvh, const __m128 origin, const __m128 direction, RayHit* hit); // returns whether hit was updated
+	// Returns the mask of rays that got a closer hit. A node is visited when any of the rays enters it, so this only beats
+	// 8 calls to BVH4IntersectRay when the rays stay close together, like the rays of neighbouring pixels.
+	DLL unsigned int BVH4IntersectRays(const BVH4* bvh, const RayPacket8* rays, RayHit8* hits);
+	DLL bool BVH4ClosestPoint(const BVH4* bvh, const __m128 point, ClosestPoint* result); // returns whether result was updated
+
+	// For instances the BVH is in object space and worldToObject is the inverse of the instance transform.
+	// The rays are transformed without normalizing, so t is measured along the world space ray and hits on several instances compare directly.
+	DLL bool BVH4IntersectRayInstance(const BVH4* bvh, const Mat44 worldToObject, const __m128 origin, const __m128 direction, RayHit* hit);
+	DLL unsigned int BVH4IntersectRaysInstance(const BVH4* bvh, const Mat44 worldToObject, const RayPacket8* rays, RayHit8* hits);
+}
@@ -0,0 +1,180 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Culling.h"
+#include "SIMD.h"
+#include "Dispatch.h"
+#include "Parallel.h"
+#include <string.h>
+#include <algorithm>
+
+static const unsigned int CULL_GRAIN = 32768; // objects per chunk
+static const unsigned int CULL_MAX_CHUNKS = 256;
+
+// Every plane coefficient is broadcast to its own register once, the loops then test 4 objects per plane with 3 multiplies and 3 adds.
+struct _CullPlanesSSE
+{
+	__m128 x[6], y[6], z[6], w[6];
+};
+
+__forceinline _CullPlanesSSE _CullBroadcastSSE(const Frustum& frustum, const bool absolute)
+{
+	_CullPlanesSSE planes;
+	for (unsigned int p = 0; p < 6; ++p)
+	{
+		__m128 plane = frustum.planes[p];
+		// The box test needs |normal|, w is not used
+		if (absolute)
+			plane = _mm_andnot_ps(_mm_set_ps1(-0.0f), plane);
+		planes.x[p] = _mm_swizzle_ps_0(plane);
+		planes.y[p] = _mm_swizzle_ps_1(plane);
+		planes.z[p] = _mm_swizzle_ps_2(plane);
+		planes.w[p] = _mm_swizzle_ps_3(plane);
+	}
+	return planes;
+}
+
+__forceinline int _CullSpheres4SSE(const _CullPlanesSSE& planes, const __m128 x, const __m128 y, const __m128 z, const __m128 radius)
+{
+	// visible when distance + radius >= 0 for every plane, NaNs are culled
+	__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	for (unsigned int p = 0; p < 6; ++p)
+	{
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes.x[p], x), _mm_mul_ps(planes.y[p], y)), _mm_add_ps(_mm_mul_ps(planes.z[p], z), planes.w[p]));
+		inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+	}
+	return _mm_movemask_ps(inside);
+}
+
+__forceinline int _CullBoxes4SSE(const _CullPlanesSSE& planes, const _CullPlanesSSE& absolute, const __m128 x, const __m128 y, const __m128 z, const __m128 ex, const __m128 ey, const __m128 ez)
+{
+	// the box reaches |normal| . extents towards the plane
+	__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	for (unsigned int p = 0; p < 6; ++p)
+	{
+		__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes.x[p], x), _mm_mul_ps(planes.y[p], y)), _mm_add_ps(_mm_mul_ps(planes.z[p], z), planes.w[p]));
+		__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absolute.x[p], ex), _mm_mul_ps(absolute.y[p], ey)), _mm_mul_ps(absolute.z[p], ez));
+		inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+	}
+	return _mm_movemask_ps(inside);
+}
+
+unsigned int _FrustumCullSpheresSSE(const Frustum frustum, const Vec3Stream* centers, const float* radii, unsigned char* visible, unsigned int* visibleIndices)
+{
+	const _CullPlanesSSE planes = _CullBroadcastSSE(frustum, false);
+	const unsigned int count = centers->count;
+	unsigned int visibleCount = 0;
+	float tail[8];
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		const float* r = _CullRadii(radii, i, count, tail);
+		const int lo = _CullSpheres4SSE(planes, _mm_load_ps(centers->x + i), _mm_load_ps(centers->y + i), _mm_load_ps(centers->z + i), _mm_loadu_ps(r));
+		const int hi = _CullSpheres4SSE(planes, _mm_load_ps(centers->x + i + 4), _mm_load_ps(centers->y + i + 4), _mm_load_ps(centers->z + i + 4), _mm_loadu_ps(r + 4));
+		visibleCount = _CullStore8(lo | (hi << 4), i, count, visible, visibleIndices, visibleCount);
+	}
+	return visibleCount;
+}
+
+unsigned int _FrustumCullBoxesSSE(const Frustum frustum, const Vec3Stream* centers, const Vec3Stream* extents, unsigned char* visible, unsigned int* visibleIndices)
+{
+	const _CullPlanesSSE planes = _CullBroadcastSSE(frustum, false);
+	const _CullPlanesSSE absolute = _CullBroadcastSSE(frustum, true);
+	const unsigned int count = centers->count;
+	unsigned int visibleCount = 0;
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		const int lo = _CullBoxes4SSE(planes, absolute, _mm_load_ps(centers->x + i), _mm_load_ps(centers->y + i), _mm_load_ps(centers->z + i),
+			_mm_load_ps(extents->x + i), _mm_load_ps(extents->y + i), _mm_load_ps(extents->z + i));
+		const int hi = _CullBoxes4SSE(planes, absolute, _mm_load_ps(centers->x + i + 4), _mm_load_ps(centers->y + i + 4), _mm_load_ps(centers->z + i + 4),
+			_mm_load_ps(extents->x + i + 4), _mm_load_ps(extents->y + i + 4), _mm_load_ps(extents->z + i + 4));
+		visibleCount = _CullStore8(lo | (hi << 4), i, count, visible, visibleIndices, visibleCount);
+	}
+	return visibleCount;
+}
+
+// Culls chunks of the objects on the thread pool. Every chunk writes its indices to the part of visibleIndices
+// that lines up with its objects, offset by the first object of the chunk, then the lists are moved together in order.
+template<typename CULL>
+static unsigned int _CullChunked(const unsigned int count, unsigned int* visibleIndices, const CULL& cull)
+{
+	// Chunks are a multiple of 8 objects so they start on a whole mask byte
+	unsigned int grain = ParallelGrain(CULL_GRAIN);
+	if (grain < (count - 1) / CULL_MAX_CHUNKS + 1)
+		grain = (count - 1) / CULL_MAX_CHUNKS + 1;
+	grain = (grain + 7) & ~7u;
+	if (count <= grain)
+		return cull(0, count);
+
+	unsigned int visibleCounts[CULL_MAX_CHUNKS];
+	ParallelFor(0, count, grain, [&](const unsigned int begin, const unsigned int end)
+	{
+		// Without threads this is the whole range in one go
+		for (unsigned int chunkBegin = begin; chunkBegin < end; chunkBegin += grain)
+		{
+			const unsigned int visibleCount = cull(chunkBegin, std::min(chunkBegin + grain, end));
+			if (visibleIndices)
+			{
+				for (unsigned int i = 0; i < visibleCount; ++i)
+					visibleIndices[chunkBegin + i] += chunkBegin;
+			}
+			visibleCounts[chunkBegin / grain] = visibleCount;
+		}
+	});
+	unsigned int visibleCount = visibleCounts[0];
+	for (unsigned int chunk = 1, begin = grain; begin < count; ++chunk, begin += grain)
+	{
+		if (visibleIndices)
+			memmove(visibleIndices + visibleCount, visibleIndices + begin, sizeof(unsigned int) * visibleCounts[chunk]);
+		visibleCount += visibleCounts[chunk];
+	}
+	return visibleCount;
+}
+
+extern "C"
+{
+	DLL Frustum Mat44ToFrustum(const Mat44 viewProjection)
+	{
+		// Gribb and Hartmann: a point is inside when -w <= x, y, z <= w in clip space,
+		// so the planes are the fourth row of the matrix plus or minus each of the other rows.
+		Mat44 rows = viewProjection;
+		_MM_TRANSPOSE4_PS(rows.col0, rows.col1, rows.col2, rows.col3);
+		Frustum frustum;
+		frustum.planes[0] = _mm_add_ps(rows.col3, rows.col0);
+		frustum.planes[1] = _mm_sub_ps(rows.col3, rows.col0);
+		frustum.planes[2] = _mm_add_ps(rows.col3, rows.col1);
+		frustum.planes[3] = _mm_sub_ps(rows.col3, rows.col1);
+		frustum.planes[4] = _mm_add_ps(rows.col3, rows.col2);
+		frustum.planes[5] = _mm_sub_ps(rows.col3, rows.col2);
+		for (unsigned int p = 0; p < 6; ++p)
+			frustum.planes[p] = _mm_div_ps(frustum.planes[p], _mm_sqrt_ps(_mm_dp_ps(frustum.planes[p], frustum.planes[p], 0x7F)));
+		return frustum;
+	}
+	DLL unsigned int FrustumCullSpheres(const Frustum frustum, const Vec3Stream* centers, const float* radii, unsigned char* visible, unsigned int* visibleIndices)
+	{
+		auto kernel = DISPATCH(FrustumCullSpheres);
+		return _CullChunked(centers->count, visibleIndices, [&](const unsigned int begin, const unsigned int end)
+		{
+			const Vec3Stream chunk = { centers->x + begin, centers->y + begin, centers->z + begin, end - begin, end - begin };
+			return kernel(frustum, &chunk, radii + begin, visible + begin / 8, visibleIndices ? visibleIndices + begin : nullptr);
+		});
+	}
+	DLL unsigned int FrustumCullBoxes(const Frustum frustum, const Vec3Stream* centers, const Vec3Stream* extents, unsigned char* visible, unsigned int* visibleIndices)
+	{
+		auto kernel = DISPATCH(FrustumCullBoxes);
+		return _CullChunked(centers->count, visibleIndices, [&](const unsigned int begin, const unsigned int end)
+		{
+			const Vec3Stream chunk = { centers->x + begin, centers->y + begin, centers->z + begin, end - begin, end - begin };
+			const Vec3Stream chunkExtents = { extents->x + begin, extents->y + begin, extents->z + begin, end - begin, end - begin };
+			return kernel(frustum, &chunk, &chunkExtents, visible + begin / 8, visibleIndices ? visibleIndices + begin : nullptr);
+		});
+	}
+}
@@ -0,0 +1,99 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include "Mat44.h"
+#include "Stream.h"
+#include "SIMD.h"
+
+extern "C"
+{
+	// The 6 clip planes of a view projection matrix: left, right, bottom, top, near, far.
+	// Each plane is (normal, distance) with a unit normal pointing into the frustum, so dot(plane.xyz, p) + plane.w is the signed distance of p.
+	__declspec(align(16)) struct Frustum
+	{
+		__m128 planes[6];
+	};
+
+	// viewProjection takes world space points to OpenGL clip space (-w to w on every axis), like Mat44Mul(worldToCamera, Mat44PerspectiveY(...)).
+	DLL Frustum Mat44ToFrustum(const Mat44 viewProjection);
+
+	// Conservative visibility of bounding volumes stored as structures of arrays, 8 objects per AVX2 iteration.
+	// Object i is culled when it is entirely on the outside of one of the planes, some objects near the corners of the frustum pass.
+	// Sets bit i % 8 of visible[i / 8] for every visible object i, so visible must hold (count + 7) / 8 bytes.
+	// visibleIndices may be null, otherwise it gets the indices of the visible objects in order and must have room for count of them,
+	// entries past the returned number are scratch space.
+	// Returns the number of visible objects.
+	// Spheres: count = centers->count, radii holds count floats.
+	DLL unsigned int FrustumCullSpheres(const Frustum frustum, const Vec3Stream* centers, const float* radii, unsigned char* visible, unsigned int* visibleIndices);
+	// Axis aligned boxes as center and half size: count = centers->count = extents->count.
+	DLL unsigned int FrustumCullBoxes(const Frustum frustum, const Vec3Stream* centers, const Vec3Stream* extents, unsigned char* visible, unsigned int* visibleIndices);
+}
+
+// Internal, shared by the SSE and FMA culling kernels.
+// For every mask byte: the positions of its set bits packed into bytes, and how many there are.
+struct _CullCompactTable
+{
+	unsigned long long lanes[256];
+	unsigned char counts[256];
+	constexpr _CullCompactTable() : lanes(), counts()
+	{
+		for (unsigned int mask = 0; mask < 256; ++mask)
+		{
+			unsigned int n = 0;
+			for (unsigned int k = 0; k < 8; ++k)
+			{
+				if ((mask >> k) & 1u)
+					lanes[mask] |= (unsigned long long)k << (8 * n++);
+			}
+			counts[mask] = (unsigned char)n;
+		}
+	}
+};
+static constexpr _CullCompactTable CULL_COMPACT = {};
+
+// Writes the mask byte of objects i to i + 7 and appends the visible ones to indices without branching on the mask.
+// Full blocks always store 8 indices, the ones past the visible objects are overwritten by the next block
+// and never go past index i + 7, so they stay within the count entries that indices has room for.
+__forceinline unsigned int _CullStore8(unsigned int mask, const unsigned int i, const unsigned int count, unsigned char* visible, unsigned int* indices, unsigned int visibleCount)
+{
+	if (count - i < 8)
+		mask &= (1u << (count - i)) - 1u;
+	visible[i / 8] = (unsigned char)mask;
+	if (indices)
+	{
+		if (count - i >= 8)
+		{
+			const __m128i lanes = _mm_loadl_epi64((const __m128i*)&CULL_COMPACT.lanes[mask]);
+			const __m128i first = _mm_set1_epi32((int)i);
+			_mm_storeu_si128((__m128i*)(indices + visibleCount), _mm_add_epi32(_mm_cvtepu8_epi32(lanes), first));
+			_mm_storeu_si128((__m128i*)(indices + visibleCount + 4), _mm_add_epi32(_mm_cvtepu8_epi32(_mm_srli_si128(lanes, 4)), first));
+		}
+		else
+		{
+			for (unsigned int k = 0; k < CULL_COMPACT.counts[mask]; ++k)
+				indices[visibleCount + k] = i + (unsigned int)((CULL_COMPACT.lanes[mask] >> (8 * k)) & 0xFF);
+		}
+	}
+	return visibleCount + CULL_COMPACT.counts[mask];
+}
+// The streams are padded, the radii are not, so the last block reads them from a zero padded copy
+__forceinline const float* _CullRadii(const float* radii, const unsigned int i, const unsigned int count, float* tail)
+{
+	if (count - i >= 8)
+		return radii + i;
+	for (unsigned int k = 0; k < 8; ++k)
+		tail[k] = k < count - i ? radii[i + k] : 0.0f;
+	return tail;
+}
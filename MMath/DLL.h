@@ -12,6 +12,15 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 **/
 #pragma once
 
+// Define MMATH_INLINE and include MMath/Inline.h to use MMath header only.
+// Every function is then static inline so the compiler can inline whole chains (e.g. Mat44TRS into Mat44Mul)
+// instead of calling across the DLL boundary for every operation. The constants become inline variables, which requires C++17.
+#ifdef MMATH_INLINE
+#define DLL static inline
+#define DLL_DATA extern
+#define DLL_CONST inline
+#define DLL_INTERNAL inline
+#else
 #if defined(_WINLIB) || defined(_WINDLL)
 #define DLL __declspec(dllexport)
 #else
@@ -21,3 +30,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #define DLL __declspec(dllimport)
 #endif
 #endif
+#define DLL_DATA DLL extern // declaration of exported constants
+#define DLL_CONST // definition of constants that are declared extern in a header
+#define DLL_INTERNAL // helpers shared between our own cpp files, not exported
+#endif
@@ -0,0 +1,134 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Dispatch.h"
+#include <intrin.h>
+
+#ifdef MMATH_INLINE
+// The header only build has the kernels fixed at compile time, see DISPATCH in Dispatch.h
+extern "C"
+{
+	DLL bool DispatchFMASupported()
+	{
+#ifdef __AVX2__
+		return true;
+#else
+		return false;
+#endif
+	}
+	DLL bool DispatchUseFMA(const bool enabled)
+	{
+		return enabled == DispatchFMASupported();
+	}
+	DLL bool DispatchUsingFMA()
+	{
+		return DispatchFMASupported();
+	}
+}
+#else
+static constexpr DispatchTable DISPATCH_SSE = {
+	_Mat44MulSSE,
+	_Mat44VectorTransformSSE,
+	_Mat44MulArraySSE,
+	_Mat44InversedCheckedArraySSE,
+	_QuatMulSSE,
+	_QuatToMat44SSE,
+	_QuatSlerpArraySSE,
+	_QuatNlerpArraySSE,
+	_Vec3StreamDotSSE,
+	_Vec3StreamCrossSSE,
+	_Vec3StreamMagnitudeSSE,
+	_Vec3StreamNormalizedSSE,
+	_Vec3StreamPerpendicularSSE,
+	_Vec3StreamLerpSSE,
+	_Vec3StreamTransformSSE,
+	_SkinLinearBlendSSE,
+	_SkinDualQuatSSE,
+	_FrustumCullSpheresSSE,
+	_FrustumCullBoxesSSE,
+	_RayPacket8IntersectTrianglesSSE,
+	_RayPacket8IntersectBoxSSE,
+};
+
+static constexpr DispatchTable DISPATCH_FMA = {
+	_Mat44MulFMA,
+	_Mat44VectorTransformFMA,
+	_Mat44MulArrayFMA,
+	_Mat44InversedCheckedArrayFMA,
+	_QuatMulFMA,
+	_QuatToMat44FMA,
+	_QuatSlerpArrayFMA,
+	_QuatNlerpArrayFMA,
+	_Vec3StreamDotFMA,
+	_Vec3StreamCrossFMA,
+	_Vec3StreamMagnitudeFMA,
+	_Vec3StreamNormalizedFMA,
+	_Vec3StreamPerpendicularFMA,
+	_Vec3StreamLerpFMA,
+	_Vec3StreamTransformFMA,
+	_SkinLinearBlendFMA,
+	_SkinDualQuatFMA,
+	_FrustumCullSpheresFMA,
+	_FrustumCullBoxesFMA,
+	_RayPacket8IntersectTrianglesFMA,
+	_RayPacket8IntersectBoxFMA,
+};
+
+// Starts out on the SSE kernels (this is constant initialized, so it is valid even
+// for code that runs before our dynamic initializers), then gets upgraded below.
+DispatchTable gDispatch = DISPATCH_SSE;
+
+static bool _DetectFMA()
+{
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+
+	__cpuid(info, 1);
+	const bool fma = (info[2] & (1 << 12)) != 0;
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+	if (!fma || !osxsave || !avx)
+		return false;
+
+	// The OS must save the upper halves of the ymm registers on context switches
+	if ((_xgetbv(0) & 0b110) != 0b110)
+		return false;
+
+	__cpuidex(info, 7, 0);
+	const bool avx2 = (info[1] & (1 << 5)) != 0;
+	return avx2;
+}
+
+static const bool FMA_SUPPORTED = _DetectFMA();
+static const bool FMA_SELECTED = DispatchUseFMA(FMA_SUPPORTED);
+
+extern "C"
+{
+	DLL bool DispatchFMASupported()
+	{
+		return FMA_SUPPORTED;
+	}
+	DLL bool DispatchUseFMA(const bool enabled)
+	{
+		if (enabled && !FMA_SUPPORTED)
+			return false;
+		gDispatch = enabled ? DISPATCH_FMA : DISPATCH_SSE;
+		return true;
+	}
+	DLL bool DispatchUsingFMA()
+	{
+		return gDispatch.Mat44Mul == _Mat44MulFMA;
+	}
+}
+#endif
@@ -0,0 +1,118 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+
+// Some kernels have more than one implementation, the best one the CPU supports
+// is picked once when the library is loaded so a single binary runs on old and new machines.
+// The exported functions (Mat44Mul etc.) simply call through this table using DISPATCH(Mat44Mul)(...).
+
+#include "DLL.h"
+#include "Mat44.h"
+#include "Quat.h"
+#include "Stream.h"
+#include "Skinning.h"
+#include "Culling.h"
+#include "Intersect.h"
+
+extern "C"
+{
+	DLL bool DispatchFMASupported(); // whether this CPU (and OS) can run the AVX2 + FMA kernels
+	DLL bool DispatchUseFMA(const bool enabled); // switch kernels at runtime, e.g. for benchmarking, returns false if FMA was requested but is not supported
+	DLL bool DispatchUsingFMA();
+}
+
+// Internal, not exported
+struct DispatchTable
+{
+	Mat44(*Mat44Mul)(const Mat44 rhs, const Mat44 lhs);
+	Vec(*Mat44VectorTransform)(const Mat44 m, const __m128 v);
+	void(*Mat44MulArray)(const Mat44* children, const Mat44* parents, Mat44* result, const unsigned int count);
+	void(*Mat44InversedCheckedArray)(const Mat44* matrices, const float epsilon, Mat44* result, float* determinants, unsigned char* singular, const unsigned int count);
+	Quat(*QuatMul)(const Quat lhs, const Quat rhs);
+	Mat44(*QuatToMat44)(const Quat q);
+	void(*QuatSlerpArray)(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count);
+	void(*QuatNlerpArray)(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count, const bool corrected);
+	void(*Vec3StreamDot)(const Vec3Stream* a, const Vec3Stream* b, float* result);
+	void(*Vec3StreamCross)(const Vec3Stream* a, const Vec3Stream* b, Vec3Stream* result);
+	void(*Vec3StreamMagnitude)(const Vec3Stream* v, float* result);
+	void(*Vec3StreamNormalized)(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result, const ENormalizeMode mode);
+	void(*Vec3StreamPerpendicular)(const Vec3Stream* v, Vec3Stream* result);
+	void(*Vec3StreamLerp)(const Vec3Stream* a, const Vec3Stream* b, const float t, Vec3Stream* result);
+	void(*Vec3StreamTransform)(const Vec3Stream* v, const Mat44 m, const float w, Vec3Stream* result);
+	void(*SkinLinearBlend)(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count);
+	void(*SkinDualQuat)(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count);
+	unsigned int(*FrustumCullSpheres)(const Frustum frustum, const Vec3Stream* centers, const float* radii, unsigned char* visible, unsigned int* visibleIndices);
+	unsigned int(*FrustumCullBoxes)(const Frustum frustum, const Vec3Stream* centers, const Vec3Stream* extents, unsigned char* visible, unsigned int* visibleIndices);
+	unsigned int(*RayPacket8IntersectTriangles)(const RayPacket8* rays, const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2, RayHit8* hits);
+	unsigned int(*RayPacket8IntersectBox)(const RayPacket8* rays, const __m128 boxMin, const __m128 boxMax, const RayHit8* hits, float* tNear);
+};
+
+#ifdef MMATH_INLINE
+// There is no table in the header only build, the compiler flags of the including project pick the kernels
+#ifdef __AVX2__
+#define DISPATCH(name) _##name##FMA
+#else
+#define DISPATCH(name) _##name##SSE
+#endif
+#else
+extern DispatchTable gDispatch;
+#define DISPATCH(name) gDispatch.name
+#endif
+
+// SSE4 implementations, living next to their exported counterparts
+DLL_INTERNAL Mat44 _Mat44MulSSE(const Mat44 rhs, const Mat44 lhs);
+DLL_INTERNAL Vec _Mat44VectorTransformSSE(const Mat44 m, const __m128 v);
+DLL_INTERNAL void _Mat44MulArraySSE(const Mat44* children, const Mat44* parents, Mat44* result, const unsigned int count);
+DLL_INTERNAL void _Mat44InversedCheckedArraySSE(const Mat44* matrices, const float epsilon, Mat44* result, float* determinants, unsigned char* singular, const unsigned int count);
+DLL_INTERNAL Quat _QuatMulSSE(const Quat lhs, const Quat rhs);
+DLL_INTERNAL Mat44 _QuatToMat44SSE(const Quat q);
+DLL_INTERNAL void _QuatSlerpArraySSE(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count);
+DLL_INTERNAL void _QuatNlerpArraySSE(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count, const bool corrected);
+DLL_INTERNAL void _Vec3StreamDotSSE(const Vec3Stream* a, const Vec3Stream* b, float* result);
+DLL_INTERNAL void _Vec3StreamCrossSSE(const Vec3Stream* a, const Vec3Stream* b, Vec3Stream* result);
+DLL_INTERNAL void _Vec3StreamMagnitudeSSE(const Vec3Stream* v, float* result);
+DLL_INTERNAL void _Vec3StreamNormalizedSSE(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result, const ENormalizeMode mode);
+DLL_INTERNAL void _Vec3StreamPerpendicularSSE(const Vec3Stream* v, Vec3Stream* result);
+DLL_INTERNAL void _Vec3StreamLerpSSE(const Vec3Stream* a, const Vec3Stream* b, const float t, Vec3Stream* result);
+DLL_INTERNAL void _Vec3StreamTransformSSE(const Vec3Stream* v, const Mat44 m, const float w, Vec3Stream* result);
+DLL_INTERNAL void _SkinLinearBlendSSE(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count);
+DLL_INTERNAL void _SkinDualQuatSSE(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count);
+DLL_INTERNAL unsigned int _FrustumCullSpheresSSE(const Frustum frustum, const Vec3Stream* centers, const float* radii, unsigned char* visible, unsigned int* visibleIndices);
+DLL_INTERNAL unsigned int _FrustumCullBoxesSSE(const Frustum frustum, const Vec3Stream* centers, const Vec3Stream* extents, unsigned char* visible, unsigned int* visibleIndices);
+DLL_INTERNAL unsigned int _RayPacket8IntersectTrianglesSSE(const RayPacket8* rays, const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2, RayHit8* hits);
+DLL_INTERNAL unsigned int _RayPacket8IntersectBoxSSE(const RayPacket8* rays, const __m128 boxMin, const __m128 boxMax, const RayHit8* hits, float* tNear);
+
+// AVX2 + FMA implementations, in FMA.cpp
+#if !defined(MMATH_INLINE) || defined(__AVX2__)
+DLL_INTERNAL Mat44 _Mat44MulFMA(const Mat44 rhs, const Mat44 lhs);
+DLL_INTERNAL Vec _Mat44VectorTransformFMA(const Mat44 m, const __m128 v);
+DLL_INTERNAL void _Mat44MulArrayFMA(const Mat44* children, const Mat44* parents, Mat44* result, const unsigned int count);
+DLL_INTERNAL void _Mat44InversedCheckedArrayFMA(const Mat44* matrices, const float epsilon, Mat44* result, float* determinants, unsigned char* singular, const unsigned int count);
+DLL_INTERNAL Quat _QuatMulFMA(const Quat lhs, const Quat rhs);
+DLL_INTERNAL Mat44 _QuatToMat44FMA(const Quat q);
+DLL_INTERNAL void _QuatSlerpArrayFMA(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count);
+DLL_INTERNAL void _QuatNlerpArrayFMA(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count, const bool corrected);
+DLL_INTERNAL void _Vec3StreamDotFMA(const Vec3Stream* a, const Vec3Stream* b, float* result);
+DLL_INTERNAL void _Vec3StreamCrossFMA(const Vec3Stream* a, const Vec3Stream* b, Vec3Stream* result);
+DLL_INTERNAL void _Vec3StreamMagnitudeFMA(const Vec3Stream* v, float* result);
+DLL_INTERNAL void _Vec3StreamNormalizedFMA(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result, const ENormalizeMode mode);
+DLL_INTERNAL void _Vec3StreamPerpendicularFMA(const Vec3Stream* v, Vec3Stream* result);
+DLL_INTERNAL void _Vec3StreamLerpFMA(const Vec3Stream* a, const Vec3Stream* b, const float t, Vec3Stream* result);
+DLL_INTERNAL void _Vec3StreamTransformFMA(const Vec3Stream* v, const Mat44 m, const float w, Vec3Stream* result);
+DLL_INTERNAL void _SkinLinearBlendFMA(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count);
+DLL_INTERNAL void _SkinDualQuatFMA(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count);
+DLL_INTERNAL unsigned int _FrustumCullSpheresFMA(const Frustum frustum, const Vec3Stream* centers, const float* radii, unsigned char* visible, unsigned int* visibleIndices);
+DLL_INTERNAL unsigned int _FrustumCullBoxesFMA(const Frustum frustum, const Vec3Stream* centers, const Vec3Stream* extents, unsigned char* visible, unsigned int* visibleIndices);
+DLL_INTERNAL unsigned int _RayPacket8IntersectTrianglesFMA(const RayPacket8* rays, const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2, RayHit8* hits);
+DLL_INTERNAL unsigned int _RayPacket8IntersectBoxFMA(const RayPacket8* rays, const __m128 boxMin, const __m128 boxMax, const RayHit8* hits, float* tNear);
+#endif
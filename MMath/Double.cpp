@@ -0,0 +1,349 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+// Double precision reference versions of the core functions, see Double.h.
+// This file is always compiled with /arch:AVX2 (see MMath.vcxproj), like FMA.cpp.
+// The simple element wise work is done on whole __m256d vectors, the inverse and determinant are written out in scalar
+// doubles because their float versions are a shuffle puzzle that does not need to be repeated to get a reference.
+
+#include "Double.h"
+#include <math.h>
+
+static const __m256d F64_ONE = { 1.0, 1.0, 1.0, 1.0 };
+static const __m256d F64_UNIT_X = { 1.0, 0.0, 0.0, 0.0 };
+static const __m256d F64_UNIT_Y = { 0.0, 1.0, 0.0, 0.0 };
+static const __m256d F64_UNIT_Z = { 0.0, 0.0, 1.0, 0.0 };
+static const __m256d F64_UNIT_W = { 0.0, 0.0, 0.0, 1.0 };
+static const __m256d F64_VEC2_MASK = { 1.0, 1.0, 0.0, 0.0 };
+static const __m256d F64_VEC3_MASK = { 1.0, 1.0, 1.0, 0.0 };
+static const __m256d F64_SIGNFLIP_0101 = { 1.0, -1.0, 1.0, -1.0 };
+static const __m256d F64_SIGNFLIP_0011 = { 1.0, 1.0, -1.0, -1.0 };
+static const __m256d F64_SIGNFLIP_1001 = { -1.0, 1.0, 1.0, -1.0 };
+static const __m256d F64_SIGNFLIP_1110 = { -1.0, -1.0, -1.0, 1.0 };
+
+__forceinline __m256d _mm256_swizzle_pd_0(__m256d v) { return _mm256_permute4x64_pd(v, _MM_SHUFFLE(0, 0, 0, 0)); }
+__forceinline __m256d _mm256_swizzle_pd_1(__m256d v) { return _mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 1, 1, 1)); }
+__forceinline __m256d _mm256_swizzle_pd_2(__m256d v) { return _mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 2, 2, 2)); }
+__forceinline __m256d _mm256_swizzle_pd_3(__m256d v) { return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+__forceinline double _Vec4DotD(const __m256d a, const __m256d b)
+{
+	const __m256d m = _mm256_mul_pd(a, b);
+	__m128d s = _mm_add_pd(_mm256_castpd256_pd128(m), _mm256_extractf128_pd(m, 1));
+	s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+	return _mm_cvtsd_f64(s);
+}
+
+__forceinline VecD _VecMaskNormalizedD(__m256d v, const __m256d mask, const __m256d fallback)
+{
+	v = _mm256_mul_pd(v, mask);
+	const double sqrMagnitude = _Vec4DotD(v, v);
+	if (sqrMagnitude == 0.0)
+		return { _mm256_mul_pd(fallback, mask) };
+	return { _mm256_div_pd(v, _mm256_set1_pd(sqrt(sqrMagnitude))) };
+}
+
+// The 2x2 minors of the top two and bottom two rows (or columns, the inverse does not care),
+// a[i][j] = m[i * 4 + j], shared by the determinant and the inverse
+struct _Mat44MinorsD
+{
+	double s[6];
+	double c[6];
+	double determinant;
+};
+
+__forceinline _Mat44MinorsD _Mat44Minors(const Mat44D& m)
+{
+	const double* a = m.m;
+	_Mat44MinorsD r;
+	r.s[0] = a[0] * a[5] - a[4] * a[1];
+	r.s[1] = a[0] * a[6] - a[4] * a[2];
+	r.s[2] = a[0] * a[7] - a[4] * a[3];
+	r.s[3] = a[1] * a[6] - a[5] * a[2];
+	r.s[4] = a[1] * a[7] - a[5] * a[3];
+	r.s[5] = a[2] * a[7] - a[6] * a[3];
+	r.c[0] = a[8] * a[13] - a[12] * a[9];
+	r.c[1] = a[8] * a[14] - a[12] * a[10];
+	r.c[2] = a[8] * a[15] - a[12] * a[11];
+	r.c[3] = a[9] * a[14] - a[13] * a[10];
+	r.c[4] = a[9] * a[15] - a[13] * a[11];
+	r.c[5] = a[10] * a[15] - a[14] * a[11];
+	r.determinant = r.s[0] * r.c[5] - r.s[1] * r.c[4] + r.s[2] * r.c[3] + r.s[3] * r.c[2] - r.s[4] * r.c[1] + r.s[5] * r.c[0];
+	return r;
+}
+
+extern "C"
+{
+	DLL VecD VecToVecD(const __m128 v) { return { _mm256_cvtps_pd(v) }; }
+	DLL Vec VecDToVec(const __m256d v) { return { _mm256_cvtpd_ps(v) }; }
+	DLL QuatD QuatToQuatD(const Quat q) { return { _mm256_cvtps_pd(q.q) }; }
+	DLL Quat QuatDToQuat(const QuatD q) { return { _mm256_cvtpd_ps(q.q) }; }
+	DLL Mat44D Mat44ToMat44D(const Mat44 m)
+	{
+		return { _mm256_cvtps_pd(m.col0), _mm256_cvtps_pd(m.col1), _mm256_cvtps_pd(m.col2), _mm256_cvtps_pd(m.col3) };
+	}
+	DLL Mat44 Mat44DToMat44(const Mat44D m)
+	{
+		return { _mm256_cvtpd_ps(m.col0), _mm256_cvtpd_ps(m.col1), _mm256_cvtpd_ps(m.col2), _mm256_cvtpd_ps(m.col3) };
+	}
+
+	DLL double Vec4DotD(const __m256d a, const __m256d b) { return _Vec4DotD(a, b); }
+	DLL double Vec4SqrMagnitudeD(const __m256d v) { return _Vec4DotD(v, v); }
+	DLL double Vec4MagnitudeD(const __m256d v) { return sqrt(_Vec4DotD(v, v)); }
+	DLL VecD Vec4NormalizedD(const __m256d v, const __m256d fallback) { return _VecMaskNormalizedD(v, F64_ONE, fallback); }
+
+	DLL double Vec3DotD(const __m256d a, const __m256d b) { return _Vec4DotD(_mm256_mul_pd(a, F64_VEC3_MASK), b); }
+	DLL double Vec3SqrMagnitudeD(const __m256d v) { return Vec3DotD(v, v); }
+	DLL double Vec3MagnitudeD(const __m256d v) { return sqrt(Vec3DotD(v, v)); }
+	DLL VecD Vec3NormalizedD(const __m256d v, const __m256d fallback) { return _VecMaskNormalizedD(v, F64_VEC3_MASK, fallback); }
+	DLL VecD Vec3CrossD(const __m256d a, const __m256d b)
+	{
+		const __m256d a2 = _mm256_permute4x64_pd(a, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m256d b2 = _mm256_permute4x64_pd(b, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m256d v = _mm256_permute4x64_pd(_mm256_sub_pd(_mm256_mul_pd(a, b2), _mm256_mul_pd(b, a2)), _MM_SHUFFLE(3, 0, 2, 1));
+		return { _mm256_mul_pd(v, F64_VEC3_MASK) };
+	}
+
+	DLL double Vec2DotD(const __m256d a, const __m256d b) { return _Vec4DotD(_mm256_mul_pd(a, F64_VEC2_MASK), b); }
+	DLL double Vec2SqrMagnitudeD(const __m256d v) { return Vec2DotD(v, v); }
+	DLL double Vec2MagnitudeD(const __m256d v) { return sqrt(Vec2DotD(v, v)); }
+	DLL VecD Vec2NormalizedD(const __m256d v, const __m256d fallback) { return _VecMaskNormalizedD(v, F64_VEC2_MASK, fallback); }
+	DLL double Vec2CrossD(const __m256d a, const __m256d b)
+	{
+		const __m128d v = _mm256_castpd256_pd128(_mm256_mul_pd(a, _mm256_permute4x64_pd(b, _MM_SHUFFLE(0, 0, 0, 1))));
+		return _mm_cvtsd_f64(_mm_sub_sd(v, _mm_unpackhi_pd(v, v)));
+	}
+
+	DLL QuatD QuatIdentityD()
+	{
+		return { F64_UNIT_W };
+	}
+	DLL QuatD QuatRotateXD(const double radians)
+	{
+		return { _mm256_set_pd(cos(radians * 0.5), 0.0, 0.0, sin(radians * 0.5)) };
+	}
+	DLL QuatD QuatRotateYD(const double radians)
+	{
+		return { _mm256_set_pd(cos(radians * 0.5), 0.0, sin(radians * 0.5), 0.0) };
+	}
+	DLL QuatD QuatRotateZD(const double radians)
+	{
+		return { _mm256_set_pd(cos(radians * 0.5), sin(radians * 0.5), 0.0, 0.0) };
+	}
+	DLL QuatD QuatMulD(const QuatD lhs, const QuatD rhs)
+	{
+		// Same terms as _QuatMulSSE
+		const __m256d x = _mm256_mul_pd(F64_SIGNFLIP_0101, _mm256_mul_pd(_mm256_permute4x64_pd(lhs.q, _MM_SHUFFLE(0, 1, 2, 3)), _mm256_swizzle_pd_0(rhs.q)));
+		const __m256d y = _mm256_mul_pd(F64_SIGNFLIP_0011, _mm256_mul_pd(_mm256_permute4x64_pd(lhs.q, _MM_SHUFFLE(1, 0, 3, 2)), _mm256_swizzle_pd_1(rhs.q)));
+		const __m256d z = _mm256_mul_pd(F64_SIGNFLIP_1001, _mm256_mul_pd(_mm256_permute4x64_pd(lhs.q, _MM_SHUFFLE(2, 3, 0, 1)), _mm256_swizzle_pd_2(rhs.q)));
+		const __m256d w = _mm256_mul_pd(lhs.q, _mm256_swizzle_pd_3(rhs.q));
+		return { _mm256_add_pd(_mm256_add_pd(x, y), _mm256_add_pd(z, w)) };
+	}
+	DLL double QuatDotD(const QuatD a, const QuatD b)
+	{
+		return _Vec4DotD(a.q, b.q);
+	}
+	DLL double QuatSqrMagnitudeD(const QuatD q)
+	{
+		return _Vec4DotD(q.q, q.q);
+	}
+	DLL double QuatMagnitudeD(const QuatD q)
+	{
+		return sqrt(_Vec4DotD(q.q, q.q));
+	}
+	DLL QuatD QuatNormalizedD(const QuatD q, const QuatD fallback)
+	{
+		return { _VecMaskNormalizedD(q.q, F64_ONE, fallback.q).s };
+	}
+	DLL QuatD QuatInversedD(const QuatD q)
+	{
+		return { _mm256_mul_pd(q.q, F64_SIGNFLIP_1110) };
+	}
+	DLL QuatD QuatConjugatedD(const QuatD q)
+	{
+		return QuatInversedD(q);
+	}
+	DLL QuatD QuatSlerpD(const QuatD l, const QuatD r, const double t)
+	{
+		// Same shortest path and linear fallback as QuatSlerp
+		__m256d other = r.q;
+		double cosOmega = _Vec4DotD(l.q, r.q);
+		if (cosOmega < 0.0)
+		{
+			cosOmega = -cosOmega;
+			other = _mm256_sub_pd(_mm256_setzero_pd(), other);
+		}
+		if (cosOmega < (double)QUAT_SLERP_LINEAR_THRESHOLD)
+		{
+			const double sinOmega = sqrt(1.0 - cosOmega * cosOmega);
+			const double omega = acos(cosOmega);
+			const __m256d wl = _mm256_set1_pd(sin(omega * (1.0 - t)) / sinOmega);
+			const __m256d wr = _mm256_set1_pd(sin(omega * t) / sinOmega);
+			return { _mm256_add_pd(_mm256_mul_pd(l.q, wl), _mm256_mul_pd(other, wr)) };
+		}
+		return { _mm256_add_pd(l.q, _mm256_mul_pd(_mm256_set1_pd(t), _mm256_sub_pd(other, l.q))) };
+	}
+	DLL VecD QuatVectorTransformD(const QuatD q, const __m256d v)
+	{
+		const VecD p = { v };
+		return { _mm256_set_pd(p.w,
+			p.x * (-2 * q.w * q.y + 2 * q.x * q.z) + p.y * (2 * q.w * q.x + 2 * q.y * q.z) + p.z * (q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z),
+			p.x * (2 * q.w * q.z + 2 * q.x * q.y) + p.y * (q.w * q.w - q.x * q.x + q.y * q.y - q.z * q.z) + p.z * (-2 * q.w * q.x + 2 * q.y * q.z),
+			p.x * (q.x * q.x + q.w * q.w - q.y * q.y - q.z * q.z) + p.y * (2 * q.x * q.y - 2 * q.w * q.z) + p.z * (2 * q.x * q.z + 2 * q.w * q.y)
+		) };
+	}
+	DLL Mat44D QuatToMat44D(const QuatD q)
+	{
+		// Like QuatToMat44, q does not have to be normalized
+		const double s = 2.0 / _Vec4DotD(q.q, q.q);
+		const double xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+		const double xy = q.x * q.y, yz = q.y * q.z, zx = q.z * q.x;
+		const double wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+		return { _mm256_set_pd(0.0, s * (zx - wy), s * (xy + wz), 1.0 - s * (yy + zz)),
+			_mm256_set_pd(0.0, s * (yz + wx), 1.0 - s * (xx + zz), s * (xy - wz)),
+			_mm256_set_pd(0.0, 1.0 - s * (xx + yy), s * (yz - wx), s * (zx + wy)),
+			F64_UNIT_W };
+	}
+
+	DLL Mat44D Mat44IdentityD()
+	{
+		return { F64_UNIT_X, F64_UNIT_Y, F64_UNIT_Z, F64_UNIT_W };
+	}
+	DLL Mat44D Mat44TranslateD(const double x, const double y, const double z)
+	{
+		return { F64_UNIT_X, F64_UNIT_Y, F64_UNIT_Z, _mm256_set_pd(1.0, z, y, x) };
+	}
+	DLL Mat44D Mat44RotateXD(const double radians)
+	{
+		const double s = sin(radians), c = cos(radians);
+		return { F64_UNIT_X, _mm256_set_pd(0.0, s, c, 0.0), _mm256_set_pd(0.0, c, -s, 0.0), F64_UNIT_W };
+	}
+	DLL Mat44D Mat44RotateYD(const double radians)
+	{
+		const double s = sin(radians), c = cos(radians);
+		return { _mm256_set_pd(0.0, -s, 0.0, c), F64_UNIT_Y, _mm256_set_pd(0.0, c, 0.0, s), F64_UNIT_W };
+	}
+	DLL Mat44D Mat44RotateZD(const double radians)
+	{
+		const double s = sin(radians), c = cos(radians);
+		return { _mm256_set_pd(0.0, 0.0, s, c), _mm256_set_pd(0.0, 0.0, c, -s), F64_UNIT_Z, F64_UNIT_W };
+	}
+	DLL Mat44D Mat44ScaleD(const double x, const double y, const double z)
+	{
+		return { _mm256_set_pd(0.0, 0.0, 0.0, x), _mm256_set_pd(0.0, 0.0, y, 0.0), _mm256_set_pd(0.0, z, 0.0, 0.0), F64_UNIT_W };
+	}
+	DLL Mat44D Mat44MulD(const Mat44D rhs, const Mat44D lhs)
+	{
+		Mat44D m;
+		for (int i = 0; i < 4; ++i)
+		{
+			m.cols[i] = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(lhs.col0, _mm256_swizzle_pd_0(rhs.cols[i])),
+				_mm256_mul_pd(lhs.col1, _mm256_swizzle_pd_1(rhs.cols[i]))),
+				_mm256_add_pd(_mm256_mul_pd(lhs.col2, _mm256_swizzle_pd_2(rhs.cols[i])),
+					_mm256_mul_pd(lhs.col3, _mm256_swizzle_pd_3(rhs.cols[i]))));
+		}
+		return m;
+	}
+	DLL Mat44D Mat44InversedD(const Mat44D m)
+	{
+		// Adjugate divided by the determinant, like Mat44Inversed there is no check for singular matrices
+		const double* a = m.m;
+		const _Mat44MinorsD minors = _Mat44Minors(m);
+		const double* s = minors.s;
+		const double* c = minors.c;
+		const double d = 1.0 / minors.determinant;
+		Mat44D r;
+		r.m[0] = (a[5] * c[5] - a[6] * c[4] + a[7] * c[3]) * d;
+		r.m[1] = (-a[1] * c[5] + a[2] * c[4] - a[3] * c[3]) * d;
+		r.m[2] = (a[13] * s[5] - a[14] * s[4] + a[15] * s[3]) * d;
+		r.m[3] = (-a[9] * s[5] + a[10] * s[4] - a[11] * s[3]) * d;
+		r.m[4] = (-a[4] * c[5] + a[6] * c[2] - a[7] * c[1]) * d;
+		r.m[5] = (a[0] * c[5] - a[2] * c[2] + a[3] * c[1]) * d;
+		r.m[6] = (-a[12] * s[5] + a[14] * s[2] - a[15] * s[1]) * d;
+		r.m[7] = (a[8] * s[5] - a[10] * s[2] + a[11] * s[1]) * d;
+		r.m[8] = (a[4] * c[4] - a[5] * c[2] + a[7] * c[0]) * d;
+		r.m[9] = (-a[0] * c[4] + a[1] * c[2] - a[3] * c[0]) * d;
+		r.m[10] = (a[12] * s[4] - a[13] * s[2] + a[15] * s[0]) * d;
+		r.m[11] = (-a[8] * s[4] + a[9] * s[2] - a[11] * s[0]) * d;
+		r.m[12] = (-a[4] * c[3] + a[5] * c[1] - a[6] * c[0]) * d;
+		r.m[13] = (a[0] * c[3] - a[1] * c[1] + a[2] * c[0]) * d;
+		r.m[14] = (-a[12] * s[3] + a[13] * s[1] - a[14] * s[0]) * d;
+		r.m[15] = (a[8] * s[3] - a[9] * s[1] + a[10] * s[0]) * d;
+		return r;
+	}
+	DLL Mat44D Mat44TransposedD(const Mat44D m)
+	{
+		const __m256d t0 = _mm256_unpacklo_pd(m.col0, m.col1);
+		const __m256d t1 = _mm256_unpackhi_pd(m.col0, m.col1);
+		const __m256d t2 = _mm256_unpacklo_pd(m.col2, m.col3);
+		const __m256d t3 = _mm256_unpackhi_pd(m.col2, m.col3);
+		return { _mm256_permute2f128_pd(t0, t2, 0x20), _mm256_permute2f128_pd(t1, t3, 0x20),
+			_mm256_permute2f128_pd(t0, t2, 0x31), _mm256_permute2f128_pd(t1, t3, 0x31) };
+	}
+	DLL double Mat44DeterminantD(const Mat44D m)
+	{
+		return _Mat44Minors(m).determinant;
+	}
+	DLL VecD Mat44VectorTransformD(const Mat44D m, const __m256d v)
+	{
+		// Note: set v.w to 0 to ignore translation
+		return { _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m.col0, _mm256_swizzle_pd_0(v)),
+			_mm256_mul_pd(m.col1, _mm256_swizzle_pd_1(v))),
+			_mm256_add_pd(_mm256_mul_pd(m.col2, _mm256_swizzle_pd_2(v)),
+				_mm256_mul_pd(m.col3, _mm256_swizzle_pd_3(v)))) };
+	}
+	DLL Mat44D Mat44RotateD(const double radiansX, const double radiansY, const double radiansZ, const ERotateOrder rotateOrder)
+	{
+		// _Mat44RotateOrdered with the axes picked at runtime
+		const int a = (int)rotateOrder >> 4;
+		const int b = ((int)rotateOrder >> 2) & 0b11;
+		const int k = (int)rotateOrder & 0b11;
+		const double sign = ((a + 1) % 3) != b ? -1.0 : 1.0;
+		const double radians[3] = { radiansX, radiansY, radiansZ };
+		const double sa = sign * sin(radians[a]), sb = sign * sin(radians[b]), sc = sign * sin(radians[k]);
+		const double ca = cos(radians[a]), cb = cos(radians[b]), cc = cos(radians[k]);
+
+		// m[column][row]
+		double m[3][3];
+		m[a][a] = cb * cc;
+		m[a][b] = cb * sc;
+		m[a][k] = -sb;
+		m[b][a] = sa * sb * cc - ca * sc;
+		m[b][b] = sa * sb * sc + ca * cc;
+		m[b][k] = sa * cb;
+		m[k][a] = ca * sb * cc + sa * sc;
+		m[k][b] = ca * sb * sc - sa * cc;
+		m[k][k] = ca * cb;
+
+		return { _mm256_set_pd(0.0, m[0][2], m[0][1], m[0][0]),
+			_mm256_set_pd(0.0, m[1][2], m[1][1], m[1][0]),
+			_mm256_set_pd(0.0, m[2][2], m[2][1], m[2][0]),
+			F64_UNIT_W };
+	}
+	DLL Mat44D Mat44TRSD(const double x, const double y, const double z, const double radiansX, const double radiansY, const double radiansZ, const double scaleX, const double scaleY, const double scaleZ, const ERotateOrder rotateOrder)
+	{
+		Mat44D r = Mat44RotateD(radiansX, radiansY, radiansZ, rotateOrder);
+		r.col0 = _mm256_mul_pd(r.col0, _mm256_set1_pd(scaleX));
+		r.col1 = _mm256_mul_pd(r.col1, _mm256_set1_pd(scaleY));
+		r.col2 = _mm256_mul_pd(r.col2, _mm256_set1_pd(scaleZ));
+		r.col3 = _mm256_set_pd(1.0, z, y, x);
+		return r;
+	}
+	DLL VecD Mat44ToScaleD(const Mat44D m)
+	{
+		return { _mm256_set_pd(0.0, Vec3MagnitudeD(m.col2), Vec3MagnitudeD(m.col1), Vec3MagnitudeD(m.col0)) };
+	}
+	DLL VecD Mat44ToTranslateD(const Mat44D m)
+	{
+		return { _mm256_mul_pd(F64_VEC3_MASK, m.col3) };
+	}
+}
@@ -0,0 +1,131 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include <immintrin.h>
+#include "Enums.h"
+#include "Vector.h"
+#include "Quat.h"
+#include "Mat44.h"
+
+// Double precision versions of the core Vec, Quat and Mat44 functions, the same names with a D suffix.
+// They follow the float code step by step (same fallbacks, thresholds and conventions) but with exact
+// square roots, divisions and libm sin / cos / acos instead of _mm_rsqrt_ps and friends, so comparing the two
+// shows how much precision the float versions actually lose, see --accuracy in the Benchmark project.
+// This is a reference, not a faster path: it is not dispatched and always needs AVX2 (Double.cpp is compiled with it).
+
+extern "C"
+{
+	__declspec(align(32)) struct VecD
+	{
+		union
+		{
+			__m256d s;
+			struct
+			{
+				double x, y, z, w;
+			};
+		};
+		operator __m256d() { return s; }
+	};
+
+	__declspec(align(32)) struct QuatD
+	{
+		union
+		{
+			__m256d q;
+			struct
+			{
+				double x;
+				double y;
+				double z;
+				double w;
+			};
+			double s[4];
+		};
+	};
+
+	__declspec(align(32)) struct Mat44D
+	{
+		union
+		{
+			__m256d cols[4];
+			struct
+			{
+				__m256d col0;
+				__m256d col1;
+				__m256d col2;
+				__m256d col3;
+			};
+			double m[16];
+		};
+	};
+
+	// Conversions, to double is exact
+	DLL VecD VecToVecD(const __m128 v);
+	DLL Vec VecDToVec(const __m256d v);
+	DLL QuatD QuatToQuatD(const Quat q);
+	DLL Quat QuatDToQuat(const QuatD q);
+	DLL Mat44D Mat44ToMat44D(const Mat44 m);
+	DLL Mat44 Mat44DToMat44(const Mat44D m);
+
+	// Vector.h
+	DLL double Vec4DotD(const __m256d a, const __m256d b);
+	DLL double Vec4SqrMagnitudeD(const __m256d v);
+	DLL double Vec4MagnitudeD(const __m256d v);
+	DLL VecD Vec4NormalizedD(const __m256d v, const __m256d fallback);
+	DLL double Vec3DotD(const __m256d a, const __m256d b);
+	DLL VecD Vec3CrossD(const __m256d a, const __m256d b);
+	DLL double Vec3SqrMagnitudeD(const __m256d v);
+	DLL double Vec3MagnitudeD(const __m256d v);
+	DLL VecD Vec3NormalizedD(const __m256d v, const __m256d fallback);
+	DLL double Vec2DotD(const __m256d a, const __m256d b);
+	DLL double Vec2CrossD(const __m256d a, const __m256d b);
+	DLL double Vec2SqrMagnitudeD(const __m256d v);
+	DLL double Vec2MagnitudeD(const __m256d v);
+	DLL VecD Vec2NormalizedD(const __m256d v, const __m256d fallback);
+
+	// Quat.h
+	DLL QuatD QuatIdentityD();
+	DLL QuatD QuatRotateXD(const double radians);
+	DLL QuatD QuatRotateYD(const double radians);
+	DLL QuatD QuatRotateZD(const double radians);
+	DLL QuatD QuatMulD(const QuatD lhs, const QuatD rhs);
+	DLL double QuatDotD(const QuatD a, const QuatD b);
+	DLL double QuatSqrMagnitudeD(const QuatD q);
+	DLL double QuatMagnitudeD(const QuatD q);
+	DLL QuatD QuatNormalizedD(const QuatD q, const QuatD fallback);
+	DLL QuatD QuatInversedD(const QuatD q);
+	DLL QuatD QuatConjugatedD(const QuatD q);
+	DLL QuatD QuatSlerpD(const QuatD l, const QuatD r, const double t);
+	DLL VecD QuatVectorTransformD(const QuatD q, const __m256d v);
+	DLL Mat44D QuatToMat44D(const QuatD q);
+
+	// Mat44.h
+	DLL Mat44D Mat44IdentityD();
+	DLL Mat44D Mat44TranslateD(const double x, const double y, const double z);
+	DLL Mat44D Mat44RotateXD(const double radians);
+	DLL Mat44D Mat44RotateYD(const double radians);
+	DLL Mat44D Mat44RotateZD(const double radians);
+	DLL Mat44D Mat44ScaleD(const double x, const double y, const double z);
+	DLL Mat44D Mat44MulD(const Mat44D rhs, const Mat44D lhs);
+	DLL Mat44D Mat44InversedD(const Mat44D m);
+	DLL Mat44D Mat44TransposedD(const Mat44D m);
+	DLL double Mat44DeterminantD(const Mat44D m);
+	DLL VecD Mat44VectorTransformD(const Mat44D m, const __m256d v);
+	DLL Mat44D Mat44RotateD(const double radiansX, const double radiansY, const double radiansZ, const ERotateOrder rotateOrder);
+	DLL Mat44D Mat44TRSD(const double x, const double y, const double z, const double radiansX, const double radiansY, const double radiansZ, const double scaleX, const double scaleY, const double scaleZ, const ERotateOrder rotateOrder);
+	DLL VecD Mat44ToScaleD(const Mat44D m);
+	DLL VecD Mat44ToTranslateD(const Mat44D m);
+}
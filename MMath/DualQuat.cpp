@@ -0,0 +1,86 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "DualQuat.h"
+#include "Friends.h"
+#include "SIMD.h"
+#include "Dispatch.h"
+
+// QuatMul(a, b) applies a then b, so in the usual Hamilton notation it computes b * a.
+// The formulas below are written with QuatMul, the comments use Hamilton notation.
+
+extern "C"
+{
+	DLL DualQuat DualQuatIdentity()
+	{
+		return { { F32_UNIT_W }, { F32_ZERO } };
+	}
+	DLL DualQuat DualQuatFromQuatTranslation(const Quat rotation, const __m128 translation)
+	{
+		// dual = 0.5 * t * r
+		Quat t = { _mm_mul_ps(translation, _mm_set_ps(0.0f, 0.5f, 0.5f, 0.5f)) };
+		return { rotation, DISPATCH(QuatMul)(rotation, t) };
+	}
+	DLL Vec DualQuatTranslation(const DualQuat dq)
+	{
+		// t = 2 * dual * conjugate(real)
+		Quat t = DISPATCH(QuatMul)({ _mm_mul_ps(dq.real.q, F32_SIGNFLIP_1110) }, dq.dual);
+		return { _mm_mul_ps(t.q, _mm_set_ps(0.0f, 2.0f, 2.0f, 2.0f)) };
+	}
+	DLL DualQuat DualQuatMul(const DualQuat lhs, const DualQuat rhs)
+	{
+		// real = rhs.real * lhs.real, dual = rhs.real * lhs.dual + rhs.dual * lhs.real
+		Quat real = DISPATCH(QuatMul)(lhs.real, rhs.real);
+		Quat a = DISPATCH(QuatMul)(lhs.dual, rhs.real);
+		Quat b = DISPATCH(QuatMul)(lhs.real, rhs.dual);
+		return { real, { _mm_add_ps(a.q, b.q) } };
+	}
+	DLL DualQuat DualQuatNormalized(const DualQuat dq)
+	{
+		__m128 sqrLength = _mm_dp_ps(dq.real.q, dq.real.q, 0xFF);
+		if (sqrLength.m128_f32[0] == 0.0f)
+			return DualQuatIdentity();
+		__m128 invLength = _mm_div_ps(F32_ONE, _mm_sqrt_ps(sqrLength));
+		__m128 real = _mm_mul_ps(dq.real.q, invLength);
+		__m128 dual = _mm_mul_ps(dq.dual.q, invLength);
+		dual = _mm_sub_ps(dual, _mm_mul_ps(real, _mm_dp_ps(real, dual, 0xFF)));
+		return { { real }, { dual } };
+	}
+	DLL DualQuat DualQuatConjugated(const DualQuat dq)
+	{
+		return { { _mm_mul_ps(dq.real.q, F32_SIGNFLIP_1110) }, { _mm_mul_ps(dq.dual.q, F32_SIGNFLIP_1110) } };
+	}
+	DLL Vec DualQuatPointTransform(const DualQuat dq, const __m128 p)
+	{
+		return { _DualQuatPointTransform(dq.real.q, dq.dual.q, _mm_blend_ps(p, F32_ONE, 0b1000)) };
+	}
+	DLL Vec DualQuatVectorTransform(const DualQuat dq, const __m128 v)
+	{
+		return { _DualQuatVectorTransform(dq.real.q, _mm_blend_ps(v, F32_ZERO, 0b1000)) };
+	}
+	DLL DualQuat Mat44ToDualQuat(const Mat44 m)
+	{
+		// Mat44ToQuat normalizes with rsqrt, which is not accurate enough to keep the translation intact
+		return DualQuatFromQuatTranslation(Mat44ToQuatMode(m, ENormalizeMode::Exact), m.col3);
+	}
+	DLL Mat44 DualQuatToMat44(const DualQuat dq)
+	{
+		Mat44 m = DISPATCH(QuatToMat44)(dq.real);
+		m.col3 = _mm_add_ps(DualQuatTranslation(dq).s, F32_UNIT_W);
+		return m;
+	}
+	DLL void Mat44ToDualQuatArray(const Mat44* matrices, DualQuat* result, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = Mat44ToDualQuat(matrices[i]);
+	}
+}
@@ -0,0 +1,61 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include "Quat.h"
+#include "Mat44.h"
+#include "SIMD.h"
+
+extern "C"
+{
+	// Rigid transform (rotation + translation) in 32 bytes instead of the 64 of a Mat44.
+	// real is the rotation, dual is half the translation multiplied by the rotation.
+	__declspec(align(16)) struct DualQuat
+	{
+		Quat real;
+		Quat dual;
+	};
+
+	DLL DualQuat DualQuatIdentity();
+	DLL DualQuat DualQuatFromQuatTranslation(const Quat rotation, const __m128 translation);
+	DLL Vec DualQuatTranslation(const DualQuat dq); // w = 0
+	DLL DualQuat DualQuatMul(const DualQuat lhs, const DualQuat rhs); // lhs then rhs, same order as QuatMul and Mat44Mul
+	DLL DualQuat DualQuatNormalized(const DualQuat dq); // unit real part and dual part orthogonal to it
+	DLL DualQuat DualQuatConjugated(const DualQuat dq); // also the inverse of unit dual quaternions
+	DLL Vec DualQuatPointTransform(const DualQuat dq, const __m128 p); // rotate and translate, w = 1
+	DLL Vec DualQuatVectorTransform(const DualQuat dq, const __m128 v); // rotate only, w = 0
+	DLL DualQuat Mat44ToDualQuat(const Mat44 m); // m must be rigid, scale and shear can not be represented
+	DLL Mat44 DualQuatToMat44(const DualQuat dq);
+	DLL void Mat44ToDualQuatArray(const Mat44* matrices, DualQuat* result, const unsigned int count); // e.g. to convert a skinning palette
+}
+
+// Internal, shared with the dual quaternion skinning kernels and XForm.cpp. real must be unit length.
+__forceinline __m128 _DualQuatCross(const __m128 a, const __m128 b)
+{
+	return _mm_swizzle_ps_1203(_mm_sub_ps(_mm_mul_ps(a, _mm_swizzle_ps_1203(b)), _mm_mul_ps(b, _mm_swizzle_ps_1203(a))));
+}
+__forceinline __m128 _DualQuatVectorTransform(const __m128 real, const __m128 v)
+{
+	// v + 2 * cross(real.xyz, cross(real.xyz, v) + real.w * v)
+	__m128 t = _mm_add_ps(_DualQuatCross(real, v), _mm_mul_ps(_mm_swizzle_ps_3(real), v));
+	__m128 r = _DualQuatCross(real, t);
+	return _mm_add_ps(v, _mm_add_ps(r, r));
+}
+__forceinline __m128 _DualQuatPointTransform(const __m128 real, const __m128 dual, const __m128 p)
+{
+	// rotated p + 2 * (real.w * dual.xyz - dual.w * real.xyz + cross(real.xyz, dual.xyz))
+	__m128 t = _mm_sub_ps(_mm_mul_ps(_mm_swizzle_ps_3(real), dual), _mm_mul_ps(_mm_swizzle_ps_3(dual), real));
+	t = _mm_add_ps(t, _DualQuatCross(real, dual));
+	return _mm_add_ps(_DualQuatVectorTransform(real, p), _mm_add_ps(t, t));
+}
@@ -67,5 +67,18 @@ extern "C"
 		NotFlipped = 0b01000, // when set, check for negative scaling, so all axes cross & dot > 0 = OK
 		FourthRow = 0b10000, // when set, check for garbage in the last row, so col[0,1,2].w = 0 and col3.w = 1 = OK
 	};
+
+	/*
+	Precision of the functions that end in Mode, e.g. Vec3NormalizedMode, see Benchmark.exe --accuracy for measurements.
+	Fast uses _mm_rsqrt_ps, 12 bits or about 1300 ULPs, like the Normalized functions without a mode.
+	Refined adds one Newton-Raphson step to that, within a few ULPs, for 4 more multiplies.
+	Exact divides by the square root, correctly rounded like QuatNormalized, at several times the latency.
+	*/
+	enum class ENormalizeMode
+	{
+		Fast = 0,
+		Refined = 1,
+		Exact = 2
+	};
 }
 
@@ -0,0 +1,786 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+// AVX2 + FMA kernels, these are only called when Dispatch.cpp detected support for them.
+// This file is always compiled with /arch:AVX2 (see MMath.vcxproj), even if the rest of the library targets older CPUs.
+
+#include "Dispatch.h"
+#include "SIMD.h"
+#include <float.h>
+
+// Two columns of a Mat44Mul at once: rhs01 holds 2 adjacent columns of rhs, p0-p3 hold the lhs columns in both lanes
+__forceinline __m256 _Mat44MulColumnPair(const __m256 p0, const __m256 p1, const __m256 p2, const __m256 p3, const __m256 rhs01)
+{
+	__m256 a = _mm256_mul_ps(p0, _mm256_permute_ps(rhs01, _MM_SHUFFLE(0, 0, 0, 0)));
+	__m256 b = _mm256_mul_ps(p1, _mm256_permute_ps(rhs01, _MM_SHUFFLE(1, 1, 1, 1)));
+	a = _mm256_fmadd_ps(p2, _mm256_permute_ps(rhs01, _MM_SHUFFLE(2, 2, 2, 2)), a);
+	b = _mm256_fmadd_ps(p3, _mm256_permute_ps(rhs01, _MM_SHUFFLE(3, 3, 3, 3)), b);
+	return _mm256_add_ps(a, b);
+}
+
+Mat44 _Mat44MulFMA(const Mat44 rhs, const Mat44 lhs)
+{
+	__m256 p0 = _mm256_broadcast_ps(&lhs.col0);
+	__m256 p1 = _mm256_broadcast_ps(&lhs.col1);
+	__m256 p2 = _mm256_broadcast_ps(&lhs.col2);
+	__m256 p3 = _mm256_broadcast_ps(&lhs.col3);
+	Mat44 m;
+	_mm256_storeu_ps(&m.m[0], _Mat44MulColumnPair(p0, p1, p2, p3, _mm256_loadu_ps(&rhs.m[0])));
+	_mm256_storeu_ps(&m.m[8], _Mat44MulColumnPair(p0, p1, p2, p3, _mm256_loadu_ps(&rhs.m[8])));
+	return m;
+}
+
+Vec _Mat44VectorTransformFMA(const Mat44 m, const __m128 v)
+{
+	// two short chains instead of one long one
+	__m128 a = _mm_fmadd_ps(m.col0, _mm_swizzle_ps_0(v), _mm_mul_ps(m.col1, _mm_swizzle_ps_1(v)));
+	__m128 b = _mm_fmadd_ps(m.col2, _mm_swizzle_ps_2(v), _mm_mul_ps(m.col3, _mm_swizzle_ps_3(v)));
+	return { _mm_add_ps(a, b) };
+}
+
+// How many matrices ahead of the current one we ask the cache for
+static const unsigned int MAT44_PREFETCH_DISTANCE_AVX = 16;
+
+void _Mat44MulArrayFMA(const Mat44* children, const Mat44* parents, Mat44* result, const unsigned int count)
+{
+	// Same structure as the SSE version, but every __m256 holds 2 columns so a pair of products is 4 independent chains.
+	unsigned int i = 0;
+	for (; i + 1 < count; i += 2)
+	{
+		_mm_prefetch((const char*)&children[i + MAT44_PREFETCH_DISTANCE_AVX], _MM_HINT_T0);
+		_mm_prefetch((const char*)&parents[i + MAT44_PREFETCH_DISTANCE_AVX], _MM_HINT_T0);
+
+		const float* c0 = children[i].m;
+		const float* c1 = children[i + 1].m;
+		const Mat44& p0 = parents[i];
+		const Mat44& p1 = parents[i + 1];
+
+		__m256 a01 = _Mat44MulColumnPair(_mm256_broadcast_ps(&p0.col0), _mm256_broadcast_ps(&p0.col1), _mm256_broadcast_ps(&p0.col2), _mm256_broadcast_ps(&p0.col3), _mm256_loadu_ps(c0));
+		__m256 a23 = _Mat44MulColumnPair(_mm256_broadcast_ps(&p0.col0), _mm256_broadcast_ps(&p0.col1), _mm256_broadcast_ps(&p0.col2), _mm256_broadcast_ps(&p0.col3), _mm256_loadu_ps(c0 + 8));
+		__m256 b01 = _Mat44MulColumnPair(_mm256_broadcast_ps(&p1.col0), _mm256_broadcast_ps(&p1.col1), _mm256_broadcast_ps(&p1.col2), _mm256_broadcast_ps(&p1.col3), _mm256_loadu_ps(c1));
+		__m256 b23 = _Mat44MulColumnPair(_mm256_broadcast_ps(&p1.col0), _mm256_broadcast_ps(&p1.col1), _mm256_broadcast_ps(&p1.col2), _mm256_broadcast_ps(&p1.col3), _mm256_loadu_ps(c1 + 8));
+
+		_mm256_storeu_ps(result[i].m, a01);
+		_mm256_storeu_ps(result[i].m + 8, a23);
+		_mm256_storeu_ps(result[i + 1].m, b01);
+		_mm256_storeu_ps(result[i + 1].m + 8, b23);
+	}
+	if (i < count)
+	{
+		// odd tail
+		result[i] = _Mat44MulFMA(children[i], parents[i]);
+	}
+}
+
+Quat _QuatMulFMA(const Quat lhs, const Quat rhs)
+{
+	// Same terms as _QuatMulSSE, the sign flips are exact so they can be applied to lhs before fusing
+	__m128 x = _mm_mul_ps(F32_SIGNFLIP_0101, _mm_swizzle_ps_3210(lhs.q));
+	__m128 y = _mm_mul_ps(F32_SIGNFLIP_0011, _mm_swizzle_ps_2301(lhs.q));
+	__m128 z = _mm_mul_ps(F32_SIGNFLIP_1001, _mm_swizzle_ps_1032(lhs.q));
+	__m128 a = _mm_fmadd_ps(x, _mm_swizzle_ps_0(rhs.q), _mm_mul_ps(y, _mm_swizzle_ps_1(rhs.q)));
+	__m128 b = _mm_fmadd_ps(z, _mm_swizzle_ps_2(rhs.q), _mm_mul_ps(lhs.q, _mm_swizzle_ps_3(rhs.q)));
+	return { _mm_add_ps(a, b) };
+}
+
+Mat44 _QuatToMat44FMA(const Quat q)
+{
+	__m128 sqr = _mm_mul_ps(q.q, q.q);
+	__m128 wq = _mm_mul_ps(_mm_swizzle_ps_3(q.q), q.q);
+	__m128 alt = _mm_mul_ps(_mm_swizzle_ps_1203(q.q), q.q);
+
+	__m128 dot = _mm_hadd_ps(sqr, sqr);
+	dot = _mm_hadd_ps(dot, dot);
+	__m128 s = _mm_div_ps(_mm_set_ps1(2.0f), dot);
+
+	// s * (xy + wz), s * (xy - wz), s * (zx + wy), s * (zx - wy)
+	__m128 a = _mm_mul_ps(s, _mm_fmadd_ps(F32_SIGNFLIP_0101, _mm_swizzle_ps_2211(wq), _mm_swizzle_ps_0022(alt)));
+	// s * (yz + wx), s * (yz - wx)
+	__m128 b = _mm_mul_ps(s, _mm_fmadd_ps(F32_SIGNFLIP_0101, _mm_swizzle_ps_0(wq), _mm_swizzle_ps_1(alt)));
+	// 1.0 - s * (yy + zz), 1.0 - s * (xx + zz), 1.0 - s * (xx + yy)
+	__m128 c = _mm_fnmadd_ps(s, _mm_add_ps(_mm_swizzle_ps_1000(sqr), _mm_swizzle_ps_2211(sqr)), F32_ONE);
+
+	// Assemble the columns with shuffles instead of going through memory
+	Mat44 m;
+	m.col0 = _mm_blend_ps(_mm_permute_ps(_mm_shuffle_ps(c, a, _MM_SHUFFLE(3, 0, 0, 0)), _MM_SHUFFLE(3, 3, 2, 0)), F32_ZERO, 0b1000); // c0 a0 a3 0
+	m.col1 = _mm_blend_ps(_mm_shuffle_ps(_mm_shuffle_ps(a, c, _MM_SHUFFLE(1, 1, 1, 1)), b, _MM_SHUFFLE(0, 0, 2, 0)), F32_ZERO, 0b1000); // a1 c1 b0 0
+	m.col2 = _mm_blend_ps(_mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(2, 2, 2, 0)), F32_ZERO, 0b1000); // a2 b1 c2 0
+	m.col3 = F32_UNIT_W;
+	return m;
+}
+
+// Vec3Stream kernels, 16 points per iteration as streams are padded to a multiple of 16.
+// Float results have no padding, so the last block is written with a mask.
+__forceinline void _StreamStore16(float* dst, const unsigned int i, const unsigned int count, const __m256 a, const __m256 b)
+{
+	if (i + 16 <= count)
+	{
+		_mm256_storeu_ps(dst + i, a);
+		_mm256_storeu_ps(dst + i + 8, b);
+		return;
+	}
+	const __m256i remaining = _mm256_set1_epi32((int)(count - i));
+	_mm256_maskstore_ps(dst + i, _mm256_cmpgt_epi32(remaining, _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)), a);
+	_mm256_maskstore_ps(dst + i + 8, _mm256_cmpgt_epi32(remaining, _mm256_setr_epi32(8, 9, 10, 11, 12, 13, 14, 15)), b);
+}
+
+__forceinline __m256 _Dot8(const __m256 ax, const __m256 ay, const __m256 az, const __m256 bx, const __m256 by, const __m256 bz)
+{
+	return _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx)));
+}
+
+void _Vec3StreamDotFMA(const Vec3Stream* a, const Vec3Stream* b, float* result)
+{
+	const unsigned int count = a->count;
+	for (unsigned int i = 0; i < count; i += 16)
+	{
+		__m256 d0 = _Dot8(_mm256_load_ps(a->x + i), _mm256_load_ps(a->y + i), _mm256_load_ps(a->z + i),
+			_mm256_load_ps(b->x + i), _mm256_load_ps(b->y + i), _mm256_load_ps(b->z + i));
+		__m256 d1 = _Dot8(_mm256_load_ps(a->x + i + 8), _mm256_load_ps(a->y + i + 8), _mm256_load_ps(a->z + i + 8),
+			_mm256_load_ps(b->x + i + 8), _mm256_load_ps(b->y + i + 8), _mm256_load_ps(b->z + i + 8));
+		_StreamStore16(result, i, count, d0, d1);
+	}
+}
+
+void _Vec3StreamCrossFMA(const Vec3Stream* a, const Vec3Stream* b, Vec3Stream* result)
+{
+	const unsigned int count = a->count;
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		__m256 ax = _mm256_load_ps(a->x + i), ay = _mm256_load_ps(a->y + i), az = _mm256_load_ps(a->z + i);
+		__m256 bx = _mm256_load_ps(b->x + i), by = _mm256_load_ps(b->y + i), bz = _mm256_load_ps(b->z + i);
+		_mm256_store_ps(result->x + i, _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by)));
+		_mm256_store_ps(result->y + i, _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz)));
+		_mm256_store_ps(result->z + i, _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx)));
+	}
+	result->count = count;
+}
+
+void _Vec3StreamMagnitudeFMA(const Vec3Stream* v, float* result)
+{
+	const unsigned int count = v->count;
+	for (unsigned int i = 0; i < count; i += 16)
+	{
+		__m256 x0 = _mm256_load_ps(v->x + i), y0 = _mm256_load_ps(v->y + i), z0 = _mm256_load_ps(v->z + i);
+		__m256 x1 = _mm256_load_ps(v->x + i + 8), y1 = _mm256_load_ps(v->y + i + 8), z1 = _mm256_load_ps(v->z + i + 8);
+		_StreamStore16(result, i, count, _mm256_sqrt_ps(_Dot8(x0, y0, z0, x0, y0, z0)), _mm256_sqrt_ps(_Dot8(x1, y1, z1, x1, y1, z1)));
+	}
+}
+
+// _mm_mul_rsqrt_ps for 8 lanes with the Newton-Raphson step fused
+template<ENormalizeMode MODE>
+__forceinline __m256 _mm256_mul_rsqrt_ps(__m256 v, __m256 sqr)
+{
+	if (MODE == ENormalizeMode::Exact)
+		return _mm256_div_ps(v, _mm256_sqrt_ps(sqr));
+	__m256 y = _mm256_rsqrt_ps(sqr);
+	if (MODE == ENormalizeMode::Refined)
+		y = _mm256_mul_ps(y, _mm256_fnmadd_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), sqr), y), y, _mm256_set1_ps(1.5f)));
+	return _mm256_mul_ps(v, y);
+}
+
+template<ENormalizeMode MODE>
+void _Vec3StreamNormalizedFMA(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result)
+{
+	const unsigned int count = v->count;
+	const __m256 fx = _mm256_set1_ps(fallback.m128_f32[0]), fy = _mm256_set1_ps(fallback.m128_f32[1]), fz = _mm256_set1_ps(fallback.m128_f32[2]);
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		__m256 x = _mm256_load_ps(v->x + i), y = _mm256_load_ps(v->y + i), z = _mm256_load_ps(v->z + i);
+		__m256 sqr = _Dot8(x, y, z, x, y, z);
+		__m256 isZero = _mm256_cmp_ps(sqr, _mm256_setzero_ps(), _CMP_EQ_OQ);
+		_mm256_store_ps(result->x + i, _mm256_blendv_ps(_mm256_mul_rsqrt_ps<MODE>(x, sqr), fx, isZero));
+		_mm256_store_ps(result->y + i, _mm256_blendv_ps(_mm256_mul_rsqrt_ps<MODE>(y, sqr), fy, isZero));
+		_mm256_store_ps(result->z + i, _mm256_blendv_ps(_mm256_mul_rsqrt_ps<MODE>(z, sqr), fz, isZero));
+	}
+	result->count = count;
+}
+
+void _Vec3StreamNormalizedFMA(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result, const ENormalizeMode mode)
+{
+	switch (mode)
+	{
+	case ENormalizeMode::Fast:
+		_Vec3StreamNormalizedFMA<ENormalizeMode::Fast>(v, fallback, result);
+		break;
+	case ENormalizeMode::Refined:
+		_Vec3StreamNormalizedFMA<ENormalizeMode::Refined>(v, fallback, result);
+		break;
+	default:
+		_Vec3StreamNormalizedFMA<ENormalizeMode::Exact>(v, fallback, result);
+		break;
+	}
+}
+
+void _Vec3StreamPerpendicularFMA(const Vec3Stream* v, Vec3Stream* result)
+{
+	const unsigned int count = v->count;
+	const __m256 sign = _mm256_set1_ps(-0.0f);
+	const __m256 one = _mm256_set1_ps(1.0f);
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		__m256 x = _mm256_load_ps(v->x + i), y = _mm256_load_ps(v->y + i), z = _mm256_load_ps(v->z + i);
+		__m256 crossZ = _mm256_cmp_ps(_mm256_andnot_ps(sign, x), _mm256_andnot_ps(sign, z), _CMP_GT_OQ);
+		__m256 px = _mm256_and_ps(crossZ, _mm256_xor_ps(y, sign));
+		__m256 py = _mm256_blendv_ps(_mm256_xor_ps(z, sign), x, crossZ);
+		__m256 pz = _mm256_andnot_ps(crossZ, y);
+		__m256 sqr = _Dot8(px, py, pz, px, py, pz);
+		__m256 isZero = _mm256_cmp_ps(sqr, _mm256_setzero_ps(), _CMP_EQ_OQ);
+		__m256 inv = _mm256_rsqrt_ps(sqr);
+		_mm256_store_ps(result->x + i, _mm256_blendv_ps(_mm256_mul_ps(px, inv), one, isZero));
+		_mm256_store_ps(result->y + i, _mm256_andnot_ps(isZero, _mm256_mul_ps(py, inv)));
+		_mm256_store_ps(result->z + i, _mm256_andnot_ps(isZero, _mm256_mul_ps(pz, inv)));
+	}
+	result->count = count;
+}
+
+void _Vec3StreamLerpFMA(const Vec3Stream* a, const Vec3Stream* b, const float t, Vec3Stream* result)
+{
+	const unsigned int count = a->count;
+	const __m256 vt = _mm256_set1_ps(t);
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		__m256 ax = _mm256_load_ps(a->x + i), ay = _mm256_load_ps(a->y + i), az = _mm256_load_ps(a->z + i);
+		_mm256_store_ps(result->x + i, _mm256_fmadd_ps(_mm256_sub_ps(_mm256_load_ps(b->x + i), ax), vt, ax));
+		_mm256_store_ps(result->y + i, _mm256_fmadd_ps(_mm256_sub_ps(_mm256_load_ps(b->y + i), ay), vt, ay));
+		_mm256_store_ps(result->z + i, _mm256_fmadd_ps(_mm256_sub_ps(_mm256_load_ps(b->z + i), az), vt, az));
+	}
+	result->count = count;
+}
+
+void _Vec3StreamTransformFMA(const Vec3Stream* v, const Mat44 m, const float w, Vec3Stream* result)
+{
+	const unsigned int count = v->count;
+	const __m256 m00 = _mm256_set1_ps(m.m00), m01 = _mm256_set1_ps(m.m01), m02 = _mm256_set1_ps(m.m02);
+	const __m256 m10 = _mm256_set1_ps(m.m10), m11 = _mm256_set1_ps(m.m11), m12 = _mm256_set1_ps(m.m12);
+	const __m256 m20 = _mm256_set1_ps(m.m20), m21 = _mm256_set1_ps(m.m21), m22 = _mm256_set1_ps(m.m22);
+	const __m256 tx = _mm256_set1_ps(m.m30 * w), ty = _mm256_set1_ps(m.m31 * w), tz = _mm256_set1_ps(m.m32 * w);
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		__m256 x = _mm256_load_ps(v->x + i), y = _mm256_load_ps(v->y + i), z = _mm256_load_ps(v->z + i);
+		_mm256_store_ps(result->x + i, _mm256_fmadd_ps(m20, z, _mm256_fmadd_ps(m10, y, _mm256_fmadd_ps(m00, x, tx))));
+		_mm256_store_ps(result->y + i, _mm256_fmadd_ps(m21, z, _mm256_fmadd_ps(m11, y, _mm256_fmadd_ps(m01, x, ty))));
+		_mm256_store_ps(result->z + i, _mm256_fmadd_ps(m22, z, _mm256_fmadd_ps(m12, y, _mm256_fmadd_ps(m02, x, tz))));
+	}
+	result->count = count;
+}
+
+// Same as _SkinLinearBlendRangeSSE, but accumulates two columns per instruction
+template<unsigned int INFLUENCES>
+__forceinline void _SkinLinearBlendRangeFMA(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	const unsigned int influences = INFLUENCES ? INFLUENCES : influencesPerVertex;
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const unsigned int* indices = jointIndices + i * influences;
+		const float* w = weights + i * influences;
+
+		const Mat44& first = palette[indices[0]];
+		__m256 weight = _mm256_set1_ps(w[0]);
+		__m256 col01 = _mm256_mul_ps(_mm256_loadu_ps(first.m), weight);
+		__m256 col23 = _mm256_mul_ps(_mm256_loadu_ps(first.m + 8), weight);
+		for (unsigned int k = 1; k < influences; ++k)
+		{
+			const Mat44& m = palette[indices[k]];
+			weight = _mm256_set1_ps(w[k]);
+			col01 = _mm256_fmadd_ps(_mm256_loadu_ps(m.m), weight, col01);
+			col23 = _mm256_fmadd_ps(_mm256_loadu_ps(m.m + 8), weight, col23);
+		}
+
+		const __m128 p = positions[i].s;
+		__m256 r = _mm256_fmadd_ps(col23, _mm256_set_m128(F32_ONE, _mm_swizzle_ps_2(p)), _mm256_mul_ps(col01, _mm256_set_m128(_mm_swizzle_ps_1(p), _mm_swizzle_ps_0(p))));
+		outPositions[i].s = _mm_add_ps(_mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1));
+
+		if (normals)
+		{
+			const __m128 n = normals[i].s;
+			r = _mm256_fmadd_ps(col23, _mm256_set_m128(F32_ZERO, _mm_swizzle_ps_2(n)), _mm256_mul_ps(col01, _mm256_set_m128(_mm_swizzle_ps_1(n), _mm_swizzle_ps_0(n))));
+			__m128 rn = _mm_add_ps(_mm256_castps256_ps128(r), _mm256_extractf128_ps(r, 1));
+			__m128 sqrLength = _mm_dp_ps(rn, rn, 0x77);
+			outNormals[i].s = _mm_and_ps(_mm_div_ps(rn, _mm_sqrt_ps(sqrLength)), _mm_cmpgt_ps(sqrLength, F32_ZERO));
+		}
+	}
+}
+
+void _SkinLinearBlendFMA(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	switch (influencesPerVertex)
+	{
+	case 4:
+		_SkinLinearBlendRangeFMA<4>(positions, normals, jointIndices, weights, 4, palette, outPositions, outNormals, count);
+		break;
+	case 8:
+		_SkinLinearBlendRangeFMA<8>(positions, normals, jointIndices, weights, 8, palette, outPositions, outNormals, count);
+		break;
+	default:
+		_SkinLinearBlendRangeFMA<0>(positions, normals, jointIndices, weights, influencesPerVertex, palette, outPositions, outNormals, count);
+		break;
+	}
+}
+
+// Same as _SkinDualQuatRangeSSE, but blends real and dual part with a single FMA
+template<unsigned int INFLUENCES>
+__forceinline void _SkinDualQuatRangeFMA(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	const unsigned int influences = INFLUENCES ? INFLUENCES : influencesPerVertex;
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const unsigned int* indices = jointIndices + i * influences;
+		const float* w = weights + i * influences;
+
+		const DualQuat& first = palette[indices[0]];
+		__m256 blended = _mm256_mul_ps(_mm256_loadu_ps(first.real.s), _mm256_set1_ps(w[0]));
+		for (unsigned int k = 1; k < influences; ++k)
+		{
+			const DualQuat& dq = palette[indices[k]];
+			__m128 weight = _mm_xor_ps(_mm_set_ps1(w[k]), _mm_and_ps(_mm_dp_ps(dq.real.q, first.real.q, 0xFF), signMask));
+			blended = _mm256_fmadd_ps(_mm256_loadu_ps(dq.real.s), _mm256_set_m128(weight, weight), blended);
+		}
+
+		__m128 real = _mm256_castps256_ps128(blended);
+		__m128 dual = _mm256_extractf128_ps(blended, 1);
+		const __m128 invLength = _mm_div_ps(F32_ONE, _mm_sqrt_ps(_mm_dp_ps(real, real, 0xFF)));
+		real = _mm_mul_ps(real, invLength);
+		dual = _mm_mul_ps(dual, invLength);
+
+		outPositions[i].s = _DualQuatPointTransform(real, dual, _mm_blend_ps(positions[i].s, F32_ONE, 0b1000));
+		if (normals)
+			outNormals[i].s = _DualQuatVectorTransform(real, _mm_blend_ps(normals[i].s, F32_ZERO, 0b1000));
+	}
+}
+
+void _SkinDualQuatFMA(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	switch (influencesPerVertex)
+	{
+	case 4:
+		_SkinDualQuatRangeFMA<4>(positions, normals, jointIndices, weights, 4, palette, outPositions, outNormals, count);
+		break;
+	case 8:
+		_SkinDualQuatRangeFMA<8>(positions, normals, jointIndices, weights, 8, palette, outPositions, outNormals, count);
+		break;
+	default:
+		_SkinDualQuatRangeFMA<0>(positions, normals, jointIndices, weights, influencesPerVertex, palette, outPositions, outNormals, count);
+		break;
+	}
+}
+
+// 8 wide versions of _mm_sincos_ps and _mm_arccos_ps from SIMD.cpp, same algorithms and constants
+__forceinline void _SinCos8(__m256 x, __m256* s, __m256* c)
+{
+	const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x80000000));
+	__m256 signSin = _mm256_and_ps(x, signMask);
+	x = _mm256_andnot_ps(signMask, x);
+
+	__m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.27323954473516f))); // 4 / PI
+	j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(-2));
+	const __m256 y = _mm256_cvtepi32_ps(j);
+
+	signSin = _mm256_xor_ps(signSin, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29)));
+	const __m256 signCos = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+	const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(2)));
+
+	x = _mm256_fmadd_ps(y, _mm256_set1_ps(-0.78515625f), x);
+	x = _mm256_fmadd_ps(y, _mm256_set1_ps(-2.4187564849853515625e-4f), x);
+	x = _mm256_fmadd_ps(y, _mm256_set1_ps(-3.77489497744594108e-8f), x);
+	const __m256 z = _mm256_mul_ps(x, x);
+
+	__m256 pc = _mm256_fmadd_ps(_mm256_set1_ps(2.443315711809948E-005f), z, _mm256_set1_ps(-1.388731625493765E-003f));
+	pc = _mm256_fmadd_ps(pc, z, _mm256_set1_ps(4.166664568298827E-002f));
+	pc = _mm256_mul_ps(_mm256_mul_ps(pc, z), z);
+	pc = _mm256_add_ps(_mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), pc), _mm256_set1_ps(1.0f));
+
+	__m256 ps = _mm256_fmadd_ps(_mm256_set1_ps(-1.9515295891E-4f), z, _mm256_set1_ps(8.3321608736E-3f));
+	ps = _mm256_fmadd_ps(ps, z, _mm256_set1_ps(-1.6666654611E-1f));
+	ps = _mm256_fmadd_ps(_mm256_mul_ps(ps, z), x, x);
+
+	*s = _mm256_xor_ps(_mm256_blendv_ps(ps, pc, swap), signSin);
+	*c = _mm256_xor_ps(_mm256_blendv_ps(pc, ps, swap), signCos);
+}
+
+__forceinline __m256 _ArcCos8(__m256 x)
+{
+	const __m256 negative = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ);
+	x = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_set1_epi32(0x80000000)), x);
+
+	__m256 p = _mm256_fmadd_ps(_mm256_set1_ps(-0.0012624911f), x, _mm256_set1_ps(0.0066700901f));
+	p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(-0.0170881256f));
+	p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(0.0308918810f));
+	p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(-0.0501743046f));
+	p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(0.0889789874f));
+	p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(-0.2145988016f));
+	p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(1.5707963050f));
+	p = _mm256_mul_ps(p, _mm256_sqrt_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), x), _mm256_setzero_ps())));
+
+	return _mm256_blendv_ps(p, _mm256_sub_ps(_mm256_set1_ps(3.14159265358979323846f), p), negative);
+}
+
+// Same as _QuatBlend4 in Quat.cpp, 8 pairs at a time
+template<bool SLERP, bool CORRECTED>
+__forceinline void _QuatBlend8(__m256& ax, __m256& ay, __m256& az, __m256& aw, __m256 bx, __m256 by, __m256 bz, __m256 bw, __m256 t)
+{
+	const __m256 one = _mm256_set1_ps(1.0f);
+	__m256 d = _mm256_fmadd_ps(aw, bw, _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx))));
+	const __m256 sign = _mm256_and_ps(d, _mm256_castsi256_ps(_mm256_set1_epi32(0x80000000)));
+	d = _mm256_xor_ps(d, sign);
+	bx = _mm256_xor_ps(bx, sign);
+	by = _mm256_xor_ps(by, sign);
+	bz = _mm256_xor_ps(bz, sign);
+	bw = _mm256_xor_ps(bw, sign);
+
+	__m256 wa, wb;
+	if (SLERP)
+	{
+		const __m256 omega = _ArcCos8(d);
+		const __m256 invSinOmega = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_max_ps(_mm256_fnmadd_ps(d, d, one), _mm256_setzero_ps())));
+		__m256 sa, sb, c;
+		_SinCos8(_mm256_mul_ps(omega, _mm256_sub_ps(one, t)), &sa, &c);
+		_SinCos8(_mm256_mul_ps(omega, t), &sb, &c);
+		const __m256 linear = _mm256_cmp_ps(d, _mm256_set1_ps(QUAT_SLERP_LINEAR_THRESHOLD), _CMP_GT_OQ);
+		wa = _mm256_blendv_ps(_mm256_mul_ps(sa, invSinOmega), _mm256_sub_ps(one, t), linear);
+		wb = _mm256_blendv_ps(_mm256_mul_ps(sb, invSinOmega), t, linear);
+	}
+	else
+	{
+		if (CORRECTED)
+		{
+			const __m256 A = _mm256_fmadd_ps(d, _mm256_fmadd_ps(d, _mm256_fnmadd_ps(d, _mm256_set1_ps(1.43519f), _mm256_set1_ps(3.55645f)), _mm256_set1_ps(-3.2452f)), _mm256_set1_ps(1.0904f));
+			const __m256 B = _mm256_fmadd_ps(d, _mm256_fmadd_ps(d, _mm256_set1_ps(0.215638f), _mm256_set1_ps(-1.06021f)), _mm256_set1_ps(0.848013f));
+			const __m256 th = _mm256_sub_ps(t, _mm256_set1_ps(0.5f));
+			const __m256 k = _mm256_fmadd_ps(A, _mm256_mul_ps(th, th), B);
+			t = _mm256_fmadd_ps(_mm256_mul_ps(t, th), _mm256_mul_ps(_mm256_sub_ps(t, one), k), t);
+		}
+		wa = _mm256_sub_ps(one, t);
+		wb = t;
+	}
+
+	ax = _mm256_fmadd_ps(bx, wb, _mm256_mul_ps(ax, wa));
+	ay = _mm256_fmadd_ps(by, wb, _mm256_mul_ps(ay, wa));
+	az = _mm256_fmadd_ps(bz, wb, _mm256_mul_ps(az, wa));
+	aw = _mm256_fmadd_ps(bw, wb, _mm256_mul_ps(aw, wa));
+	const __m256 invLength = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_fmadd_ps(aw, aw, _mm256_fmadd_ps(az, az, _mm256_fmadd_ps(ay, ay, _mm256_mul_ps(ax, ax))))));
+	ax = _mm256_mul_ps(ax, invLength);
+	ay = _mm256_mul_ps(ay, invLength);
+	az = _mm256_mul_ps(az, invLength);
+	aw = _mm256_mul_ps(aw, invLength);
+}
+
+// 4x4 transpose within each 128 bit lane, with r0 = [q0|q4], r1 = [q1|q5] etc. this turns 8 quaternions into SoA x, y, z, w and back
+__forceinline void _Transpose4x2(__m256& r0, __m256& r1, __m256& r2, __m256& r3)
+{
+	const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+	const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+	const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+	const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+	r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+	r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+	r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+__forceinline __m256 _LoadQuatPair(const Quat* q, const unsigned int i)
+{
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(q[i].q), q[i + 4].q, 1);
+}
+
+template<bool SLERP, bool CORRECTED>
+__forceinline void _QuatBlendBlockFMA(const Quat* a, const Quat* b, const float* t, Quat* result)
+{
+	__m256 ax = _LoadQuatPair(a, 0), ay = _LoadQuatPair(a, 1), az = _LoadQuatPair(a, 2), aw = _LoadQuatPair(a, 3);
+	__m256 bx = _LoadQuatPair(b, 0), by = _LoadQuatPair(b, 1), bz = _LoadQuatPair(b, 2), bw = _LoadQuatPair(b, 3);
+	_Transpose4x2(ax, ay, az, aw);
+	_Transpose4x2(bx, by, bz, bw);
+	_QuatBlend8<SLERP, CORRECTED>(ax, ay, az, aw, bx, by, bz, bw, _mm256_loadu_ps(t));
+	_Transpose4x2(ax, ay, az, aw);
+	result[0].q = _mm256_castps256_ps128(ax);
+	result[1].q = _mm256_castps256_ps128(ay);
+	result[2].q = _mm256_castps256_ps128(az);
+	result[3].q = _mm256_castps256_ps128(aw);
+	result[4].q = _mm256_extractf128_ps(ax, 1);
+	result[5].q = _mm256_extractf128_ps(ay, 1);
+	result[6].q = _mm256_extractf128_ps(az, 1);
+	result[7].q = _mm256_extractf128_ps(aw, 1);
+}
+
+template<bool SLERP, bool CORRECTED>
+__forceinline void _QuatBlendArrayFMA(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count)
+{
+	unsigned int i = 0;
+	for (; i + 8 <= count; i += 8)
+		_QuatBlendBlockFMA<SLERP, CORRECTED>(a + i, b + i, t + i, result + i);
+	if (i < count)
+	{
+		Quat pa[8], pb[8];
+		float pt[8];
+		for (unsigned int j = 0; j < 8; ++j)
+		{
+			pa[j].q = pb[j].q = F32_UNIT_W;
+			pt[j] = 0.0f;
+		}
+		for (unsigned int j = 0; j < count - i; ++j)
+		{
+			pa[j] = a[i + j];
+			pb[j] = b[i + j];
+			pt[j] = t[i + j];
+		}
+		_QuatBlendBlockFMA<SLERP, CORRECTED>(pa, pb, pt, pa);
+		for (unsigned int j = 0; j < count - i; ++j)
+			result[i + j] = pa[j];
+	}
+}
+
+void _QuatSlerpArrayFMA(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count)
+{
+	_QuatBlendArrayFMA<true, false>(a, b, t, result, count);
+}
+
+void _QuatNlerpArrayFMA(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count, const bool corrected)
+{
+	if (corrected)
+		_QuatBlendArrayFMA<false, true>(a, b, t, result, count);
+	else
+		_QuatBlendArrayFMA<false, false>(a, b, t, result, count);
+}
+
+// Same as _Mat44Inverse4 in Mat44.cpp, 8 matrices at a time
+__forceinline __m256 _Mat44Inverse8(__m256 a[16], const __m256 epsilonSqr, __m256& valid)
+{
+	const __m256 s0 = _mm256_fmsub_ps(a[0], a[5], _mm256_mul_ps(a[4], a[1]));
+	const __m256 s1 = _mm256_fmsub_ps(a[0], a[6], _mm256_mul_ps(a[4], a[2]));
+	const __m256 s2 = _mm256_fmsub_ps(a[0], a[7], _mm256_mul_ps(a[4], a[3]));
+	const __m256 s3 = _mm256_fmsub_ps(a[1], a[6], _mm256_mul_ps(a[5], a[2]));
+	const __m256 s4 = _mm256_fmsub_ps(a[1], a[7], _mm256_mul_ps(a[5], a[3]));
+	const __m256 s5 = _mm256_fmsub_ps(a[2], a[7], _mm256_mul_ps(a[6], a[3]));
+	const __m256 c0 = _mm256_fmsub_ps(a[8], a[13], _mm256_mul_ps(a[12], a[9]));
+	const __m256 c1 = _mm256_fmsub_ps(a[8], a[14], _mm256_mul_ps(a[12], a[10]));
+	const __m256 c2 = _mm256_fmsub_ps(a[8], a[15], _mm256_mul_ps(a[12], a[11]));
+	const __m256 c3 = _mm256_fmsub_ps(a[9], a[14], _mm256_mul_ps(a[13], a[10]));
+	const __m256 c4 = _mm256_fmsub_ps(a[9], a[15], _mm256_mul_ps(a[13], a[11]));
+	const __m256 c5 = _mm256_fmsub_ps(a[10], a[15], _mm256_mul_ps(a[14], a[11]));
+
+	const __m256 det = _mm256_add_ps(_mm256_fmadd_ps(s2, c3, _mm256_fmsub_ps(s0, c5, _mm256_mul_ps(s1, c4))),
+		_mm256_fmadd_ps(s3, c2, _mm256_fmsub_ps(s5, c0, _mm256_mul_ps(s4, c1))));
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 invDet = _mm256_div_ps(one, det);
+	const __m256 negInvDet = _mm256_xor_ps(invDet, _mm256_set1_ps(-0.0f));
+
+	// x * p - y * q + z * r
+	auto cofactor = [](const __m256 x, const __m256 p, const __m256 y, const __m256 q, const __m256 z, const __m256 r)
+	{
+		return _mm256_fmadd_ps(z, r, _mm256_fmsub_ps(x, p, _mm256_mul_ps(y, q)));
+	};
+	__m256 b[16];
+	b[0] = _mm256_mul_ps(cofactor(a[5], c5, a[6], c4, a[7], c3), invDet);
+	b[1] = _mm256_mul_ps(cofactor(a[1], c5, a[2], c4, a[3], c3), negInvDet);
+	b[2] = _mm256_mul_ps(cofactor(a[13], s5, a[14], s4, a[15], s3), invDet);
+	b[3] = _mm256_mul_ps(cofactor(a[9], s5, a[10], s4, a[11], s3), negInvDet);
+	b[4] = _mm256_mul_ps(cofactor(a[4], c5, a[6], c2, a[7], c1), negInvDet);
+	b[5] = _mm256_mul_ps(cofactor(a[0], c5, a[2], c2, a[3], c1), invDet);
+	b[6] = _mm256_mul_ps(cofactor(a[12], s5, a[14], s2, a[15], s1), negInvDet);
+	b[7] = _mm256_mul_ps(cofactor(a[8], s5, a[10], s2, a[11], s1), invDet);
+	b[8] = _mm256_mul_ps(cofactor(a[4], c4, a[5], c2, a[7], c0), invDet);
+	b[9] = _mm256_mul_ps(cofactor(a[0], c4, a[1], c2, a[3], c0), negInvDet);
+	b[10] = _mm256_mul_ps(cofactor(a[12], s4, a[13], s2, a[15], s0), invDet);
+	b[11] = _mm256_mul_ps(cofactor(a[8], s4, a[9], s2, a[11], s0), negInvDet);
+	b[12] = _mm256_mul_ps(cofactor(a[4], c3, a[5], c1, a[6], c0), negInvDet);
+	b[13] = _mm256_mul_ps(cofactor(a[0], c3, a[1], c1, a[2], c0), invDet);
+	b[14] = _mm256_mul_ps(cofactor(a[12], s3, a[13], s1, a[14], s0), negInvDet);
+	b[15] = _mm256_mul_ps(cofactor(a[8], s3, a[9], s1, a[10], s0), invDet);
+
+	__m256 sumA = _mm256_setzero_ps(), sumB = _mm256_setzero_ps();
+	for (int k = 0; k < 16; ++k)
+	{
+		sumA = _mm256_fmadd_ps(a[k], a[k], sumA);
+		sumB = _mm256_fmadd_ps(b[k], b[k], sumB);
+	}
+	const __m256 absDet = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), det);
+	valid = _mm256_and_ps(_mm256_cmp_ps(_mm256_mul_ps(_mm256_mul_ps(epsilonSqr, sumA), sumB), one, _CMP_LE_OQ),
+		_mm256_cmp_ps(absDet, _mm256_set1_ps(FLT_MAX), _CMP_LE_OQ));
+	for (int k = 0; k < 16; ++k)
+		a[k] = _mm256_and_ps(b[k], valid);
+	return det;
+}
+
+__forceinline void _Mat44InversedCheckedBlockFMA(const Mat44* matrices, const __m256 epsilonSqr, Mat44* result, float* determinants, unsigned char* singular)
+{
+	// Same pairing as the quaternion blocks: lane 0 holds matrices 0-3, lane 1 matrices 4-7
+	__m256 a[16], valid;
+	for (int c = 0; c < 4; ++c)
+	{
+		for (int j = 0; j < 4; ++j)
+			a[c * 4 + j] = _mm256_insertf128_ps(_mm256_castps128_ps256(matrices[j].cols[c]), matrices[j + 4].cols[c], 1);
+		_Transpose4x2(a[c * 4 + 0], a[c * 4 + 1], a[c * 4 + 2], a[c * 4 + 3]);
+	}
+	_mm256_storeu_ps(determinants, _Mat44Inverse8(a, epsilonSqr, valid));
+	for (int c = 0; c < 4; ++c)
+	{
+		_Transpose4x2(a[c * 4 + 0], a[c * 4 + 1], a[c * 4 + 2], a[c * 4 + 3]);
+		for (int j = 0; j < 4; ++j)
+		{
+			result[j].cols[c] = _mm256_castps256_ps128(a[c * 4 + j]);
+			result[j + 4].cols[c] = _mm256_extractf128_ps(a[c * 4 + j], 1);
+		}
+	}
+	*singular = (unsigned char)~_mm256_movemask_ps(valid);
+}
+
+void _Mat44InversedCheckedArrayFMA(const Mat44* matrices, const float epsilon, Mat44* result, float* determinants, unsigned char* singular, const unsigned int count)
+{
+	const __m256 epsilonSqr = _mm256_set1_ps(epsilon * epsilon);
+	unsigned int i = 0;
+	for (; i + 8 <= count; i += 8)
+		_Mat44InversedCheckedBlockFMA(matrices + i, epsilonSqr, result + i, determinants + i, singular + i / 8);
+	if (i < count)
+	{
+		Mat44 pm[8];
+		float pd[8];
+		for (unsigned int j = 0; j < 8; ++j)
+			pm[j] = j < count - i ? matrices[i + j] : Mat44Identity();
+		_Mat44InversedCheckedBlockFMA(pm, epsilonSqr, pm, pd, singular + i / 8);
+		for (unsigned int j = 0; j < count - i; ++j)
+		{
+			result[i + j] = pm[j];
+			determinants[i + j] = pd[j];
+		}
+	}
+}
+
+// Same as the SSE culling kernels with all 8 objects of a mask byte in one register
+struct _CullPlanesFMA
+{
+	__m256 x[6], y[6], z[6], w[6];
+};
+
+__forceinline _CullPlanesFMA _CullBroadcastFMA(const Frustum& frustum, const bool absolute)
+{
+	_CullPlanesFMA planes;
+	for (unsigned int p = 0; p < 6; ++p)
+	{
+		__m128 plane = frustum.planes[p];
+		if (absolute)
+			plane = _mm_andnot_ps(_mm_set_ps1(-0.0f), plane);
+		planes.x[p] = _mm256_broadcastss_ps(plane);
+		planes.y[p] = _mm256_broadcastss_ps(_mm_swizzle_ps_1(plane));
+		planes.z[p] = _mm256_broadcastss_ps(_mm_swizzle_ps_2(plane));
+		planes.w[p] = _mm256_broadcastss_ps(_mm_swizzle_ps_3(plane));
+	}
+	return planes;
+}
+
+unsigned int _FrustumCullSpheresFMA(const Frustum frustum, const Vec3Stream* centers, const float* radii, unsigned char* visible, unsigned int* visibleIndices)
+{
+	const _CullPlanesFMA planes = _CullBroadcastFMA(frustum, false);
+	const unsigned int count = centers->count;
+	unsigned int visibleCount = 0;
+	float tail[8];
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		const __m256 x = _mm256_load_ps(centers->x + i), y = _mm256_load_ps(centers->y + i), z = _mm256_load_ps(centers->z + i);
+		const __m256 radius = _mm256_loadu_ps(_CullRadii(radii, i, count, tail));
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (unsigned int p = 0; p < 6; ++p)
+		{
+			__m256 distance = _mm256_fmadd_ps(planes.x[p], x, _mm256_fmadd_ps(planes.y[p], y, _mm256_fmadd_ps(planes.z[p], z, planes.w[p])));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+		visibleCount = _CullStore8(_mm256_movemask_ps(inside), i, count, visible, visibleIndices, visibleCount);
+	}
+	return visibleCount;
+}
+
+unsigned int _FrustumCullBoxesFMA(const Frustum frustum, const Vec3Stream* centers, const Vec3Stream* extents, unsigned char* visible, unsigned int* visibleIndices)
+{
+	const _CullPlanesFMA planes = _CullBroadcastFMA(frustum, false);
+	const _CullPlanesFMA absolute = _CullBroadcastFMA(frustum, true);
+	const unsigned int count = centers->count;
+	unsigned int visibleCount = 0;
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		const __m256 x = _mm256_load_ps(centers->x + i), y = _mm256_load_ps(centers->y + i), z = _mm256_load_ps(centers->z + i);
+		const __m256 ex = _mm256_load_ps(extents->x + i), ey = _mm256_load_ps(extents->y + i), ez = _mm256_load_ps(extents->z + i);
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (unsigned int p = 0; p < 6; ++p)
+		{
+			__m256 distance = _mm256_fmadd_ps(planes.x[p], x, _mm256_fmadd_ps(planes.y[p], y, _mm256_fmadd_ps(planes.z[p], z, planes.w[p])));
+			distance = _mm256_fmadd_ps(absolute.x[p], ex, _mm256_fmadd_ps(absolute.y[p], ey, _mm256_fmadd_ps(absolute.z[p], ez, distance)));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+		visibleCount = _CullStore8(_mm256_movemask_ps(inside), i, count, visible, visibleIndices, visibleCount);
+	}
+	return visibleCount;
+}
+
+// Same as the SSE ray kernels with the whole packet in one register
+unsigned int _RayPacket8IntersectTrianglesFMA(const RayPacket8* rays, const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2, RayHit8* hits)
+{
+	const __m256 ox = _mm256_load_ps(rays->originX), oy = _mm256_load_ps(rays->originY), oz = _mm256_load_ps(rays->originZ);
+	const __m256 dx = _mm256_load_ps(rays->directionX), dy = _mm256_load_ps(rays->directionY), dz = _mm256_load_ps(rays->directionZ);
+	__m256 bestT = _mm256_load_ps(hits->t);
+	__m256 bestU = _mm256_load_ps(hits->u);
+	__m256 bestV = _mm256_load_ps(hits->v);
+	__m256 bestIndex = _mm256_load_ps((const float*)hits->index);
+	__m256 any = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	for (unsigned int i = 0; i < v0->count; ++i)
+	{
+		const __m256 ax = _mm256_broadcast_ss(v0->x + i), ay = _mm256_broadcast_ss(v0->y + i), az = _mm256_broadcast_ss(v0->z + i);
+		const __m256 e1x = _mm256_sub_ps(_mm256_broadcast_ss(v1->x + i), ax);
+		const __m256 e1y = _mm256_sub_ps(_mm256_broadcast_ss(v1->y + i), ay);
+		const __m256 e1z = _mm256_sub_ps(_mm256_broadcast_ss(v1->z + i), az);
+		const __m256 e2x = _mm256_sub_ps(_mm256_broadcast_ss(v2->x + i), ax);
+		const __m256 e2y = _mm256_sub_ps(_mm256_broadcast_ss(v2->y + i), ay);
+		const __m256 e2z = _mm256_sub_ps(_mm256_broadcast_ss(v2->z + i), az);
+		const __m256 px = _mm256_fmsub_ps(dy, e2z, _mm256_mul_ps(dz, e2y));
+		const __m256 py = _mm256_fmsub_ps(dz, e2x, _mm256_mul_ps(dx, e2z));
+		const __m256 pz = _mm256_fmsub_ps(dx, e2y, _mm256_mul_ps(dy, e2x));
+		const __m256 invDet = _mm256_div_ps(one, _mm256_fmadd_ps(e1x, px, _mm256_fmadd_ps(e1y, py, _mm256_mul_ps(e1z, pz))));
+		const __m256 sx = _mm256_sub_ps(ox, ax), sy = _mm256_sub_ps(oy, ay), sz = _mm256_sub_ps(oz, az);
+		const __m256 u = _mm256_mul_ps(_mm256_fmadd_ps(sx, px, _mm256_fmadd_ps(sy, py, _mm256_mul_ps(sz, pz))), invDet);
+		const __m256 qx = _mm256_fmsub_ps(sy, e1z, _mm256_mul_ps(sz, e1y));
+		const __m256 qy = _mm256_fmsub_ps(sz, e1x, _mm256_mul_ps(sx, e1z));
+		const __m256 qz = _mm256_fmsub_ps(sx, e1y, _mm256_mul_ps(sy, e1x));
+		const __m256 v = _mm256_mul_ps(_mm256_fmadd_ps(dx, qx, _mm256_fmadd_ps(dy, qy, _mm256_mul_ps(dz, qz))), invDet);
+		const __m256 t = _mm256_mul_ps(_mm256_fmadd_ps(e2x, qx, _mm256_fmadd_ps(e2y, qy, _mm256_mul_ps(e2z, qz))), invDet);
+		__m256 hit = _mm256_and_ps(_mm256_cmp_ps(u, _mm256_setzero_ps(), _CMP_GE_OQ), _mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_GT_OQ), _mm256_cmp_ps(t, bestT, _CMP_LT_OQ)));
+		bestT = _mm256_blendv_ps(bestT, t, hit);
+		bestU = _mm256_blendv_ps(bestU, u, hit);
+		bestV = _mm256_blendv_ps(bestV, v, hit);
+		bestIndex = _mm256_blendv_ps(bestIndex, _mm256_castsi256_ps(_mm256_set1_epi32((int)i)), hit);
+		any = _mm256_or_ps(any, hit);
+	}
+	_mm256_store_ps(hits->t, bestT);
+	_mm256_store_ps(hits->u, bestU);
+	_mm256_store_ps(hits->v, bestV);
+	_mm256_store_ps((float*)hits->index, bestIndex);
+	return (unsigned int)_mm256_movemask_ps(any);
+}
+
+unsigned int _RayPacket8IntersectBoxFMA(const RayPacket8* rays, const __m128 boxMin, const __m128 boxMax, const RayHit8* hits, float* tNear)
+{
+	const __m256 ox = _mm256_load_ps(rays->originX), oy = _mm256_load_ps(rays->originY), oz = _mm256_load_ps(rays->originZ);
+	const __m256 ix = _mm256_load_ps(rays->inverseDirectionX), iy = _mm256_load_ps(rays->inverseDirectionY), iz = _mm256_load_ps(rays->inverseDirectionZ);
+	const __m256 x0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_broadcastss_ps(boxMin), ox), ix);
+	const __m256 x1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_broadcastss_ps(boxMax), ox), ix);
+	const __m256 y0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_broadcastss_ps(_mm_swizzle_ps_1(boxMin)), oy), iy);
+	const __m256 y1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_broadcastss_ps(_mm_swizzle_ps_1(boxMax)), oy), iy);
+	const __m256 z0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_broadcastss_ps(_mm_swizzle_ps_2(boxMin)), oz), iz);
+	const __m256 z1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_broadcastss_ps(_mm_swizzle_ps_2(boxMax)), oz), iz);
+	const __m256 enter = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(x0, x1), _mm256_min_ps(y0, y1)), _mm256_max_ps(_mm256_min_ps(z0, z1), _mm256_setzero_ps()));
+	const __m256 leave = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(x0, x1), _mm256_max_ps(y0, y1)), _mm256_max_ps(z0, z1));
+	const __m256 hit = _mm256_and_ps(_mm256_cmp_ps(enter, leave, _CMP_LE_OQ), _mm256_cmp_ps(enter, _mm256_load_ps(hits->t), _CMP_LT_OQ));
+	if (tNear)
+		_mm256_storeu_ps(tNear, enter);
+	return (unsigned int)_mm256_movemask_ps(hit);
+}
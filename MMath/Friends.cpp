@@ -18,94 +18,129 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Friends.h"
 #include "Enums.h"
 #include "SIMD.h"
+#include "Dispatch.h"
 #include <math.h>
 
-extern "C"
+Mat44 _QuatToMat44SSE(const Quat q)
 {
-	DLL Mat44 QuatToMat44(const Quat q)
-	{
-		Mat44 m;
+	Mat44 m;
 #if 1
-		__m128 sqr = _mm_mul_ps(q.q, q.q);
-		__m128 wq = _mm_mul_ps(_mm_swizzle_ps_3(q.q), q.q);
-		__m128 alt = _mm_mul_ps(_mm_swizzle_ps_1203(q.q), q.q);
-
-		__m128 dot = _mm_hadd_ps(sqr, sqr);
-		dot = _mm_hadd_ps(dot, dot);
-		__m128 s = _mm_div_ps(_mm_set_ps1(2.0f), dot);
-
-		sqr = _mm_neg_ps(sqr);
-
-		// s * (xy + wz)
-		// s * (xy - wz)
-		// s * (zx + wy)
-		// s * (zx - wy)
-		__m128 a = _mm_mul_ps(s, _mm_add_ps(_mm_swizzle_ps_0022(alt), _mm_mul_ps(F32_SIGNFLIP_0101, _mm_swizzle_ps_2211(wq))));
-		// s * (yz + wx)
-		// s * (yz - wx)
-		__m128 b = _mm_mul_ps(s, _mm_add_ps(_mm_swizzle_ps_1(alt), _mm_mul_ps(F32_SIGNFLIP_0101, _mm_swizzle_ps_0(wq))));
-		// 1.0 - s * (yy + zz)
-		// 1.0 - s * (xx + zz)
-		// 1.0 - s * (xx + yy)
-		__m128 c = _mm_add_ps(F32_ONE, _mm_mul_ps(s, _mm_add_ps(_mm_swizzle_ps_1000(sqr), _mm_swizzle_ps_2211(sqr))));
-
-		// TODO: I could not really condense this down properly, needs a do-over
-		m.col0 = _mm_set_ps(0.0f, a.m128_f32[3], a.m128_f32[0], c.m128_f32[0]);
-		m.col1 = _mm_set_ps(0.0f, b.m128_f32[0], c.m128_f32[1], a.m128_f32[1]);
-		m.col2 = _mm_set_ps(0.0f, c.m128_f32[2], b.m128_f32[1], a.m128_f32[2]);
+	__m128 sqr = _mm_mul_ps(q.q, q.q);
+	__m128 wq = _mm_mul_ps(_mm_swizzle_ps_3(q.q), q.q);
+	__m128 alt = _mm_mul_ps(_mm_swizzle_ps_1203(q.q), q.q);
+
+	__m128 dot = _mm_hadd_ps(sqr, sqr);
+	dot = _mm_hadd_ps(dot, dot);
+	__m128 s = _mm_div_ps(_mm_set_ps1(2.0f), dot);
+
+	sqr = _mm_neg_ps(sqr);
+
+	// s * (xy + wz)
+	// s * (xy - wz)
+	// s * (zx + wy)
+	// s * (zx - wy)
+	__m128 a = _mm_mul_ps(s, _mm_add_ps(_mm_swizzle_ps_0022(alt), _mm_mul_ps(F32_SIGNFLIP_0101, _mm_swizzle_ps_2211(wq))));
+	// s * (yz + wx)
+	// s * (yz - wx)
+	__m128 b = _mm_mul_ps(s, _mm_add_ps(_mm_swizzle_ps_1(alt), _mm_mul_ps(F32_SIGNFLIP_0101, _mm_swizzle_ps_0(wq))));
+	// 1.0 - s * (yy + zz)
+	// 1.0 - s * (xx + zz)
+	// 1.0 - s * (xx + yy)
+	__m128 c = _mm_add_ps(F32_ONE, _mm_mul_ps(s, _mm_add_ps(_mm_swizzle_ps_1000(sqr), _mm_swizzle_ps_2211(sqr))));
+
+	// TODO: I could not really condense this down properly, needs a do-over
+	m.col0 = _mm_set_ps(0.0f, a.m128_f32[3], a.m128_f32[0], c.m128_f32[0]);
+	m.col1 = _mm_set_ps(0.0f, b.m128_f32[0], c.m128_f32[1], a.m128_f32[1]);
+	m.col2 = _mm_set_ps(0.0f, c.m128_f32[2], b.m128_f32[1], a.m128_f32[2]);
 #endif
 #if 0
-		// https://github.com/Autodesk/animx/blob/master/src/internal/Tquaternion.h
-		float ww = q.w * q.w, xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
-		float s = 2.0f / (ww + xx + yy + zz);
-		float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z, wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
-
-		// Use this if multiply vectors on the left (pre-multipy).
-		// This just the transposed matrix of the one above.
-		m.col0.m128_f32[0] = 1.0f - s * (yy + zz);
-		m.col0.m128_f32[1] = s * (xy + wz);
-		m.col0.m128_f32[2] = s * (xz - wy);
-		m.col0.m128_f32[3] = 0.0f;
-
-		m.col1.m128_f32[0] = s * (xy - wz);
-		m.col1.m128_f32[1] = 1.0f - s * (xx + zz);
-		m.col1.m128_f32[2] = s * (yz + wx);
-		m.col1.m128_f32[3] = 0.0f;
-
-		m.col2.m128_f32[0] = s * (xz + wy);
-		m.col2.m128_f32[1] = s * (yz - wx);
-		m.col2.m128_f32[2] = 1.0f - s * (xx + yy);
-		m.col2.m128_f32[3] = 0.0f;
+	// https://github.com/Autodesk/animx/blob/master/src/internal/Tquaternion.h
+	float ww = q.w * q.w, xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	float s = 2.0f / (ww + xx + yy + zz);
+	float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z, wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+	// Use this if multiply vectors on the left (pre-multipy).
+	// This just the transposed matrix of the one above.
+	m.col0.m128_f32[0] = 1.0f - s * (yy + zz);
+	m.col0.m128_f32[1] = s * (xy + wz);
+	m.col0.m128_f32[2] = s * (xz - wy);
+	m.col0.m128_f32[3] = 0.0f;
+
+	m.col1.m128_f32[0] = s * (xy - wz);
+	m.col1.m128_f32[1] = 1.0f - s * (xx + zz);
+	m.col1.m128_f32[2] = s * (yz + wx);
+	m.col1.m128_f32[3] = 0.0f;
+
+	m.col2.m128_f32[0] = s * (xz + wy);
+	m.col2.m128_f32[1] = s * (yz - wx);
+	m.col2.m128_f32[2] = 1.0f - s * (xx + yy);
+	m.col2.m128_f32[3] = 0.0f;
 #endif
-		m.col3 = F32_UNIT_W;
-		return m;
+	m.col3 = F32_UNIT_W;
+	return m;
+}
+
+// Returns the quaternion scaled by 2 * sqrt(t), the branches follow the largest diagonal term for precision
+__forceinline __m128 _Mat44ToQuatUnscaled(const Mat44& m, float& t)
+{
+	float trace = m.m00 + m.m11 + m.m22;
+	__m128 q;
+	if (trace > 0.0f)
+	{
+		// t = 4 * w * w, like the other branches; the trace alone is 4 * w * w - 1 and skews w
+		t = trace + 1.0f;
+		q = _mm_set_ps(t, m.m01 - m.m10, m.m20 - m.m02, m.m12 - m.m21);
+	}
+	else if (m.m00 > m.m11&& m.m00 > m.m22)
+	{
+		t = m.m00 - m.m11 - m.m22 + 1.0f;
+		q = _mm_set_ps(m.m12 - m.m21, m.m20 + m.m02, m.m01 + m.m10, t);
+	}
+	else if (m.m11 > m.m22)
+	{
+		t = -m.m00 + m.m11 - m.m22 + 1.0f;
+		q = _mm_set_ps(m.m20 - m.m02, m.m12 + m.m21, t, m.m01 + m.m10);
+	}
+	else
+	{
+		t = -m.m00 - m.m11 + m.m22 + 1.0f;
+		q = _mm_set_ps(m.m01 - m.m10, t, m.m12 + m.m21, m.m20 + m.m02);
+	}
+	return q;
+}
+
+extern "C"
+{
+	DLL Mat44 QuatToMat44(const Quat q)
+	{
+		return DISPATCH(QuatToMat44)(q);
 	}
 
 	DLL Quat Mat44ToQuat(Mat44 m)
 	{
-		float trace = m.m00 + m.m11 + m.m22;
 		float t;
-		__m128 q;
-		if (trace > 0.0f)
-		{
-			t = trace;
-			q = _mm_set_ps(t, m.m01 - m.m10, m.m20 - m.m02, m.m12 - m.m21);
-		}
-		else if (m.m00 > m.m11&& m.m00 > m.m22)
-		{
-			t = m.m00 - m.m11 - m.m22 + 1.0f;
-			q = _mm_set_ps(m.m12 - m.m21, m.m20 + m.m02, m.m01 + m.m10, t);
-		}
-		else if (m.m11 > m.m22)
-		{
-			t = -m.m00 + m.m11 - m.m22 + 1.0f;
-			q = _mm_set_ps(m.m20 - m.m02, m.m12 + m.m21, t, m.m01 + m.m10);
-		}
-		else
-		{
-			t = -m.m00 - m.m11 + m.m22 + 1.0f;
-			q = _mm_set_ps(m.m01 - m.m10, t, m.m12 + m.m21, m.m20 + m.m02);
-		}
+		__m128 q = _Mat44ToQuatUnscaled(m, t);
 		return {Vec4Normalized(_mm_mul_ps(q, _mm_mul_ps(_mm_set_ps1(0.5f), _mm_rsqrt_ps(_mm_set_ps1(t)))), F32_UNIT_W)};
 	}
+
+	DLL Quat Mat44ToQuatMode(const Mat44 m, const ENormalizeMode mode)
+	{
+		// The normalization takes care of the scale
+		float t;
+		return { Vec4NormalizedMode(_Mat44ToQuatUnscaled(m, t), F32_UNIT_W, mode) };
+	}
+
+	DLL void QuatToMat44Array(const Quat* quats, Mat44* result, const unsigned int count)
+	{
+		// Resolve the kernel once instead of per quaternion
+		auto kernel = DISPATCH(QuatToMat44);
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = kernel(quats[i]);
+	}
+
+	DLL void Mat44ToQuatArray(const Mat44* matrices, Quat* result, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = Mat44ToQuat(matrices[i]);
+	}
 }
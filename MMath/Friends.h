@@ -21,4 +21,8 @@ extern "C"
 {
 	DLL Mat44 QuatToMat44(const Quat q);
 	DLL Quat Mat44ToQuat(const Mat44 m);
+	DLL Quat Mat44ToQuatMode(const Mat44 m, const ENormalizeMode mode); // Mat44ToQuat normalizes in ENormalizeMode::Fast
+	// Batch versions
+	DLL void QuatToMat44Array(const Quat* quats, Mat44* result, const unsigned int count); // result must not alias quats, the matrices are bigger
+	DLL void Mat44ToQuatArray(const Mat44* matrices, Quat* result, const unsigned int count); // result may start at matrices, each quaternion only overwrites matrices already read
 }
@@ -0,0 +1,62 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Hierarchy.h"
+#include "Dispatch.h"
+
+// Worlds are written in order and only ever read back for parents, which precede their children,
+// so the pass streams through locals and worlds once and parents are usually still in cache.
+
+extern "C"
+{
+	DLL void Mat44HierarchyToWorld(const Mat44* locals, const int* parentIndices, Mat44* worlds, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const int parent = parentIndices[i];
+			worlds[i] = parent < 0 ? locals[i] : DISPATCH(Mat44Mul)(locals[i], worlds[parent]);
+		}
+	}
+	DLL void Mat44HierarchyTRSToWorld(const __m128* translates, const __m128* radians, const __m128* scales, const ERotateOrder rotateOrder, const int* parentIndices, Mat44* worlds, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const int parent = parentIndices[i];
+			const Mat44 local = Mat44TRS2(translates[i], radians[i], scales[i], rotateOrder);
+			worlds[i] = parent < 0 ? local : DISPATCH(Mat44Mul)(local, worlds[parent]);
+		}
+	}
+	DLL unsigned int Mat44HierarchyUpdate(const Mat44* locals, const int* parentIndices, unsigned char* dirty, Mat44* worlds, const unsigned int count)
+	{
+		// The flag of a parent is final by the time we reach its children, so propagating it is part of the same pass
+		unsigned int updated = 0;
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const int parent = parentIndices[i];
+			if (parent >= 0 && dirty[parent])
+				dirty[i] = 1;
+			if (!dirty[i])
+				continue;
+			worlds[i] = parent < 0 ? locals[i] : DISPATCH(Mat44Mul)(locals[i], worlds[parent]);
+			++updated;
+		}
+		return updated;
+	}
+	DLL void Mat34HierarchyToWorld(const Mat34* locals, const int* parentIndices, Mat34* worlds, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const int parent = parentIndices[i];
+			worlds[i] = parent < 0 ? locals[i] : _Mat34Mul(locals[i], worlds[parent]);
+		}
+	}
+}
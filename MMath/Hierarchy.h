@@ -0,0 +1,34 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include "Mat44.h"
+#include "Mat34.h"
+#include "Enums.h"
+
+extern "C"
+{
+	// Local to world evaluation of a transform hierarchy in a single linear pass.
+	// Joints must be topologically sorted: parentIndices[i] < i, or -1 for roots.
+	// worlds[i] = Mat44Parented(locals[i], worlds[parentIndices[i]]), roots copy their local matrix.
+	DLL void Mat44HierarchyToWorld(const Mat44* locals, const int* parentIndices, Mat44* worlds, const unsigned int count);
+	// Same as above with locals built by Mat44TRS2, w of every input is ignored.
+	DLL void Mat44HierarchyTRSToWorld(const __m128* translates, const __m128* radians, const __m128* scales, const ERotateOrder rotateOrder, const int* parentIndices, Mat44* worlds, const unsigned int count);
+	// Incremental version, set dirty[i] to non-zero for every joint whose local matrix changed since worlds was last evaluated.
+	// Only those joints and their descendants are recomputed. On return dirty marks every joint whose world matrix changed,
+	// so clear it before flagging the next changes. Returns the number of recomputed joints.
+	DLL unsigned int Mat44HierarchyUpdate(const Mat44* locals, const int* parentIndices, unsigned char* dirty, Mat44* worlds, const unsigned int count);
+	// Mat44HierarchyToWorld for affine matrices, a quarter less to read, write and multiply per joint.
+	DLL void Mat34HierarchyToWorld(const Mat34* locals, const int* parentIndices, Mat34* worlds, const unsigned int count);
+}
@@ -0,0 +1,43 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+
+// Header only build of MMath, see DLL.h.
+// Define MMATH_INLINE for the whole project (so every MMath header agrees) and include this file
+// wherever you use MMath, there is no library to link against in this mode.
+#ifndef MMATH_INLINE
+#error MMath/Inline.h requires MMATH_INLINE to be defined project wide
+#endif
+
+#include "SIMD.cpp"
+#include "Math.cpp"
+#include "Parallel.cpp"
+#include "Vector.cpp"
+#include "Quat.cpp"
+#include "Mat44.cpp"
+#include "Mat34.cpp"
+#include "Friends.cpp"
+#include "Stream.cpp"
+#include "DualQuat.cpp"
+#include "XForm.cpp"
+#include "Hierarchy.cpp"
+#include "Skinning.cpp"
+#include "Culling.cpp"
+#include "Intersect.cpp"
+#include "BVH.cpp"
+#include "Strided.cpp"
+#ifdef __AVX2__
+#include "FMA.cpp"
+#include "Double.cpp"
+#endif
+#include "Dispatch.cpp"
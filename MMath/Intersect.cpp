@@ -0,0 +1,99 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Intersect.h"
+#include "SIMD.h"
+#include "Dispatch.h"
+
+// Both kernels keep 4 rays per register and walk every triangle for the low and then the high half of the packet,
+// the triangle corners are broadcast so each triangle costs the same few instructions for all 4 rays.
+__forceinline int _RayTriangles4SSE(const RayPacket8* rays, const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2, RayHit8* hits, const unsigned int lane)
+{
+	const __m128 ox = _mm_load_ps(rays->originX + lane);
+	const __m128 oy = _mm_load_ps(rays->originY + lane);
+	const __m128 oz = _mm_load_ps(rays->originZ + lane);
+	const __m128 dx = _mm_load_ps(rays->directionX + lane);
+	const __m128 dy = _mm_load_ps(rays->directionY + lane);
+	const __m128 dz = _mm_load_ps(rays->directionZ + lane);
+	__m128 bestT = _mm_load_ps(hits->t + lane);
+	__m128 bestU = _mm_load_ps(hits->u + lane);
+	__m128 bestV = _mm_load_ps(hits->v + lane);
+	__m128 bestIndex = _mm_load_ps((const float*)hits->index + lane);
+	__m128 any = _mm_setzero_ps();
+	for (unsigned int i = 0; i < v0->count; ++i)
+	{
+		__m128 t, u, v;
+		__m128 hit = _RayTriangleSSE(ox, oy, oz, dx, dy, dz, _mm_set_ps1(v0->x[i]), _mm_set_ps1(v0->y[i]), _mm_set_ps1(v0->z[i]),
+			_mm_set_ps1(v1->x[i]), _mm_set_ps1(v1->y[i]), _mm_set_ps1(v1->z[i]), _mm_set_ps1(v2->x[i]), _mm_set_ps1(v2->y[i]), _mm_set_ps1(v2->z[i]), t, u, v);
+		hit = _mm_and_ps(hit, _mm_cmplt_ps(t, bestT));
+		bestT = _mm_blendv_ps(bestT, t, hit);
+		bestU = _mm_blendv_ps(bestU, u, hit);
+		bestV = _mm_blendv_ps(bestV, v, hit);
+		bestIndex = _mm_blendv_ps(bestIndex, _mm_castsi128_ps(_mm_set1_epi32((int)i)), hit);
+		any = _mm_or_ps(any, hit);
+	}
+	_mm_store_ps(hits->t + lane, bestT);
+	_mm_store_ps(hits->u + lane, bestU);
+	_mm_store_ps(hits->v + lane, bestV);
+	_mm_store_ps((float*)hits->index + lane, bestIndex);
+	return _mm_movemask_ps(any);
+}
+
+unsigned int _RayPacket8IntersectTrianglesSSE(const RayPacket8* rays, const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2, RayHit8* hits)
+{
+	const int lo = _RayTriangles4SSE(rays, v0, v1, v2, hits, 0);
+	const int hi = _RayTriangles4SSE(rays, v0, v1, v2, hits, 4);
+	return (unsigned int)(lo | (hi << 4));
+}
+
+unsigned int _RayPacket8IntersectBoxSSE(const RayPacket8* rays, const __m128 boxMin, const __m128 boxMax, const RayHit8* hits, float* tNear)
+{
+	const int lo = _RayBox4SSE(rays, boxMin, boxMax, hits, tNear, 0);
+	const int hi = _RayBox4SSE(rays, boxMin, boxMax, hits, tNear, 4);
+	return (unsigned int)(lo | (hi << 4));
+}
+
+extern "C"
+{
+	DLL void RayPacket8FromRays(const Vec* origins, const Vec* directions, const float maxDistance, const unsigned int count, RayPacket8* rays, RayHit8* hits)
+	{
+		for (unsigned int i = 0; i < 8; ++i)
+		{
+			// unused rays point along +x from the origin but can never get closer than -1
+			const bool used = i < count;
+			const Vec o = used ? origins[i] : Vec{ F32_ZERO };
+			const Vec d = used ? directions[i] : Vec{ F32_UNIT_X };
+			rays->originX[i] = o.x;
+			rays->originY[i] = o.y;
+			rays->originZ[i] = o.z;
+			rays->directionX[i] = d.x;
+			rays->directionY[i] = d.y;
+			rays->directionZ[i] = d.z;
+			// a 0 direction component becomes +-infinity, which is what the slab test needs
+			rays->inverseDirectionX[i] = 1.0f / d.x;
+			rays->inverseDirectionY[i] = 1.0f / d.y;
+			rays->inverseDirectionZ[i] = 1.0f / d.z;
+			hits->t[i] = used ? maxDistance : -1.0f;
+			hits->u[i] = 0.0f;
+			hits->v[i] = 0.0f;
+			hits->index[i] = ~0u;
+		}
+	}
+	DLL unsigned int RayPacket8IntersectTriangles(const RayPacket8* rays, const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2, RayHit8* hits)
+	{
+		return DISPATCH(RayPacket8IntersectTriangles)(rays, v0, v1, v2, hits);
+	}
+	DLL unsigned int RayPacket8IntersectBox(const RayPacket8* rays, const __m128 boxMin, const __m128 boxMax, const RayHit8* hits, float* tNear)
+	{
+		return DISPATCH(RayPacket8IntersectBox)(rays, boxMin, boxMax, hits, tNear);
+	}
+}
@@ -0,0 +1,109 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include "Vector.h"
+#include "Stream.h"
+#include "SIMD.h"
+
+extern "C"
+{
+	// 8 rays in structure of arrays form, the SSE kernels test them 4 at a time and the AVX2 kernels all 8 at once.
+	// Build it with RayPacket8FromRays, the inverse directions are there for the box test.
+	__declspec(align(32)) struct RayPacket8
+	{
+		float originX[8];
+		float originY[8];
+		float originZ[8];
+		float directionX[8];
+		float directionY[8];
+		float directionZ[8];
+		float inverseDirectionX[8];
+		float inverseDirectionY[8];
+		float inverseDirectionZ[8];
+	};
+
+	// Closest hit per ray so far. t starts out as the maximum distance and only shrinks, index is the triangle that was hit.
+	// u and v are the barycentric coordinates of the hit point, p = (1 - u - v) * v0 + u * v1 + v * v2.
+	__declspec(align(32)) struct RayHit8
+	{
+		float t[8];
+		float u[8];
+		float v[8];
+		unsigned int index[8];
+	};
+
+	// Fills a packet with count (at most 8) rays, directions do not have to be unit length (t is then in units of direction).
+	// Sets hits->t to maxDistance (use FLT_MAX for unbounded rays) and index to ~0u. The remaining rays get t = -1 and never hit anything.
+	DLL void RayPacket8FromRays(const Vec* origins, const Vec* directions, const float maxDistance, const unsigned int count, RayPacket8* rays, RayHit8* hits);
+	// Moller-Trumbore against every triangle (v0[i], v1[i], v2[i]) of the streams, both sides of a triangle count.
+	// Only hits closer than hits->t are recorded, so call it again for more triangles to keep the closest hit.
+	// Returns the mask of rays that got a closer hit in this call, bit i is ray i.
+	DLL unsigned int RayPacket8IntersectTriangles(const RayPacket8* rays, const Vec3Stream* v0, const Vec3Stream* v1, const Vec3Stream* v2, RayHit8* hits);
+	// Slab test against the box from boxMin to boxMax, returns the mask of rays that enter it before hits->t (or start inside).
+	// tNear may be null, otherwise it gets the distance at which each ray enters the box, 0 when it starts inside.
+	DLL unsigned int RayPacket8IntersectBox(const RayPacket8* rays, const __m128 boxMin, const __m128 boxMax, const RayHit8* hits, float* tNear);
+}
+
+// Moller-Trumbore for 4 ray / triangle pairs, with the ray origin o, direction d and triangle corners a, b, c as structure of arrays.
+// Either side may be broadcast: the packet kernels test 4 rays against one triangle, the BVH tests one ray against a leaf of 4 triangles.
+// Returns the lanes that hit at t > 0, parallel rays and degenerate triangles divide by 0 and the resulting NaNs and infinities fail the compares.
+__forceinline __m128 _RayTriangleSSE(const __m128 ox, const __m128 oy, const __m128 oz, const __m128 dx, const __m128 dy, const __m128 dz,
+	const __m128 ax, const __m128 ay, const __m128 az, const __m128 bx, const __m128 by, const __m128 bz, const __m128 cx, const __m128 cy, const __m128 cz,
+	__m128& t, __m128& u, __m128& v)
+{
+	const __m128 e1x = _mm_sub_ps(bx, ax), e1y = _mm_sub_ps(by, ay), e1z = _mm_sub_ps(bz, az);
+	const __m128 e2x = _mm_sub_ps(cx, ax), e2y = _mm_sub_ps(cy, ay), e2z = _mm_sub_ps(cz, az);
+	// p = d x e2, det = e1 . p
+	const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+	const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+	const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+	const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+	const __m128 invDet = _mm_div_ps(_mm_set_ps1(1.0f), det);
+	// s = o - a, u = s . p / det
+	const __m128 sx = _mm_sub_ps(ox, ax), sy = _mm_sub_ps(oy, ay), sz = _mm_sub_ps(oz, az);
+	u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+	// q = s x e1, v = d . q / det, t = e2 . q / det
+	const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+	const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+	const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+	v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+	t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+	const __m128 inside = _mm_and_ps(_mm_cmpge_ps(u, _mm_setzero_ps()), _mm_cmpge_ps(v, _mm_setzero_ps()));
+	return _mm_and_ps(_mm_and_ps(inside, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set_ps1(1.0f))), _mm_cmpgt_ps(t, _mm_setzero_ps()));
+}
+
+// Slab test for 4 rays of a packet, starting at lane, against one box. Also used by the BVH traversal to skip the dispatch per child.
+__forceinline int _RayBox4SSE(const RayPacket8* rays, const __m128 boxMin, const __m128 boxMax, const RayHit8* hits, float* tNear, const unsigned int lane)
+{
+	const __m128 ox = _mm_load_ps(rays->originX + lane);
+	const __m128 oy = _mm_load_ps(rays->originY + lane);
+	const __m128 oz = _mm_load_ps(rays->originZ + lane);
+	const __m128 ix = _mm_load_ps(rays->inverseDirectionX + lane);
+	const __m128 iy = _mm_load_ps(rays->inverseDirectionY + lane);
+	const __m128 iz = _mm_load_ps(rays->inverseDirectionZ + lane);
+	const __m128 x0 = _mm_mul_ps(_mm_sub_ps(_mm_swizzle_ps_0(boxMin), ox), ix);
+	const __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_swizzle_ps_0(boxMax), ox), ix);
+	const __m128 y0 = _mm_mul_ps(_mm_sub_ps(_mm_swizzle_ps_1(boxMin), oy), iy);
+	const __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_swizzle_ps_1(boxMax), oy), iy);
+	const __m128 z0 = _mm_mul_ps(_mm_sub_ps(_mm_swizzle_ps_2(boxMin), oz), iz);
+	const __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_swizzle_ps_2(boxMax), oz), iz);
+	// the ray is in the box between the last slab it enters and the first slab it leaves, clamped to [0, hits->t)
+	const __m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(x0, x1), _mm_min_ps(y0, y1)), _mm_max_ps(_mm_min_ps(z0, z1), _mm_setzero_ps()));
+	const __m128 leave = _mm_min_ps(_mm_min_ps(_mm_max_ps(x0, x1), _mm_max_ps(y0, y1)), _mm_max_ps(z0, z1));
+	const __m128 hit = _mm_and_ps(_mm_cmple_ps(enter, leave), _mm_cmplt_ps(enter, _mm_load_ps(hits->t + lane)));
+	if (tNear)
+		_mm_storeu_ps(tNear + lane, enter);
+	return _mm_movemask_ps(hit);
+}
@@ -26,11 +26,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 extern "C"
 {
-	DLL extern const float PI;
-	DLL extern const float HALF_PI;
-	DLL extern const float TAU;
-	DLL extern const float DEG2RAD;
-	DLL extern const float RAD2DEG;
+	DLL_DATA const float PI;
+	DLL_DATA const float HALF_PI;
+	DLL_DATA const float TAU;
+	DLL_DATA const float DEG2RAD;
+	DLL_DATA const float RAD2DEG;
 
 	DLL float Min(const float a, const float b);
 	DLL float Max(const float a, const float b);
@@ -46,11 +46,11 @@ extern "C"
 	DLL float LerpAngle(const float a, const float b, const float t); // Linear interpolate, but understand the values wrap around at TAU, can interpolate up to a full circle but not more.
 	DLL float InverseLerpAngle(const float a, const float b, const float t); // solve for t in v = LerpAngle(a, b, t)
 
-	DLL extern const __m128 F32_PI;
-	DLL extern const __m128 F32_HALF_PI;
-	DLL extern const __m128 F32_TAU;
-	DLL extern const __m128 F32_DEG2RAD;
-	DLL extern const __m128 F32_RAD2DEG;
+	DLL_DATA const __m128 F32_PI;
+	DLL_DATA const __m128 F32_HALF_PI;
+	DLL_DATA const __m128 F32_TAU;
+	DLL_DATA const __m128 F32_DEG2RAD;
+	DLL_DATA const __m128 F32_RAD2DEG;
 
 	//DLL Vec Min(const __m128 a, const __m128 b); // Already exists as _mm_min_ps
 	//DLL Vec Max(const __m128 a, const __m128 b); // Already exists as _mm_max_ps
@@ -0,0 +1,107 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Mat34.h"
+#include "SIMD.h"
+#include "Parallel.h"
+#include <xmmintrin.h>
+
+// Same guard against dividing by zero length axes as GetTransformInverse in Mat44.cpp
+static const float MAT34_SMALL_NUMBER = 1.e-8f;
+
+// The inverse of the 3x3 part goes in the rows, the translation is -inverse * translation, so w = -dot(row.xyz, translation).
+__forceinline Mat34 _Mat34InverseTranslation(const __m128 row0, const __m128 row1, const __m128 row2, const __m128 translation)
+{
+	// dp with mask 0x78 puts the xyz dot product in w only, the w of every row is 0 at this point
+	Mat34 r;
+	r.row0 = _mm_sub_ps(row0, _mm_dp_ps(row0, translation, 0x78));
+	r.row1 = _mm_sub_ps(row1, _mm_dp_ps(row1, translation, 0x78));
+	r.row2 = _mm_sub_ps(row2, _mm_dp_ps(row2, translation, 0x78));
+	return r;
+}
+
+extern "C"
+{
+	DLL Mat34 Mat34Identity()
+	{
+		return { F32_UNIT_X, F32_UNIT_Y, F32_UNIT_Z };
+	}
+	DLL Mat34 Mat44ToMat34(const Mat44 m)
+	{
+		Mat44 t = m;
+		_MM_TRANSPOSE4_PS(t.col0, t.col1, t.col2, t.col3);
+		return { t.col0, t.col1, t.col2 };
+	}
+	DLL Mat44 Mat34ToMat44(const Mat34 m)
+	{
+		Mat44 t = { m.row0, m.row1, m.row2, F32_UNIT_W };
+		_MM_TRANSPOSE4_PS(t.col0, t.col1, t.col2, t.col3);
+		return t;
+	}
+	DLL Mat34 Mat34Mul(const Mat34 rhs, const Mat34 lhs)
+	{
+		return _Mat34Mul(rhs, lhs);
+	}
+	DLL Mat34 Mat34Inversed(const Mat34 m)
+	{
+		// The columns of the 3x3 part, then the rows of its inverse are the cross products of those divided by the determinant
+		__m128 c0 = m.row0, c1 = m.row1, c2 = m.row2, c3 = F32_UNIT_W;
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		__m128 r0 = Vec3Cross(c1, c2).s;
+		__m128 r1 = Vec3Cross(c2, c0).s;
+		__m128 r2 = Vec3Cross(c0, c1).s;
+		__m128 invDeterminant = _mm_div_ps(F32_ONE, _mm_dp_ps(c0, r0, 0x7F));
+		return _Mat34InverseTranslation(_mm_mul_ps(r0, invDeterminant), _mm_mul_ps(r1, invDeterminant), _mm_mul_ps(r2, invDeterminant), c3);
+	}
+	DLL Mat34 Mat34InversedFast(const Mat34 m)
+	{
+		// Orthogonal axes scaled by s invert to the same axes scaled by 1 / s, that is the axis divided by its squared length.
+		// The squared axis lengths are just the sum of the squared rows.
+		__m128 sizeSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m.row0, m.row0), _mm_mul_ps(m.row1, m.row1)), _mm_mul_ps(m.row2, m.row2));
+		__m128 rSizeSqr = _mm_blendv_ps(_mm_div_ps(F32_ONE, sizeSqr), F32_ONE, _mm_cmplt_ps(sizeSqr, _mm_set_ps1(MAT34_SMALL_NUMBER)));
+		__m128 c0 = m.row0, c1 = m.row1, c2 = m.row2, c3 = F32_UNIT_W;
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		return _Mat34InverseTranslation(_mm_mul_ps(c0, _mm_swizzle_ps_0(rSizeSqr)), _mm_mul_ps(c1, _mm_swizzle_ps_1(rSizeSqr)), _mm_mul_ps(c2, _mm_swizzle_ps_2(rSizeSqr)), c3);
+	}
+	DLL Mat34 Mat34InversedFastNoScale(const Mat34 m)
+	{
+		__m128 c0 = m.row0, c1 = m.row1, c2 = m.row2, c3 = F32_UNIT_W;
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		return _Mat34InverseTranslation(c0, c1, c2, c3);
+	}
+	DLL Vec Mat34PointTransform(const Mat34 m, const __m128 p)
+	{
+		return { _Mat34Transform(m.row0, m.row1, m.row2, _mm_blend_ps(p, F32_ONE, 0b1000)) };
+	}
+	DLL Vec Mat34VectorTransform(const Mat34 m, const __m128 v)
+	{
+		return { _Mat34Transform(m.row0, m.row1, m.row2, _mm_blend_ps(v, F32_ZERO, 0b1000)) };
+	}
+	DLL void Mat44ToMat34Array(const Mat44* matrices, Mat34* result, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = Mat44ToMat34(matrices[i]);
+	}
+	DLL void Mat34ToMat44Array(const Mat34* matrices, Mat44* result, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = Mat34ToMat44(matrices[i]);
+	}
+	DLL void Mat34MulArray(const Mat34* children, const Mat34* parents, Mat34* result, const unsigned int count)
+	{
+		ParallelFor(0, count, ParallelGrain(16384), [&](const unsigned int begin, const unsigned int end)
+		{
+			for (unsigned int i = begin; i < end; ++i)
+				result[i] = _Mat34Mul(children[i], parents[i]);
+		});
+	}
+}
@@ -0,0 +1,89 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include "Vector.h"
+#include "Mat44.h"
+#include "SIMD.h"
+
+extern "C"
+{
+	// Affine transform in 48 bytes instead of the 64 of a Mat44, the fourth row (0, 0, 0, 1) is implied.
+	// Stored as rows, so element names match Mat44: row0 = (m00, m10, m20, m30) and m30 is the x translation.
+	// Points transform with 3 dot products and multiplying two of these skips a quarter of the Mat44Mul work.
+	__declspec(align(16)) struct Mat34
+	{
+		union
+		{
+			__m128 rows[3];
+			struct
+			{
+				__m128 row0;
+				__m128 row1;
+				__m128 row2;
+			};
+			struct
+			{
+				float m00;
+				float m10;
+				float m20;
+				float m30;
+				float m01;
+				float m11;
+				float m21;
+				float m31;
+				float m02;
+				float m12;
+				float m22;
+				float m32;
+			};
+			float m[12];
+		};
+	};
+
+	DLL Mat34 Mat34Identity();
+	DLL Mat34 Mat44ToMat34(const Mat44 m); // drops the fourth row, so m must be affine (see Mat44ValidationFlags::FourthRow)
+	DLL Mat44 Mat34ToMat44(const Mat34 m);
+	DLL Mat34 Mat34Mul(const Mat34 rhs, const Mat34 lhs); // same order as Mat44Mul, rhs is the child and lhs the parent
+	DLL Mat34 Mat34Inversed(const Mat34 m); // any invertible affine matrix, including shear
+	DLL Mat34 Mat34InversedFast(const Mat34 m); // orthogonal axes only, like Mat44InversedFast
+	DLL Mat34 Mat34InversedFastNoScale(const Mat34 m); // orthonormal axes only, like Mat44InversedFastNoScale
+	DLL Vec Mat34PointTransform(const Mat34 m, const __m128 p); // rotate, scale and translate, w = 1
+	DLL Vec Mat34VectorTransform(const Mat34 m, const __m128 v); // rotate and scale only, w = 0
+	// Batch versions, the result of Mat34MulArray may alias either input
+	DLL void Mat44ToMat34Array(const Mat44* matrices, Mat34* result, const unsigned int count);
+	DLL void Mat34ToMat44Array(const Mat34* matrices, Mat44* result, const unsigned int count);
+	DLL void Mat34MulArray(const Mat34* children, const Mat34* parents, Mat34* result, const unsigned int count);
+}
+
+// Internal, shared with the hierarchy and skinning code.
+__forceinline __m128 _Mat34MulRow(const __m128 lhsRow, const Mat34& rhs)
+{
+	// lhsRow.w * (0, 0, 0, 1) is just the w of lhsRow
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(rhs.row0, _mm_swizzle_ps_0(lhsRow)), _mm_mul_ps(rhs.row1, _mm_swizzle_ps_1(lhsRow))),
+		_mm_add_ps(_mm_mul_ps(rhs.row2, _mm_swizzle_ps_2(lhsRow)), _mm_blend_ps(F32_ZERO, lhsRow, 0b1000)));
+}
+__forceinline Mat34 _Mat34Mul(const Mat34& rhs, const Mat34& lhs)
+{
+	Mat34 m;
+	m.row0 = _Mat34MulRow(lhs.row0, rhs);
+	m.row1 = _Mat34MulRow(lhs.row1, rhs);
+	m.row2 = _Mat34MulRow(lhs.row2, rhs);
+	return m;
+}
+// v.w must be 1 for points and 0 for vectors, the result has the same w.
+__forceinline __m128 _Mat34Transform(const __m128 row0, const __m128 row1, const __m128 row2, const __m128 v)
+{
+	return _mm_hadd_ps(_mm_hadd_ps(_mm_mul_ps(row0, v), _mm_mul_ps(row1, v)), _mm_hadd_ps(_mm_mul_ps(row2, v), _mm_blend_ps(F32_ZERO, v, 0b1000)));
+}
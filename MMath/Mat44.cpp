@@ -16,9 +16,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Vector.h"
 #include "Enums.h"
 #include "Friends.h"
+#include "Dispatch.h"
+#include "Parallel.h"
 #include <math.h>
+#include <float.h>
 
-static const __m128 F32_SIGNFLIP_1110 = { -1.0f, -1.0f, -1.0f, 1.0f };
 #pragma region(eric_matrix_inversion)
 #if 1
 // https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
@@ -595,8 +597,350 @@ inline __m128 Det44(const Mat44& inM)
 
 const Mat44 MAT44_IDENTITY = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
 
-Mat44 Mat44::operator* (const Mat44& rhs) { return Mat44Mul(*this, rhs); }
-Vec Mat44::operator* (const __m128& rhs) { return Mat44VectorTransform(*this, rhs); }
+DLL_INTERNAL Mat44 Mat44::operator* (const Mat44& rhs) { return Mat44Mul(*this, rhs); }
+DLL_INTERNAL Vec Mat44::operator* (const __m128& rhs) { return Mat44VectorTransform(*this, rhs); }
+
+// One column of Mat44Mul with the parent columns already in registers, so batch loops can keep them around
+__forceinline __m128 _Mat44MulColumn(const __m128 p0, const __m128 p1, const __m128 p2, const __m128 p3, const __m128 c)
+{
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, _mm_swizzle_ps_0(c)),
+		_mm_mul_ps(p1, _mm_swizzle_ps_1(c))),
+		_mm_add_ps(_mm_mul_ps(p2, _mm_swizzle_ps_2(c)),
+			_mm_mul_ps(p3, _mm_swizzle_ps_3(c))));
+}
+
+// How many pairs ahead of the current one we ask the cache for, 8 pairs is 1KB in flight per stream
+static const unsigned int MAT44_PREFETCH_DISTANCE = 8;
+
+Mat44 _Mat44MulSSE(const Mat44 rhs, const Mat44 lhs)
+{
+	Mat44 m;
+
+	m.col0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.col0, _mm_swizzle_ps_0(rhs.col0)),
+		_mm_mul_ps(lhs.col1, _mm_swizzle_ps_1(rhs.col0))),
+		_mm_add_ps(_mm_mul_ps(lhs.col2, _mm_swizzle_ps_2(rhs.col0)),
+			_mm_mul_ps(lhs.col3, _mm_swizzle_ps_3(rhs.col0))));
+
+	m.col1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.col0, _mm_swizzle_ps_0(rhs.col1)),
+		_mm_mul_ps(lhs.col1, _mm_swizzle_ps_1(rhs.col1))),
+		_mm_add_ps(_mm_mul_ps(lhs.col2, _mm_swizzle_ps_2(rhs.col1)),
+			_mm_mul_ps(lhs.col3, _mm_swizzle_ps_3(rhs.col1))));
+
+	m.col2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.col0, _mm_swizzle_ps_0(rhs.col2)),
+		_mm_mul_ps(lhs.col1, _mm_swizzle_ps_1(rhs.col2))),
+		_mm_add_ps(_mm_mul_ps(lhs.col2, _mm_swizzle_ps_2(rhs.col2)),
+			_mm_mul_ps(lhs.col3, _mm_swizzle_ps_3(rhs.col2))));
+
+	m.col3 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.col0, _mm_swizzle_ps_0(rhs.col3)),
+		_mm_mul_ps(lhs.col1, _mm_swizzle_ps_1(rhs.col3))),
+		_mm_add_ps(_mm_mul_ps(lhs.col2, _mm_swizzle_ps_2(rhs.col3)),
+			_mm_mul_ps(lhs.col3, _mm_swizzle_ps_3(rhs.col3))));
+
+	return m;
+}
+
+Vec _Mat44VectorTransformSSE(const Mat44 m, const __m128 v)
+{
+	// Note: set v.w to 0 to ignore translation
+	return { _mm_add_ps(_mm_add_ps(_mm_mul_ps(m.col0, _mm_swizzle_ps_0(v)),
+		_mm_mul_ps(m.col1, _mm_swizzle_ps_1(v))),
+		_mm_add_ps(_mm_mul_ps(m.col2, _mm_swizzle_ps_2(v)),
+			_mm_mul_ps(m.col3, _mm_swizzle_ps_3(v)))) };
+}
+
+void _Mat44MulArraySSE(const Mat44* children, const Mat44* parents, Mat44* result, const unsigned int count)
+{
+	// Two independent products per iteration so the mul/add chains of one can hide the latency of the other,
+	// while the loads for pairs further down the array are already on their way.
+	// All loads of an iteration happen before its stores, so result may alias children or parents.
+	unsigned int i = 0;
+	for (; i + 1 < count; i += 2)
+	{
+		_mm_prefetch((const char*)&children[i + MAT44_PREFETCH_DISTANCE], _MM_HINT_T0);
+		_mm_prefetch((const char*)&parents[i + MAT44_PREFETCH_DISTANCE], _MM_HINT_T0);
+
+		const Mat44& c0 = children[i];
+		const Mat44& p0 = parents[i];
+		const Mat44& c1 = children[i + 1];
+		const Mat44& p1 = parents[i + 1];
+
+		__m128 a0 = _Mat44MulColumn(p0.col0, p0.col1, p0.col2, p0.col3, c0.col0);
+		__m128 b0 = _Mat44MulColumn(p1.col0, p1.col1, p1.col2, p1.col3, c1.col0);
+		__m128 a1 = _Mat44MulColumn(p0.col0, p0.col1, p0.col2, p0.col3, c0.col1);
+		__m128 b1 = _Mat44MulColumn(p1.col0, p1.col1, p1.col2, p1.col3, c1.col1);
+		__m128 a2 = _Mat44MulColumn(p0.col0, p0.col1, p0.col2, p0.col3, c0.col2);
+		__m128 b2 = _Mat44MulColumn(p1.col0, p1.col1, p1.col2, p1.col3, c1.col2);
+		__m128 a3 = _Mat44MulColumn(p0.col0, p0.col1, p0.col2, p0.col3, c0.col3);
+		__m128 b3 = _Mat44MulColumn(p1.col0, p1.col1, p1.col2, p1.col3, c1.col3);
+
+		result[i].col0 = a0;
+		result[i].col1 = a1;
+		result[i].col2 = a2;
+		result[i].col3 = a3;
+		result[i + 1].col0 = b0;
+		result[i + 1].col1 = b1;
+		result[i + 1].col2 = b2;
+		result[i + 1].col3 = b3;
+	}
+	if (i < count)
+	{
+		// odd tail
+		const Mat44& c = children[i];
+		const Mat44& p = parents[i];
+		__m128 a0 = _Mat44MulColumn(p.col0, p.col1, p.col2, p.col3, c.col0);
+		__m128 a1 = _Mat44MulColumn(p.col0, p.col1, p.col2, p.col3, c.col1);
+		__m128 a2 = _Mat44MulColumn(p.col0, p.col1, p.col2, p.col3, c.col2);
+		__m128 a3 = _Mat44MulColumn(p.col0, p.col1, p.col2, p.col3, c.col3);
+		result[i].col0 = a0;
+		result[i].col1 = a1;
+		result[i].col2 = a2;
+		result[i].col3 = a3;
+	}
+}
+
+// Inverse of 4 matrices in SoA form: a[k] holds element k of 4 matrices and is overwritten with their inverses.
+// Cofactor expansion through the 2x2 sub determinants of the first two and the last two columns.
+// Returns the determinants, valid is set for the lanes that are finite and not (nearly) singular,
+// the other lanes are zeroed. The test is the reciprocal condition number 1 / (|m| * |inverse|) >= epsilon
+// in the Frobenius norm, squared so it needs no square root or division.
+__forceinline __m128 _Mat44Inverse4(__m128 a[16], const __m128 epsilonSqr, __m128& valid)
+{
+	const __m128 s0 = _mm_sub_ps(_mm_mul_ps(a[0], a[5]), _mm_mul_ps(a[4], a[1]));
+	const __m128 s1 = _mm_sub_ps(_mm_mul_ps(a[0], a[6]), _mm_mul_ps(a[4], a[2]));
+	const __m128 s2 = _mm_sub_ps(_mm_mul_ps(a[0], a[7]), _mm_mul_ps(a[4], a[3]));
+	const __m128 s3 = _mm_sub_ps(_mm_mul_ps(a[1], a[6]), _mm_mul_ps(a[5], a[2]));
+	const __m128 s4 = _mm_sub_ps(_mm_mul_ps(a[1], a[7]), _mm_mul_ps(a[5], a[3]));
+	const __m128 s5 = _mm_sub_ps(_mm_mul_ps(a[2], a[7]), _mm_mul_ps(a[6], a[3]));
+	const __m128 c0 = _mm_sub_ps(_mm_mul_ps(a[8], a[13]), _mm_mul_ps(a[12], a[9]));
+	const __m128 c1 = _mm_sub_ps(_mm_mul_ps(a[8], a[14]), _mm_mul_ps(a[12], a[10]));
+	const __m128 c2 = _mm_sub_ps(_mm_mul_ps(a[8], a[15]), _mm_mul_ps(a[12], a[11]));
+	const __m128 c3 = _mm_sub_ps(_mm_mul_ps(a[9], a[14]), _mm_mul_ps(a[13], a[10]));
+	const __m128 c4 = _mm_sub_ps(_mm_mul_ps(a[9], a[15]), _mm_mul_ps(a[13], a[11]));
+	const __m128 c5 = _mm_sub_ps(_mm_mul_ps(a[10], a[15]), _mm_mul_ps(a[14], a[11]));
+
+	const __m128 det = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(s0, c5), _mm_mul_ps(s1, c4)), _mm_add_ps(_mm_mul_ps(s2, c3), _mm_mul_ps(s3, c2))),
+		_mm_sub_ps(_mm_mul_ps(s5, c0), _mm_mul_ps(s4, c1)));
+	const __m128 invDet = _mm_div_ps(F32_ONE, det);
+	const __m128 negInvDet = _mm_neg_ps(invDet);
+
+	// x * p - y * q + z * r
+	auto cofactor = [](const __m128 x, const __m128 p, const __m128 y, const __m128 q, const __m128 z, const __m128 r)
+	{
+		return _mm_add_ps(_mm_sub_ps(_mm_mul_ps(x, p), _mm_mul_ps(y, q)), _mm_mul_ps(z, r));
+	};
+	__m128 b[16];
+	b[0] = _mm_mul_ps(cofactor(a[5], c5, a[6], c4, a[7], c3), invDet);
+	b[1] = _mm_mul_ps(cofactor(a[1], c5, a[2], c4, a[3], c3), negInvDet);
+	b[2] = _mm_mul_ps(cofactor(a[13], s5, a[14], s4, a[15], s3), invDet);
+	b[3] = _mm_mul_ps(cofactor(a[9], s5, a[10], s4, a[11], s3), negInvDet);
+	b[4] = _mm_mul_ps(cofactor(a[4], c5, a[6], c2, a[7], c1), negInvDet);
+	b[5] = _mm_mul_ps(cofactor(a[0], c5, a[2], c2, a[3], c1), invDet);
+	b[6] = _mm_mul_ps(cofactor(a[12], s5, a[14], s2, a[15], s1), negInvDet);
+	b[7] = _mm_mul_ps(cofactor(a[8], s5, a[10], s2, a[11], s1), invDet);
+	b[8] = _mm_mul_ps(cofactor(a[4], c4, a[5], c2, a[7], c0), invDet);
+	b[9] = _mm_mul_ps(cofactor(a[0], c4, a[1], c2, a[3], c0), negInvDet);
+	b[10] = _mm_mul_ps(cofactor(a[12], s4, a[13], s2, a[15], s0), invDet);
+	b[11] = _mm_mul_ps(cofactor(a[8], s4, a[9], s2, a[11], s0), negInvDet);
+	b[12] = _mm_mul_ps(cofactor(a[4], c3, a[5], c1, a[6], c0), negInvDet);
+	b[13] = _mm_mul_ps(cofactor(a[0], c3, a[1], c1, a[2], c0), invDet);
+	b[14] = _mm_mul_ps(cofactor(a[12], s3, a[13], s1, a[14], s0), negInvDet);
+	b[15] = _mm_mul_ps(cofactor(a[8], s3, a[9], s1, a[10], s0), invDet);
+
+	__m128 sumA = F32_ZERO, sumB = F32_ZERO;
+	for (int k = 0; k < 16; ++k)
+	{
+		sumA = _mm_add_ps(sumA, _mm_mul_ps(a[k], a[k]));
+		sumB = _mm_add_ps(sumB, _mm_mul_ps(b[k], b[k]));
+	}
+	// NaN fails both compares, an infinite determinant would otherwise pass with an all zero inverse
+	valid = _mm_and_ps(_mm_cmple_ps(_mm_mul_ps(_mm_mul_ps(epsilonSqr, sumA), sumB), F32_ONE),
+		_mm_cmple_ps(_mm_abs_ps(det), _mm_set1_ps(FLT_MAX)));
+	for (int k = 0; k < 16; ++k)
+		a[k] = _mm_and_ps(b[k], valid);
+	return det;
+}
+
+// Transposes 4 matrices to SoA and back, a[k] holds element k of all 4
+__forceinline void _Mat44ToSoA4(const Mat44* m, __m128 a[16])
+{
+	for (int c = 0; c < 4; ++c)
+	{
+		a[c * 4 + 0] = m[0].cols[c];
+		a[c * 4 + 1] = m[1].cols[c];
+		a[c * 4 + 2] = m[2].cols[c];
+		a[c * 4 + 3] = m[3].cols[c];
+		_MM_TRANSPOSE4_PS(a[c * 4 + 0], a[c * 4 + 1], a[c * 4 + 2], a[c * 4 + 3]);
+	}
+}
+
+__forceinline void _Mat44FromSoA4(__m128 a[16], Mat44* m)
+{
+	for (int c = 0; c < 4; ++c)
+	{
+		_MM_TRANSPOSE4_PS(a[c * 4 + 0], a[c * 4 + 1], a[c * 4 + 2], a[c * 4 + 3]);
+		m[0].cols[c] = a[c * 4 + 0];
+		m[1].cols[c] = a[c * 4 + 1];
+		m[2].cols[c] = a[c * 4 + 2];
+		m[3].cols[c] = a[c * 4 + 3];
+	}
+}
+
+// 8 matrices, so every block fills one byte of the singular mask
+__forceinline void _Mat44InversedCheckedBlockSSE(const Mat44* matrices, const __m128 epsilonSqr, Mat44* result, float* determinants, unsigned char* singular)
+{
+	__m128 lo[16], hi[16], validLo, validHi;
+	_Mat44ToSoA4(matrices, lo);
+	_Mat44ToSoA4(matrices + 4, hi);
+	_mm_storeu_ps(determinants, _Mat44Inverse4(lo, epsilonSqr, validLo));
+	_mm_storeu_ps(determinants + 4, _Mat44Inverse4(hi, epsilonSqr, validHi));
+	_Mat44FromSoA4(lo, result);
+	_Mat44FromSoA4(hi, result + 4);
+	*singular = (unsigned char)(~(_mm_movemask_ps(validLo) | (_mm_movemask_ps(validHi) << 4)));
+}
+
+void _Mat44InversedCheckedArraySSE(const Mat44* matrices, const float epsilon, Mat44* result, float* determinants, unsigned char* singular, const unsigned int count)
+{
+	const __m128 epsilonSqr = _mm_set1_ps(epsilon * epsilon);
+	unsigned int i = 0;
+	for (; i + 8 <= count; i += 8)
+		_Mat44InversedCheckedBlockSSE(matrices + i, epsilonSqr, result + i, determinants + i, singular + i / 8);
+	if (i < count)
+	{
+		// Partial block at the end goes through a copy padded with identities, which are never flagged
+		Mat44 pm[8];
+		float pd[8];
+		for (unsigned int j = 0; j < 8; ++j)
+			pm[j] = j < count - i ? matrices[i + j] : Mat44Identity();
+		_Mat44InversedCheckedBlockSSE(pm, epsilonSqr, pm, pd, singular + i / 8);
+		for (unsigned int j = 0; j < count - i; ++j)
+		{
+			result[i + j] = pm[j];
+			determinants[i + j] = pd[j];
+		}
+	}
+}
+
+// Elementary rotations from a precomputed sine & cosine, so callers can get all of them from one _mm_sincos_ps
+__forceinline Mat44 _Mat44RotateX(const float sa, const float ca)
+{
+	return { F32_UNIT_X, _mm_set_ps(0.0f, sa, ca, 0.0f), _mm_set_ps(0.0f, ca, -sa, 0.0f) , F32_UNIT_W };
+}
+__forceinline Mat44 _Mat44RotateY(const float sa, const float ca)
+{
+	return { _mm_set_ps(0.0f, -sa, 0.0f, ca), F32_UNIT_Y, _mm_set_ps(0.0f, ca, 0.0f, sa), F32_UNIT_W };
+}
+__forceinline Mat44 _Mat44RotateZ(const float sa, const float ca)
+{
+	return { _mm_set_ps(0.0f, 0.0f, sa, ca) , _mm_set_ps(0.0f, 0.0f, ca, -sa), F32_UNIT_Z, F32_UNIT_W };
+}
+
+// Closed form of Mat44Rotate for one rotate order, from the sines and cosines of the x, y and z angles.
+// Written out for XYZ (first axis a, second b, third c), the other orders relabel the axes,
+// odd permutations of XYZ additionally flip the sign of every sine.
+template<ERotateOrder RO>
+__forceinline Mat44 _Mat44RotateOrdered(const __m128 s, const __m128 c)
+{
+	constexpr int a = (int)RO >> 4;
+	constexpr int b = ((int)RO >> 2) & 0b11;
+	constexpr int k = (int)RO & 0b11;
+	constexpr bool odd = ((a + 1) % 3) != b;
+	const float sa = odd ? -s.m128_f32[a] : s.m128_f32[a];
+	const float sb = odd ? -s.m128_f32[b] : s.m128_f32[b];
+	const float sc = odd ? -s.m128_f32[k] : s.m128_f32[k];
+	const float ca = c.m128_f32[a];
+	const float cb = c.m128_f32[b];
+	const float cc = c.m128_f32[k];
+	const float sasb = sa * sb;
+	const float casb = ca * sb;
+
+	// m[column][row]
+	float m[3][3];
+	m[a][a] = cb * cc;
+	m[a][b] = cb * sc;
+	m[a][k] = -sb;
+	m[b][a] = sasb * cc - ca * sc;
+	m[b][b] = sasb * sc + ca * cc;
+	m[b][k] = sa * cb;
+	m[k][a] = casb * cc + sa * sc;
+	m[k][b] = casb * sc - sa * cc;
+	m[k][k] = ca * cb;
+
+	return { _mm_set_ps(0.0f, m[0][2], m[0][1], m[0][0]),
+		_mm_set_ps(0.0f, m[1][2], m[1][1], m[1][0]),
+		_mm_set_ps(0.0f, m[2][2], m[2][1], m[2][0]),
+		F32_UNIT_W };
+}
+
+// Jump table on the rotate order, radians.w is ignored
+__forceinline Mat44 _Mat44Rotate(const __m128 radians, const ERotateOrder rotateOrder)
+{
+	__m128 s, c;
+	_mm_sincos_ps(radians, &s, &c);
+	switch (rotateOrder)
+	{
+	case ERotateOrder::XYZ:
+		return _Mat44RotateOrdered<ERotateOrder::XYZ>(s, c);
+	case ERotateOrder::YZX:
+		return _Mat44RotateOrdered<ERotateOrder::YZX>(s, c);
+	case ERotateOrder::ZXY:
+		return _Mat44RotateOrdered<ERotateOrder::ZXY>(s, c);
+	case ERotateOrder::XZY:
+		return _Mat44RotateOrdered<ERotateOrder::XZY>(s, c);
+	case ERotateOrder::YXZ:
+		return _Mat44RotateOrdered<ERotateOrder::YXZ>(s, c);
+	case ERotateOrder::ZYX:
+	default:
+		return _Mat44RotateOrdered<ERotateOrder::ZYX>(s, c);
+	}
+}
+
+// Inverse of _Mat44RotateOrdered, m must be a rotation without scale.
+// The middle angle ends up in [-PI/2, PI/2], in gimbal lock the third angle is folded into the first.
+template<ERotateOrder RO>
+__forceinline Vec _Mat44ToEulerOrdered(const Mat44& m)
+{
+	constexpr int a = (int)RO >> 4;
+	constexpr int b = ((int)RO >> 2) & 0b11;
+	constexpr int k = (int)RO & 0b11;
+	constexpr bool odd = ((a + 1) % 3) != b;
+	// m.m[column * 4 + row], cos(b) from the rest of the column because asin loses precision near gimbal lock
+	const float sb = -m.m[a * 4 + k];
+	const float cb = sqrtf(m.m[a * 4 + a] * m.m[a * 4 + a] + m.m[a * 4 + b] * m.m[a * 4 + b]);
+	float angles[3];
+	angles[b] = atan2f(sb, cb);
+	if (cb > 1e-6f)
+	{
+		angles[a] = atan2f(m.m[b * 4 + k], m.m[k * 4 + k]);
+		angles[k] = atan2f(m.m[a * 4 + b], m.m[a * 4 + a]);
+	}
+	else
+	{
+		angles[a] = atan2f(sb * m.m[b * 4 + a], m.m[b * 4 + b]);
+		angles[k] = 0.0f;
+	}
+	const float sign = odd ? -1.0f : 1.0f;
+	return { _mm_set_ps(0.0f, sign * angles[2], sign * angles[1], sign * angles[0]) };
+}
+
+__forceinline Vec _Mat44ToEuler(const Mat44& m, const ERotateOrder rotateOrder)
+{
+	switch (rotateOrder)
+	{
+	case ERotateOrder::XYZ:
+		return _Mat44ToEulerOrdered<ERotateOrder::XYZ>(m);
+	case ERotateOrder::YZX:
+		return _Mat44ToEulerOrdered<ERotateOrder::YZX>(m);
+	case ERotateOrder::ZXY:
+		return _Mat44ToEulerOrdered<ERotateOrder::ZXY>(m);
+	case ERotateOrder::XZY:
+		return _Mat44ToEulerOrdered<ERotateOrder::XZY>(m);
+	case ERotateOrder::YXZ:
+		return _Mat44ToEulerOrdered<ERotateOrder::YXZ>(m);
+	case ERotateOrder::ZYX:
+	default:
+		return _Mat44ToEulerOrdered<ERotateOrder::ZYX>(m);
+	}
+}
 
 extern "C"
 {
@@ -615,21 +959,21 @@ extern "C"
 
 	DLL Mat44 Mat44RotateX(const float radians)
 	{
-		float sa = sinf(radians);
-		float ca = cosf(radians);
-		return { F32_UNIT_X, _mm_set_ps(0.0f, sa, ca, 0.0f), _mm_set_ps(0.0f, ca, -sa, 0.0f) , F32_UNIT_W };
+		__m128 s, c;
+		_mm_sincos_ps(_mm_set_ss(radians), &s, &c);
+		return _Mat44RotateX(s.m128_f32[0], c.m128_f32[0]);
 	}
 	DLL Mat44 Mat44RotateY(const float radians)
 	{
-		float sa = sinf(radians);
-		float ca = cosf(radians);
-		return { _mm_set_ps(0.0f, -sa, 0.0f, ca), F32_UNIT_Y, _mm_set_ps(0.0f, ca, 0.0f, sa), F32_UNIT_W };
+		__m128 s, c;
+		_mm_sincos_ps(_mm_set_ss(radians), &s, &c);
+		return _Mat44RotateY(s.m128_f32[0], c.m128_f32[0]);
 	}
 	DLL Mat44 Mat44RotateZ(const float radians)
 	{
-		float sa = sinf(radians);
-		float ca = cosf(radians);
-		return { _mm_set_ps(0.0f, 0.0f, sa, ca) , _mm_set_ps(0.0f, 0.0f, ca, -sa), F32_UNIT_Z, F32_UNIT_W };
+		__m128 s, c;
+		_mm_sincos_ps(_mm_set_ss(radians), &s, &c);
+		return _Mat44RotateZ(s.m128_f32[0], c.m128_f32[0]);
 	}
 	DLL Mat44 Mat44Scale(const float x, const float y, const float z)
 	{
@@ -649,46 +993,21 @@ extern "C"
 	}
 	DLL Mat44 Mat44Mul(const Mat44 rhs, const Mat44 lhs)
 	{
-		Mat44 m;
-
-		m.col0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.col0, _mm_swizzle_ps_0(rhs.col0)),
-			_mm_mul_ps(lhs.col1, _mm_swizzle_ps_1(rhs.col0))),
-			_mm_add_ps(_mm_mul_ps(lhs.col2, _mm_swizzle_ps_2(rhs.col0)),
-				_mm_mul_ps(lhs.col3, _mm_swizzle_ps_3(rhs.col0))));
-
-		m.col1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.col0, _mm_swizzle_ps_0(rhs.col1)),
-			_mm_mul_ps(lhs.col1, _mm_swizzle_ps_1(rhs.col1))),
-			_mm_add_ps(_mm_mul_ps(lhs.col2, _mm_swizzle_ps_2(rhs.col1)),
-				_mm_mul_ps(lhs.col3, _mm_swizzle_ps_3(rhs.col1))));
-
-		m.col2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.col0, _mm_swizzle_ps_0(rhs.col2)),
-			_mm_mul_ps(lhs.col1, _mm_swizzle_ps_1(rhs.col2))),
-			_mm_add_ps(_mm_mul_ps(lhs.col2, _mm_swizzle_ps_2(rhs.col2)),
-				_mm_mul_ps(lhs.col3, _mm_swizzle_ps_3(rhs.col2))));
-
-		m.col3 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lhs.col0, _mm_swizzle_ps_0(rhs.col3)),
-			_mm_mul_ps(lhs.col1, _mm_swizzle_ps_1(rhs.col3))),
-			_mm_add_ps(_mm_mul_ps(lhs.col2, _mm_swizzle_ps_2(rhs.col3)),
-				_mm_mul_ps(lhs.col3, _mm_swizzle_ps_3(rhs.col3))));
-
-		return m;
+		return DISPATCH(Mat44Mul)(rhs, lhs);
 	}
 	DLL Mat44 Mat44Rotate(const float radiansX, const float radiansY, const float radiansZ, const ERotateOrder rotateOrder)
 	{
-		// TODO: we can probably optimize this, even if it's just a giant switch statement with all the operations inlined & hoping that that results in better compiler optimization
-		Mat44 rotations[] = { Mat44RotateX(radiansX), Mat44RotateY(radiansY), Mat44RotateZ(radiansZ) };
-		int ro = (int)rotateOrder;
-		return Mat44Mul(Mat44Mul(rotations[(ro >> 4)], rotations[(ro >> 2) & 0b11]), rotations[ro & 0b11]);
+		return _Mat44Rotate(_mm_set_ps(0.0f, radiansZ, radiansY, radiansX), rotateOrder);
 	}
 	DLL Mat44 Mat44Rotate2(const __m128 radians, const ERotateOrder rotateOrder)
 	{
 		// overloads for Mat44Rotate
-		return Mat44Rotate(radians.m128_f32[0], radians.m128_f32[1], radians.m128_f32[2], rotateOrder);
+		return _Mat44Rotate(radians, rotateOrder);
 	}
 	DLL Mat44 EulerToMat44(const __m128 radians, const ERotateOrder rotateOrder)
 	{
 		// alias for Mat44Rotate2
-		return Mat44Rotate(radians.m128_f32[0], radians.m128_f32[1], radians.m128_f32[2], rotateOrder);
+		return _Mat44Rotate(radians, rotateOrder);
 	}
 
 	// general mat44 inverse, use the faster versions if you can, it can save over 60%!
@@ -720,21 +1039,12 @@ extern "C"
 	}
 	DLL Vec Mat44VectorTransform(const Mat44 m, const __m128 v)
 	{
-		// Note: set v.w to 0 to ignore translation
-		return { _mm_add_ps(_mm_add_ps(_mm_mul_ps(m.col0, _mm_swizzle_ps_0(v)),
-			_mm_mul_ps(m.col1, _mm_swizzle_ps_1(v))),
-			_mm_add_ps(_mm_mul_ps(m.col2, _mm_swizzle_ps_2(v)),
-				_mm_mul_ps(m.col3, _mm_swizzle_ps_3(v)))) };
+		return DISPATCH(Mat44VectorTransform)(m, v);
 	}
 
-	// TODO: rotate order support
 	DLL Vec Mat44ToEuler(const Mat44 m, const ERotateOrder ro)
 	{
-		/*
-		TODO:
-		There is something off with these results but I'm not sure
-		if the cause is Mat44ToQuat or QuatToEuler
-		*/
+		// Closed form inverse of Mat44Rotate, going through Mat44ToQuat and QuatToEuler did not round trip.
 #if 0
 		// https://www.euclideanspace.com/maths/geometry/rotations/conversions/matrixToEuler/index.htm
 		// This is decomposed with ERotateOrder::XZY
@@ -761,8 +1071,7 @@ extern "C"
 			return { _mm_set_ps(0.0f, attitude, heading, bank) };
 		}
 #endif
-		Quat q = Mat44ToQuat(m);
-		return QuatToEuler(q, ro);
+		return _Mat44ToEuler(m, ro);
 #if 0
 		// We only need 5 matrix values to decompose the matrix
 		// which depend on the rotate order, so let's get some indices  to help
@@ -883,7 +1192,9 @@ extern "C"
 	DLL Mat44 Mat44AxisAngle(const __m128 axis, const float radians)
 	{
 		// https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glRotate.xml
-		return _Mat44AxisAngle(axis, cosf(radians), sinf(radians));
+		__m128 s, c;
+		_mm_sincos_ps(_mm_set_ss(radians), &s, &c);
+		return _Mat44AxisAngle(axis, c.m128_f32[0], s.m128_f32[0]);
 	}
 	DLL Mat44 Mat44Align(const __m128 from, const __m128 to)
 	{
@@ -930,30 +1241,32 @@ extern "C"
 	}
 	DLL Mat44 Mat44TranslateRotate(const float x, const float y, const float z, const float radiansX, const float radiansY, const float radiansZ, const ERotateOrder rotateOrder)
 	{
-		Mat44 r = Mat44Rotate(radiansX, radiansY, radiansZ, rotateOrder);
+		Mat44 r = _Mat44Rotate(_mm_set_ps(0.0f, radiansZ, radiansY, radiansX), rotateOrder);
 		r.col3 = _mm_set_ps(1.0f, z, y, x);
 		return r;
 	}
 	DLL Mat44 Mat44TranslateRotate2(const __m128 translate, const __m128 radians, const ERotateOrder rotateOrder)
 	{
-		Mat44 r = Mat44Rotate2(radians, rotateOrder);
+		Mat44 r = _Mat44Rotate(radians, rotateOrder);
 		r.col3 = _mm_add_ps(_mm_mul_ps(translate, F32_VEC3_MASK), F32_UNIT_W); // translate.w = translate.w * 0 + 1
 		return r;
 	}
 	DLL Mat44 Mat44TRS(const float x, const float y, const float z, const float radiansX, const float radiansY, const float radiansZ, const float scaleX, const float scaleY, const float scaleZ, const ERotateOrder rotateOrder)
 	{
-		Mat44 r = Mat44TranslateRotate(x, y, z, radiansX, radiansY, radiansZ, rotateOrder);
+		Mat44 r = _Mat44Rotate(_mm_set_ps(0.0f, radiansZ, radiansY, radiansX), rotateOrder);
 		r.col0 = _mm_mul_ps(r.col0, _mm_set_ps1(scaleX));
 		r.col1 = _mm_mul_ps(r.col1, _mm_set_ps1(scaleY));
 		r.col2 = _mm_mul_ps(r.col2, _mm_set_ps1(scaleZ));
+		r.col3 = _mm_set_ps(1.0f, z, y, x);
 		return r;
 	}
 	DLL Mat44 Mat44TRS2(const __m128 translate, const __m128 radians, const __m128 scale, const ERotateOrder rotateOrder)
 	{
-		Mat44 r = Mat44TranslateRotate2(translate, radians, rotateOrder);
-		r.col0 = _mm_mul_ps(r.col0, _mm_set_ps1(scale.m128_f32[0]));
-		r.col1 = _mm_mul_ps(r.col1, _mm_set_ps1(scale.m128_f32[1]));
-		r.col2 = _mm_mul_ps(r.col2, _mm_set_ps1(scale.m128_f32[2]));
+		Mat44 r = _Mat44Rotate(radians, rotateOrder);
+		r.col0 = _mm_mul_ps(r.col0, _mm_swizzle_ps_0(scale));
+		r.col1 = _mm_mul_ps(r.col1, _mm_swizzle_ps_1(scale));
+		r.col2 = _mm_mul_ps(r.col2, _mm_swizzle_ps_2(scale));
+		r.col3 = _mm_add_ps(_mm_mul_ps(translate, F32_VEC3_MASK), F32_UNIT_W); // translate.w = translate.w * 0 + 1
 		return r;
 	}
 	DLL Mat44 Mat44Parented(const Mat44 child, const Mat44 parent)
@@ -961,6 +1274,58 @@ extern "C"
 		// The whole point is that it is an alias of Mat44Mul with the SAME ARGUMENT ORDER and the argument names help remind us how it works
 		return Mat44Mul(child, parent);
 	}
+	DLL void Mat44MulArray(const Mat44* children, const Mat44* parents, Mat44* result, const unsigned int count)
+	{
+		auto kernel = DISPATCH(Mat44MulArray);
+		ParallelFor(0, count, ParallelGrain(8192), [&](const unsigned int begin, const unsigned int end)
+		{
+			kernel(children + begin, parents + begin, result + begin, end - begin);
+		});
+	}
+	DLL void Mat44InversedArray(const Mat44* matrices, Mat44* result, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = GetInverse(matrices[i]);
+	}
+	DLL void Mat44InversedCheckedArray(const Mat44* matrices, const float epsilon, Mat44* result, float* determinants, unsigned char* singular, const unsigned int count)
+	{
+		DISPATCH(Mat44InversedCheckedArray)(matrices, epsilon, result, determinants, singular, count);
+	}
+	DLL void Mat44VectorTransformArray(const Mat44 m, const __m128* vectors, Vec* result, const unsigned int count)
+	{
+		// Resolve the kernel once instead of per vector
+		auto kernel = DISPATCH(Mat44VectorTransform);
+		ParallelFor(0, count, ParallelGrain(32768), [&](const unsigned int begin, const unsigned int end)
+		{
+			for (unsigned int i = begin; i < end; ++i)
+				result[i] = kernel(m, vectors[i]);
+		});
+	}
+	DLL void Mat44TRSArray(const __m128* translates, const __m128* radians, const __m128* scales, const ERotateOrder rotateOrder, Mat44* result, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = Mat44TRS2(translates[i], radians[i], scales[i], rotateOrder);
+	}
+	DLL void Mat44ToTRSArray(const Mat44* matrices, const ERotateOrder rotateOrder, Vec* translates, Vec* radians, Vec* scales, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const Mat44& m = matrices[i];
+			const Vec scale = Mat44ToScale(m);
+			// 1 / scale, with 0 instead of inf for collapsed axes
+			const __m128 inverseScale = _mm_and_ps(_mm_div_ps(F32_ONE, scale.s), _mm_cmpgt_ps(scale.s, _mm_setzero_ps()));
+			Mat44 rotation;
+			rotation.col0 = _mm_mul_ps(m.col0, _mm_swizzle_ps_0(inverseScale));
+			rotation.col1 = _mm_mul_ps(m.col1, _mm_swizzle_ps_1(inverseScale));
+			rotation.col2 = _mm_mul_ps(m.col2, _mm_swizzle_ps_2(inverseScale));
+			rotation.col3 = F32_UNIT_W;
+			// Write the results last, so the outputs may alias the matrices
+			const Vec translate = Mat44ToTranslate(m);
+			radians[i] = _Mat44ToEuler(rotation, rotateOrder);
+			translates[i] = translate;
+			scales[i] = scale;
+		}
+	}
 
 	// Matrix validation
 	// We return 0 bit if validation passed on check not requested, so basically  if the result is 0 you're good and else you can use the enum to find out what validation failed.
@@ -92,7 +92,18 @@ extern "C"
 	DLL Mat44 Mat44TRS2(const __m128 translate, const __m128 radians, const __m128 scale, const ERotateOrder rotateOrder);
 	// The whole point is that it is an alias of Mat44Mul with the SAME ARGUMENT ORDER and the argument names help remind us how it works
 	DLL Mat44 Mat44Parented(const Mat44 child, const Mat44 parent);
-	// TODO: euler decomposition rotate order support
+	// Batch version of Mat44Parented, result[i] = Mat44Mul(children[i], parents[i]), result may alias either input
+	DLL void Mat44MulArray(const Mat44* children, const Mat44* parents, Mat44* result, const unsigned int count);
+	// More batch versions, mostly so bindings can hand over a whole buffer in a single call, result may alias the matrices
+	DLL void Mat44InversedArray(const Mat44* matrices, Mat44* result, const unsigned int count);
+	// Checked batch inverse for solvers, 4 or 8 matrices at a time in SoA form. Also writes determinants[i] = Mat44Determinant(matrices[i])
+	// and sets bit i % 8 of singular[i / 8] when matrix i is singular, not finite or ill-conditioned, which means that
+	// 1 / (|m| * |inverse|) < epsilon in the Frobenius norm (at most 0.25, for orthonormal matrices), 1e-6 is a good start.
+	// The inverse of a flagged matrix is all zeros. singular must hold (count + 7) / 8 bytes, result may alias the matrices.
+	DLL void Mat44InversedCheckedArray(const Mat44* matrices, const float epsilon, Mat44* result, float* determinants, unsigned char* singular, const unsigned int count);
+	DLL void Mat44VectorTransformArray(const Mat44 m, const __m128* vectors, Vec* result, const unsigned int count); // one matrix, many vectors
+	DLL void Mat44TRSArray(const __m128* translates, const __m128* radians, const __m128* scales, const ERotateOrder rotateOrder, Mat44* result, const unsigned int count);
+	DLL void Mat44ToTRSArray(const Mat44* matrices, const ERotateOrder rotateOrder, Vec* translates, Vec* radians, Vec* scales, const unsigned int count); // assumes no shear, zero scale axes get zero rotation
 	DLL Mat44ValidationFlags Mat44Validate(const Mat44 m, const Mat44ValidationFlags flags, const float epsilon); // useful for throwing warnings
 	DLL Mat44 Mat44MakeValid(const Mat44 m, const Mat44ValidationFlags flags); // useful for rectifying warnings (at the cost of being fairly slow)
 	DLL Vec Mat44ToScale(const Mat44 m); // decompose scale
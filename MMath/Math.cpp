@@ -14,11 +14,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "SIMD.h"
 #include <math.h>
 
-DLL const float PI = 3.14159265358979323846f;
-DLL const float HALF_PI = PI * 0.5f;
-DLL const float TAU = PI + PI;
-DLL const float DEG2RAD = PI / 180.0f;
-DLL const float RAD2DEG = 180.0f / PI;
+DLL_CONST const float PI = 3.14159265358979323846f;
+DLL_CONST const float HALF_PI = PI * 0.5f;
+DLL_CONST const float TAU = PI + PI;
+DLL_CONST const float DEG2RAD = PI / 180.0f;
+DLL_CONST const float RAD2DEG = 180.0f / PI;
 
 DLL float Min(const float a, const float b) { return (a < b) ? a : b; }
 DLL float Max(const float a, const float b) { return (a > b) ? a : b; }
@@ -39,11 +39,11 @@ DLL float AngleDelta(const float a, const float b) { return Mod(b - a + HALF_PI,
 DLL float LerpAngle(const float a, const float b, const float t) { return a + AngleDelta(a, b) * t; }
 DLL float InverseLerpAngle(const float a, const float b, const float v) { return AngleDelta(a, v) / AngleDelta(a, b); }
 
-DLL const __m128 F32_PI = _mm_set_ps1(3.14159265359f);
-DLL const __m128 F32_HALF_PI = _mm_set_ps1(PI * 0.5f);
-DLL const __m128 F32_TAU = _mm_set_ps1(PI + PI);
-DLL const __m128 F32_DEG2RAD = _mm_set_ps1(PI / 180.0f);
-DLL const __m128 F32_RAD2DEG = _mm_set_ps1(180.0f / PI);
+DLL_CONST const __m128 F32_PI = _mm_set_ps1(3.14159265359f);
+DLL_CONST const __m128 F32_HALF_PI = _mm_set_ps1(PI * 0.5f);
+DLL_CONST const __m128 F32_TAU = _mm_set_ps1(PI + PI);
+DLL_CONST const __m128 F32_DEG2RAD = _mm_set_ps1(PI / 180.0f);
+DLL_CONST const __m128 F32_RAD2DEG = _mm_set_ps1(180.0f / PI);
 
 // DLL __m128 Min(__m128 a, __m128 b) { return _mm_min_ps(a, b); }
 // DLL __m128 Max(__m128 a, __m128 b) { return _mm_max_ps(a, b); }
@@ -0,0 +1,283 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Parallel.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+// The chunks one thread has left, first in the low and end in the high 32 bits so the owner taking one from the
+// front and a thief taking half from the back race on a single compare exchange. One cache line each.
+struct alignas(64) _ParallelRange
+{
+	std::atomic<unsigned long long> chunks;
+};
+
+struct _ParallelPool
+{
+	std::atomic<unsigned int> threadCount{ 0 }; // including the caller, 0 until the pool is started
+	std::vector<std::thread> workers;
+	std::vector<_ParallelRange> ranges;
+	std::atomic<unsigned int> grain{ 0 };
+
+	// One ParallelRun at a time, see ParallelRun
+	std::mutex running;
+
+	// The current job, written before generation is bumped
+	ParallelKernel kernel = nullptr;
+	void* context = nullptr;
+	unsigned int begin = 0;
+	unsigned int end = 0;
+	unsigned int jobGrain = 1;
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	unsigned long long generation = 0;
+	bool quit = false;
+	std::atomic<unsigned int> busy{ 0 }; // workers that have not finished the current job
+};
+
+// Never destroyed, joining threads from a static destructor would happen under the loader lock
+DLL_INTERNAL _ParallelPool& _ParallelInstance()
+{
+	static _ParallelPool* pool = new _ParallelPool();
+	return *pool;
+}
+
+// Set on the workers and on the caller while it helps out, so kernels that call ParallelRun again run inline
+DLL_INTERNAL bool& _ParallelInside()
+{
+	static thread_local bool inside = false;
+	return inside;
+}
+
+static bool _ParallelPop(_ParallelRange& range, unsigned int& chunk)
+{
+	unsigned long long chunks = range.chunks.load();
+	for (;;)
+	{
+		const unsigned int first = (unsigned int)chunks, last = (unsigned int)(chunks >> 32);
+		if (first >= last)
+			return false;
+		if (range.chunks.compare_exchange_weak(chunks, ((unsigned long long)last << 32) | (first + 1)))
+		{
+			chunk = first;
+			return true;
+		}
+	}
+}
+
+// Moves the back half of victim's chunks to thief, whose range must be empty
+static bool _ParallelSteal(_ParallelRange& victim, _ParallelRange& thief)
+{
+	unsigned long long chunks = victim.chunks.load();
+	for (;;)
+	{
+		const unsigned int first = (unsigned int)chunks, last = (unsigned int)(chunks >> 32);
+		if (first >= last)
+			return false;
+		const unsigned int middle = first + (last - first) / 2;
+		if (victim.chunks.compare_exchange_weak(chunks, ((unsigned long long)middle << 32) | first))
+		{
+			thief.chunks.store(((unsigned long long)last << 32) | middle);
+			return true;
+		}
+	}
+}
+
+static void _ParallelWork(_ParallelPool& pool, const unsigned int self)
+{
+	_ParallelRange& own = pool.ranges[self];
+	const unsigned int threads = pool.threadCount;
+	for (unsigned int victim = self;;)
+	{
+		unsigned int chunk;
+		while (_ParallelPop(own, chunk))
+		{
+			const unsigned int chunkBegin = pool.begin + chunk * pool.jobGrain;
+			pool.kernel(pool.context, chunkBegin, pool.end - chunkBegin < pool.jobGrain ? pool.end : chunkBegin + pool.jobGrain);
+		}
+		// Out of work, go round the other threads once starting after the last one robbed
+		unsigned int tries = 1;
+		for (; tries < threads; ++tries)
+		{
+			victim = (victim + 1) % threads;
+			if (victim != self && _ParallelSteal(pool.ranges[victim], own))
+				break;
+		}
+		if (tries == threads)
+			return;
+	}
+}
+
+// Logical processors are numbered group by group, machines with more than 64 of them have several groups
+static void _ParallelPin(std::thread& thread, unsigned int processor)
+{
+	const WORD groups = GetActiveProcessorGroupCount();
+	for (WORD group = 0; group < groups; ++group)
+	{
+		const DWORD count = GetActiveProcessorCount(group);
+		if (processor < count)
+		{
+			GROUP_AFFINITY affinity = {};
+			affinity.Group = group;
+			affinity.Mask = (KAFFINITY)1 << processor;
+			SetThreadGroupAffinity(thread.native_handle(), &affinity, nullptr);
+			return;
+		}
+		processor -= count;
+	}
+}
+
+static void _ParallelWorker(_ParallelPool& pool, const unsigned int self)
+{
+	_ParallelInside() = true;
+	unsigned long long seen = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(pool.mutex);
+			pool.wake.wait(lock, [&]() { return pool.quit || pool.generation != seen; });
+			if (pool.quit)
+				return;
+			seen = pool.generation;
+		}
+		_ParallelWork(pool, self);
+		if (pool.busy.fetch_sub(1) == 1)
+		{
+			std::lock_guard<std::mutex> lock(pool.mutex);
+			pool.done.notify_one();
+		}
+	}
+}
+
+// Call with pool.running held
+static void _ParallelStart(_ParallelPool& pool, unsigned int count)
+{
+	if (pool.threadCount)
+	{
+		{
+			std::lock_guard<std::mutex> lock(pool.mutex);
+			pool.quit = true;
+		}
+		pool.wake.notify_all();
+		for (std::thread& worker : pool.workers)
+			worker.join();
+		pool.workers.clear();
+		pool.quit = false;
+	}
+	if (count == 0)
+		count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+	pool.threadCount = count ? count : 1;
+	pool.ranges = std::vector<_ParallelRange>(count ? count : 1);
+	for (unsigned int t = 1; t < count; ++t)
+	{
+		pool.workers.emplace_back(_ParallelWorker, std::ref(pool), t);
+		_ParallelPin(pool.workers.back(), t);
+	}
+}
+
+extern "C"
+{
+	DLL void ParallelRun(const unsigned int begin, const unsigned int end, const unsigned int grain, const ParallelKernel kernel, void* context)
+	{
+		if (end <= begin)
+			return;
+		const unsigned int jobGrain = grain ? grain : 1;
+		const unsigned int chunkCount = (end - begin - 1) / jobGrain + 1;
+		_ParallelPool& pool = _ParallelInstance();
+		std::unique_lock<std::mutex> running(pool.running, std::defer_lock);
+		if (chunkCount == 1 || _ParallelInside() || !running.try_lock())
+		{
+			kernel(context, begin, end);
+			return;
+		}
+		if (!pool.threadCount)
+			_ParallelStart(pool, 0);
+		const unsigned int threads = pool.threadCount;
+		if (threads == 1)
+		{
+			kernel(context, begin, end);
+			return;
+		}
+
+		// Equal shares up front, stealing evens out the rest
+		pool.kernel = kernel;
+		pool.context = context;
+		pool.begin = begin;
+		pool.end = end;
+		pool.jobGrain = jobGrain;
+		for (unsigned int t = 0; t < threads; ++t)
+		{
+			const unsigned long long first = (unsigned long long)chunkCount * t / threads;
+			const unsigned long long last = (unsigned long long)chunkCount * (t + 1) / threads;
+			pool.ranges[t].chunks.store((last << 32) | first);
+		}
+		pool.busy = threads - 1;
+		{
+			std::lock_guard<std::mutex> lock(pool.mutex);
+			++pool.generation;
+		}
+		pool.wake.notify_all();
+
+		_ParallelInside() = true;
+		_ParallelWork(pool, 0);
+		_ParallelInside() = false;
+		std::unique_lock<std::mutex> lock(pool.mutex);
+		pool.done.wait(lock, [&]() { return pool.busy == 0; });
+	}
+	DLL void ParallelSetThreadCount(const unsigned int count)
+	{
+		// The pool is busy running the caller, waiting for it would never return
+		if (_ParallelInside())
+		{
+#if _DEBUG
+			__debugbreak();
+#endif
+			return;
+		}
+		_ParallelPool& pool = _ParallelInstance();
+		std::lock_guard<std::mutex> running(pool.running);
+		_ParallelStart(pool, count);
+	}
+	DLL unsigned int ParallelThreadCount()
+	{
+		// Only locks to start the pool, so kernels can ask too
+		_ParallelPool& pool = _ParallelInstance();
+		if (!pool.threadCount)
+		{
+			std::lock_guard<std::mutex> running(pool.running);
+			if (!pool.threadCount)
+				_ParallelStart(pool, 0);
+		}
+		return pool.threadCount;
+	}
+	DLL void ParallelSetGrain(const unsigned int grain)
+	{
+		_ParallelInstance().grain = grain;
+	}
+	DLL unsigned int ParallelGrain(const unsigned int defaultGrain)
+	{
+		const unsigned int grain = _ParallelInstance().grain;
+		return grain ? grain : defaultGrain;
+	}
+}
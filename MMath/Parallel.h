@@ -0,0 +1,42 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+extern "C"
+{
+	// Runs kernel(context, chunkBegin, chunkEnd) for consecutive chunks of grain elements that together cover [begin, end),
+	// on the calling thread and the worker threads of the pool. Every chunk starts at begin plus a multiple of grain.
+	// Each thread works through its own share of the chunks and then steals half of what another thread has left.
+	// Runs everything on the calling thread in a single kernel(context, begin, end) call when there is only one chunk or one thread,
+	// when called from inside a kernel, or when another thread is using the pool. Nothing is allocated per call, the pool is started on first use.
+	typedef void(*ParallelKernel)(void* context, const unsigned int chunkBegin, const unsigned int chunkEnd);
+	DLL void ParallelRun(const unsigned int begin, const unsigned int end, const unsigned int grain, const ParallelKernel kernel, void* context);
+
+	// Threads including the calling one, 0 (the default) uses every logical processor and 1 turns threading off.
+	// Worker i is pinned to logical processor i, so the calling thread is best kept on processor 0.
+	// Must not be called from inside a kernel, that breaks into the debugger in debug builds and is ignored otherwise.
+	DLL void ParallelSetThreadCount(const unsigned int count);
+	DLL unsigned int ParallelThreadCount();
+	// Overrides the grain of our own batch kernels (Mat44MulArray, skinning, culling, ...), 0 restores their defaults.
+	// Each default is about 50 microseconds of work, enough to hide waking up a worker.
+	DLL void ParallelSetGrain(const unsigned int grain);
+	DLL unsigned int ParallelGrain(const unsigned int defaultGrain); // what a batch kernel with this default grain uses
+}
+
+// ParallelRun for a lambda, fn(chunkBegin, chunkEnd). The lambda is passed by pointer so it may capture anything.
+template<typename F>
+inline void ParallelFor(const unsigned int begin, const unsigned int end, const unsigned int grain, const F& fn)
+{
+	ParallelRun(begin, end, grain, [](void* context, const unsigned int chunkBegin, const unsigned int chunkEnd) { (*(const F*)context)(chunkBegin, chunkEnd); }, (void*)&fn);
+}
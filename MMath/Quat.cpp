@@ -15,10 +15,180 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "MMath.h"
 #include "Vector.h"
 #include "Enums.h"
+#include "Dispatch.h"
 #include <math.h>
 
-static const __m128 F32_SIGNFLIP_1110 = { -1.0f, -1.0f, -1.0f, 1.0f };
-static const __m128 F32_SIGNFLIP_1001 = { -1.0f, 1.0f, 1.0f, -1.0f };
+Quat _QuatMulSSE(const Quat lhs, const Quat rhs)
+{
+#if 0
+	// https://www.euclideanspace.com/maths/algebra/realNormedAlgebra/quaternions/arithmetic/index.htm
+	return { rhs.w * lhs.x + rhs.x * lhs.w + rhs.y * lhs.z - rhs.z * lhs.y,
+			 rhs.w * lhs.y - rhs.x * lhs.z + rhs.y * lhs.w + rhs.z * lhs.x,
+			 rhs.w * lhs.z + rhs.x * lhs.y - rhs.y * lhs.x + rhs.z * lhs.w,
+			 rhs.w * lhs.w - rhs.x * lhs.x - rhs.y * lhs.y - rhs.z * lhs.z };
+#endif
+
+#if 1
+	__m128 x = _mm_mul_ps(F32_SIGNFLIP_0101, _mm_mul_ps(_mm_swizzle_ps_3210(lhs.q), _mm_swizzle_ps_0(rhs.q)));
+	__m128 y = _mm_mul_ps(F32_SIGNFLIP_0011, _mm_mul_ps(_mm_swizzle_ps_2301(lhs.q), _mm_swizzle_ps_1(rhs.q)));
+	__m128 z = _mm_mul_ps(F32_SIGNFLIP_1001, _mm_mul_ps(_mm_swizzle_ps_1032(lhs.q), _mm_swizzle_ps_2(rhs.q)));
+	__m128 w = _mm_mul_ps(lhs.q, _mm_swizzle_ps_3(rhs.q));
+	return { _mm_add_ps(_mm_add_ps(x, y), _mm_add_ps(z, w)) };
+#endif
+
+#if 0
+	// https://github.com/Autodesk/animx/blob/master/src/internal/Tquaternion.h
+	Quat result;
+	result.x = rhs.w * lhs.x + rhs.x * lhs.w + rhs.y * lhs.z - rhs.z * lhs.y;
+	result.y = rhs.w * lhs.y + rhs.y * lhs.w + rhs.z * lhs.x - rhs.x * lhs.z;
+	result.z = rhs.w * lhs.z + rhs.z * lhs.w + rhs.x * lhs.y - rhs.y * lhs.x;
+	result.w = rhs.w * lhs.w - rhs.x * lhs.x - rhs.y * lhs.y - rhs.z * lhs.z;
+	return result;
+#endif
+}
+
+// Blends 4 quaternion pairs in SoA form (x, y, z, w hold one component of 4 quaternions), a is overwritten with the result.
+// SLERP selects slerp or nlerp, CORRECTED adjusts t so nlerp follows slerp more closely
+// (https://zeux.io/2015/07/23/approximating-slerp/).
+template<bool SLERP, bool CORRECTED>
+__forceinline void _QuatBlend4(__m128& ax, __m128& ay, __m128& az, __m128& aw, __m128 bx, __m128 by, __m128 bz, __m128 bw, __m128 t)
+{
+	// Always take the shortest path, flip b where the dot product is negative
+	__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+	const __m128 sign = _mm_and_ps(d, _mm_castsi128_ps(_mm_set1_epi32(0x80000000)));
+	d = _mm_xor_ps(d, sign);
+	bx = _mm_xor_ps(bx, sign);
+	by = _mm_xor_ps(by, sign);
+	bz = _mm_xor_ps(bz, sign);
+	bw = _mm_xor_ps(bw, sign);
+
+	__m128 wa, wb;
+	if (SLERP)
+	{
+		const __m128 omega = _mm_arccos_ps(d);
+		const __m128 invSinOmega = _mm_div_ps(F32_ONE, _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(F32_ONE, _mm_mul_ps(d, d)), F32_ZERO)));
+		__m128 sa, sb, c;
+		_mm_sincos_ps(_mm_mul_ps(omega, _mm_sub_ps(F32_ONE, t)), &sa, &c);
+		_mm_sincos_ps(_mm_mul_ps(omega, t), &sb, &c);
+		// lanes that are too close get linear weights, the normalization below takes care of the rest
+		const __m128 linear = _mm_cmpgt_ps(d, _mm_set_ps1(QUAT_SLERP_LINEAR_THRESHOLD));
+		wa = _mm_blendv_ps(_mm_mul_ps(sa, invSinOmega), _mm_sub_ps(F32_ONE, t), linear);
+		wb = _mm_blendv_ps(_mm_mul_ps(sb, invSinOmega), t, linear);
+	}
+	else
+	{
+		if (CORRECTED)
+		{
+			// t' = t + t * (t - 0.5) * (t - 1) * k, with k fitted as a function of the cosine
+			const __m128 A = _mm_add_ps(_mm_set_ps1(1.0904f), _mm_mul_ps(d, _mm_add_ps(_mm_set_ps1(-3.2452f), _mm_mul_ps(d, _mm_sub_ps(_mm_set_ps1(3.55645f), _mm_mul_ps(d, _mm_set_ps1(1.43519f)))))));
+			const __m128 B = _mm_add_ps(_mm_set_ps1(0.848013f), _mm_mul_ps(d, _mm_add_ps(_mm_set_ps1(-1.06021f), _mm_mul_ps(d, _mm_set_ps1(0.215638f)))));
+			const __m128 th = _mm_sub_ps(t, _mm_set_ps1(0.5f));
+			const __m128 k = _mm_add_ps(_mm_mul_ps(A, _mm_mul_ps(th, th)), B);
+			t = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(t, th), _mm_mul_ps(_mm_sub_ps(t, F32_ONE), k)));
+		}
+		wa = _mm_sub_ps(F32_ONE, t);
+		wb = t;
+	}
+
+	ax = _mm_add_ps(_mm_mul_ps(ax, wa), _mm_mul_ps(bx, wb));
+	ay = _mm_add_ps(_mm_mul_ps(ay, wa), _mm_mul_ps(by, wb));
+	az = _mm_add_ps(_mm_mul_ps(az, wa), _mm_mul_ps(bz, wb));
+	aw = _mm_add_ps(_mm_mul_ps(aw, wa), _mm_mul_ps(bw, wb));
+	const __m128 invLength = _mm_div_ps(F32_ONE, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), _mm_add_ps(_mm_mul_ps(az, az), _mm_mul_ps(aw, aw)))));
+	ax = _mm_mul_ps(ax, invLength);
+	ay = _mm_mul_ps(ay, invLength);
+	az = _mm_mul_ps(az, invLength);
+	aw = _mm_mul_ps(aw, invLength);
+}
+
+// Transposes 4 pairs to SoA, blends them and transposes back
+template<bool SLERP, bool CORRECTED>
+__forceinline void _QuatBlendBlockSSE(const Quat* a, const Quat* b, const float* t, Quat* result)
+{
+	__m128 ax = a[0].q, ay = a[1].q, az = a[2].q, aw = a[3].q;
+	__m128 bx = b[0].q, by = b[1].q, bz = b[2].q, bw = b[3].q;
+	_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+	_MM_TRANSPOSE4_PS(bx, by, bz, bw);
+	_QuatBlend4<SLERP, CORRECTED>(ax, ay, az, aw, bx, by, bz, bw, _mm_loadu_ps(t));
+	_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+	result[0].q = ax;
+	result[1].q = ay;
+	result[2].q = az;
+	result[3].q = aw;
+}
+
+// Partial blocks at the end go through a copy padded with identities
+template<bool SLERP, bool CORRECTED>
+__forceinline void _QuatBlendArraySSE(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count)
+{
+	unsigned int i = 0;
+	for (; i + 4 <= count; i += 4)
+		_QuatBlendBlockSSE<SLERP, CORRECTED>(a + i, b + i, t + i, result + i);
+	if (i < count)
+	{
+		Quat pa[4] = { { F32_UNIT_W }, { F32_UNIT_W }, { F32_UNIT_W }, { F32_UNIT_W } };
+		Quat pb[4] = { { F32_UNIT_W }, { F32_UNIT_W }, { F32_UNIT_W }, { F32_UNIT_W } };
+		float pt[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		for (unsigned int j = 0; j < count - i; ++j)
+		{
+			pa[j] = a[i + j];
+			pb[j] = b[i + j];
+			pt[j] = t[i + j];
+		}
+		_QuatBlendBlockSSE<SLERP, CORRECTED>(pa, pb, pt, pa);
+		for (unsigned int j = 0; j < count - i; ++j)
+			result[i + j] = pa[j];
+	}
+}
+
+void _QuatSlerpArraySSE(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count)
+{
+	_QuatBlendArraySSE<true, false>(a, b, t, result, count);
+}
+
+void _QuatNlerpArraySSE(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count, const bool corrected)
+{
+	if (corrected)
+		_QuatBlendArraySSE<false, true>(a, b, t, result, count);
+	else
+		_QuatBlendArraySSE<false, false>(a, b, t, result, count);
+}
+
+// Normalizes 4 quaternions in SoA form, zero length ones become the fallback
+template<ENormalizeMode MODE>
+__forceinline void _QuatNormalizedBlock(const Quat* quats, __m128 fallback, Quat* result)
+{
+	__m128 x = quats[0].q, y = quats[1].q, z = quats[2].q, w = quats[3].q;
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+	const __m128 sqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+	x = _mm_mul_rsqrt_ps<MODE>(x, sqr);
+	y = _mm_mul_rsqrt_ps<MODE>(y, sqr);
+	z = _mm_mul_rsqrt_ps<MODE>(z, sqr);
+	w = _mm_mul_rsqrt_ps<MODE>(w, sqr);
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+	const __m128 isZero = _mm_cmpeq_ps(sqr, F32_ZERO);
+	result[0].q = _mm_blendv_ps(x, fallback, _mm_swizzle_ps_0(isZero));
+	result[1].q = _mm_blendv_ps(y, fallback, _mm_swizzle_ps_1(isZero));
+	result[2].q = _mm_blendv_ps(z, fallback, _mm_swizzle_ps_2(isZero));
+	result[3].q = _mm_blendv_ps(w, fallback, _mm_swizzle_ps_3(isZero));
+}
+
+template<ENormalizeMode MODE>
+void _QuatNormalizedArray(const Quat* quats, const __m128 fallback, Quat* result, const unsigned int count)
+{
+	unsigned int i = 0;
+	for (; i + 4 <= count; i += 4)
+		_QuatNormalizedBlock<MODE>(quats + i, fallback, result + i);
+	if (i < count)
+	{
+		Quat p[4] = { { F32_UNIT_W }, { F32_UNIT_W }, { F32_UNIT_W }, { F32_UNIT_W } };
+		for (unsigned int j = 0; j < count - i; ++j)
+			p[j] = quats[i + j];
+		_QuatNormalizedBlock<MODE>(p, fallback, p);
+		for (unsigned int j = 0; j < count - i; ++j)
+			result[i + j] = p[j];
+	}
+}
 
 extern "C"
 {
@@ -28,52 +198,31 @@ extern "C"
 	}
 	DLL Quat QuatRotateX(const float _radians)
 	{
-		float radians = _radians * 0.5f;
-		float sa = sinf(radians);
-		float ca = cosf(radians);
+		__m128 s, c;
+		_mm_sincos_ps(_mm_set_ss(_radians * 0.5f), &s, &c);
+		float sa = s.m128_f32[0];
+		float ca = c.m128_f32[0];
 		return { _mm_set_ps(ca, 0.0f, 0.0f, sa) };
 	}
 	DLL Quat QuatRotateY(const float _radians)
 	{
-		float radians = _radians * 0.5f;
-		float sa = sinf(radians);
-		float ca = cosf(radians);
+		__m128 s, c;
+		_mm_sincos_ps(_mm_set_ss(_radians * 0.5f), &s, &c);
+		float sa = s.m128_f32[0];
+		float ca = c.m128_f32[0];
 		return { _mm_set_ps(ca, 0.0f, sa, 0.0f) };
 	}
 	DLL Quat QuatRotateZ(const float _radians)
 	{
-		float radians = _radians * 0.5f;
-		float sa = sinf(radians);
-		float ca = cosf(radians);
+		__m128 s, c;
+		_mm_sincos_ps(_mm_set_ss(_radians * 0.5f), &s, &c);
+		float sa = s.m128_f32[0];
+		float ca = c.m128_f32[0];
 		return { _mm_set_ps(ca, sa, 0.0f, 0.0f) };
 	}
 	DLL Quat QuatMul(const Quat lhs, const Quat rhs)
 	{
-#if 0
-		// https://www.euclideanspace.com/maths/algebra/realNormedAlgebra/quaternions/arithmetic/index.htm
-		return { rhs.w * lhs.x + rhs.x * lhs.w + rhs.y * lhs.z - rhs.z * lhs.y,
-				 rhs.w * lhs.y - rhs.x * lhs.z + rhs.y * lhs.w + rhs.z * lhs.x,
-				 rhs.w * lhs.z + rhs.x * lhs.y - rhs.y * lhs.x + rhs.z * lhs.w,
-				 rhs.w * lhs.w - rhs.x * lhs.x - rhs.y * lhs.y - rhs.z * lhs.z };
-#endif
-
-#if 1
-		__m128 x = _mm_mul_ps(F32_SIGNFLIP_0101, _mm_mul_ps(_mm_swizzle_ps_3210(lhs.q), _mm_swizzle_ps_0(rhs.q)));
-		__m128 y = _mm_mul_ps(F32_SIGNFLIP_0011, _mm_mul_ps(_mm_swizzle_ps_2301(lhs.q), _mm_swizzle_ps_1(rhs.q)));
-		__m128 z = _mm_mul_ps(F32_SIGNFLIP_1001, _mm_mul_ps(_mm_swizzle_ps_1032(lhs.q), _mm_swizzle_ps_2(rhs.q)));
-		__m128 w = _mm_mul_ps(lhs.q, _mm_swizzle_ps_3(rhs.q));
-		return { _mm_add_ps(_mm_add_ps(x, y), _mm_add_ps(z, w)) };
-#endif
-
-#if 0
-		// https://github.com/Autodesk/animx/blob/master/src/internal/Tquaternion.h
-		Quat result;
-		result.x = rhs.w * lhs.x + rhs.x * lhs.w + rhs.y * lhs.z - rhs.z * lhs.y;
-		result.y = rhs.w * lhs.y + rhs.y * lhs.w + rhs.z * lhs.x - rhs.x * lhs.z;
-		result.z = rhs.w * lhs.z + rhs.z * lhs.w + rhs.x * lhs.y - rhs.y * lhs.x;
-		result.w = rhs.w * lhs.w - rhs.x * lhs.x - rhs.y * lhs.y - rhs.z * lhs.z;
-		return result;
-#endif
+		return DISPATCH(QuatMul)(lhs, rhs);
 	}
 	DLL float QuatDot(const Quat a, const Quat b)
 	{
@@ -99,6 +248,25 @@ extern "C"
 			return fallback;
 		return { _mm_div_ps(q.q, _mm_sqrt_ps(tmp)) };
 	}
+	DLL Quat QuatNormalizedMode(const Quat q, const Quat fallback, const ENormalizeMode mode)
+	{
+		return { Vec4NormalizedMode(q.q, fallback.q, mode) };
+	}
+	DLL void QuatNormalizedArray(const Quat* quats, const Quat fallback, Quat* result, const unsigned int count, const ENormalizeMode mode)
+	{
+		switch (mode)
+		{
+		case ENormalizeMode::Fast:
+			_QuatNormalizedArray<ENormalizeMode::Fast>(quats, fallback.q, result, count);
+			break;
+		case ENormalizeMode::Refined:
+			_QuatNormalizedArray<ENormalizeMode::Refined>(quats, fallback.q, result, count);
+			break;
+		default:
+			_QuatNormalizedArray<ENormalizeMode::Exact>(quats, fallback.q, result, count);
+			break;
+		}
+	}
 	// note, inversion only works on normalized quaternions (though post-normalize is also fine)
 	DLL Quat QuatInversed(const Quat q) // also known as conjugate
 	{
@@ -110,7 +278,6 @@ extern "C"
 	}
 	DLL Quat QuatSlerp(const Quat l, const Quat r, const float t)
 	{
-		// TODO: UNTESTED
 		// https://github.com/Autodesk/animx/blob/master/src/internal/Tquaternion.h
 
 		__m128 tmp = r.q;
@@ -129,22 +296,28 @@ extern "C"
 		// Standard case slerp, the tolerance is to avoid infinities
 		const __m128 F32_UNSIGEND_MASK = _mm_castsi128_ps(_mm_set1_epi32(~(1 << 31)));
 		cosOmega4 = _mm_and_ps(F32_UNSIGEND_MASK, cosOmega4);
-		if (cosOmega4.m128_f32[0] < 0.99999f)
+		if (cosOmega4.m128_f32[0] < QUAT_SLERP_LINEAR_THRESHOLD)
 		{
 			__m128 sinOmega4 = _mm_sqrt_ps(_mm_sub_ps(F32_ONE, _mm_mul_ps(cosOmega4, cosOmega4)));
-#if (_MSC_VER < 1920)
-			__m128 omega = _mm_set_ps1(acosf(cosOmega4.m128_f32[0]));
-#else
-			__m128 omega = _mm_acos_ps(cosOmega4);
-#endif		
+			__m128 omega = _mm_arccos_ps(cosOmega4);
 			__m128 angles = _mm_mul_ps(omega, _mm_set_ps(0.0f, 0.0f, t, 1.0f - t));
-			__m128 weights = _mm_div_ps(_mm_sin_ps(angles), sinOmega4);
+			__m128 sinAngles, cosAngles;
+			_mm_sincos_ps(angles, &sinAngles, &cosAngles);
+			__m128 weights = _mm_div_ps(sinAngles, sinOmega4);
 			return { _mm_add_ps(_mm_mul_ps(l.q, _mm_swizzle_ps_0(weights)), _mm_mul_ps(tmp, _mm_swizzle_ps_1(weights))) };
 		}
 
 		// Otherwise p and q are very close, fallback to linear interpolation
 		return { _mm_add_ps(l.q, _mm_mul_ps(_mm_set_ps1(t), _mm_sub_ps(tmp, l.q))) };
 	}
+	DLL void QuatSlerpArray(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count)
+	{
+		DISPATCH(QuatSlerpArray)(a, b, t, result, count);
+	}
+	DLL void QuatNlerpArray(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count, const bool corrected)
+	{
+		DISPATCH(QuatNlerpArray)(a, b, t, result, count, corrected);
+	}
 	// This w component is copied from v but otherwise ignored
 	DLL Vec QuatVectorTransform(const Quat q, const __m128 v)
 	{
@@ -159,7 +332,7 @@ extern "C"
 		) };
 	}
 
-	Vec _QuatToEuler(const Quat q, const ERotateOrder order, float e)
+	inline Vec _QuatToEuler(const Quat q, const ERotateOrder order, float e)
 	{
 		int i0 = ((int)order >> 4) & 3;
 		int i1 = ((int)order >> 2) & 3;
@@ -168,7 +341,8 @@ extern "C"
 		// swizzle q to match rotate order
 		float p0 = q.s[3], p1 = q.s[i0], p2 = q.s[i1], p3 = q.s[i2];
 
-		float sinTheta1 = 2.0f * (p0 * p2 + e * p1 * p3);
+		// Clamp, rounding can push this just past 1 near gimbal lock and asinf would return NaN
+		float sinTheta1 = fminf(fmaxf(2.0f * (p0 * p2 + e * p1 * p3), -1.0f), 1.0f);
 		__m128 result = _mm_setzero_ps();
 		result.m128_f32[i1] = asinf(sinTheta1);
 		if (fabs(sinTheta1) < 0.999999f)
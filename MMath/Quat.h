@@ -37,6 +37,8 @@ extern "C"
 }
 
 extern const Quat QUAT_IDENTITY;
+// Above this cosine the slerp functions fall back to linear interpolation, the angle is too small to divide by its sine
+const float QUAT_SLERP_LINEAR_THRESHOLD = 0.99999f;
 
 extern "C"
 {
@@ -49,9 +51,18 @@ extern "C"
 	DLL float QuatSqrMagnitude(const Quat q);
 	DLL float QuatMagnitude(const Quat q);
 	DLL Quat QuatNormalized(const Quat q, const Quat fallback);
+	DLL Quat QuatNormalizedMode(const Quat q, const Quat fallback, const ENormalizeMode mode); // QuatNormalized is the same as ENormalizeMode::Exact
+	// Batch version, 4 quaternions at a time in SoA form, result may alias quats
+	DLL void QuatNormalizedArray(const Quat* quats, const Quat fallback, Quat* result, const unsigned int count, const ENormalizeMode mode);
 	DLL Quat QuatInversed(const Quat q); // also known as conjugate
 	DLL Quat QuatConjugated(const Quat q); // also known as inverse
 	DLL Quat QuatSlerp(const Quat l, const Quat r, const float t);
+	// Batch versions with one t per pair, 4 or 8 pairs per iteration without branches, result may alias a or b.
+	// Like QuatSlerp they take the shortest path, results are normalized. QuatSlerpArray stays within 5e-7 radians of exact slerp.
+	DLL void QuatSlerpArray(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count);
+	// Normalized lerp is a lot cheaper but speeds up towards t = 0.5 (up to 0.15 radians off),
+	// corrected adjusts t to stay within 1e-3 radians of slerp
+	DLL void QuatNlerpArray(const Quat* a, const Quat* b, const float* t, Quat* result, const unsigned int count, const bool corrected);
 	DLL Vec QuatVectorTransform(const Quat q, const __m128 v);
 	DLL Vec QuatToEuler(const Quat q, const ERotateOrder order);
 }
@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 **/
 #pragma once
 #include "DLL.h"
+#include "Enums.h"
 
 #include <immintrin.h>
 
@@ -24,9 +25,31 @@ __forceinline __m128 _mm_shuffle_ps_0101(__m128 vec1, __m128 vec2) { return _mm_
 __forceinline __m128 _mm_shuffle_ps_2323(__m128 vec1, __m128 vec2) { return _mm_movehl_ps(vec2, vec1); }
 
 // Missing vector instructions
-__declspec(dllexport) __m128 _mm_abs_ps(__m128 v);
-__declspec(dllexport) __m128 _mm_sign_ps(__m128 v);
-__declspec(dllexport) __m128 _mm_neg_ps(__m128 v);
+DLL __m128 _mm_abs_ps(__m128 v);
+DLL __m128 _mm_sign_ps(__m128 v);
+DLL __m128 _mm_neg_ps(__m128 v);
+
+// Sine and cosine of 4 angles in one pass, always built (no SVML dependency).
+// Error vs. double precision sin/cos: < 1.5 ULP for x in [-PI, PI].
+// For |x| < 8192 the absolute error stays below 8e-8, but ULP error grows near the roots because
+// the 3 part range reduction loses bits, beyond that reduce the angle yourself first.
+DLL void _mm_sincos_ps(__m128 x, __m128* s, __m128* c);
+// Arc cosine of 4 values in [-1, 1], always built (SVML's _mm_acos_ps is MSVC 2019+ only).
+// Absolute error vs. double precision acos: < 5e-7, inputs slightly outside [-1, 1] from rounding are clamped.
+DLL __m128 _mm_arccos_ps(__m128 x);
+// v / sqrt(sqr) in the precision of the given ENormalizeMode, the Newton-Raphson step is y' = y * (1.5 - 0.5 * sqr * y * y).
+// Zero sqr gives NaN or infinity in every mode, blend in a fallback afterwards.
+// Calling it once per component of the same sqr is fine, the compiler shares the (r)sqrt between them.
+template<ENormalizeMode MODE>
+__forceinline __m128 _mm_mul_rsqrt_ps(__m128 v, __m128 sqr)
+{
+	if (MODE == ENormalizeMode::Exact)
+		return _mm_div_ps(v, _mm_sqrt_ps(sqr));
+	__m128 y = _mm_rsqrt_ps(sqr);
+	if (MODE == ENormalizeMode::Refined)
+		y = _mm_mul_ps(y, _mm_sub_ps(_mm_set_ps1(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set_ps1(0.5f), sqr), _mm_mul_ps(y, y))));
+	return _mm_mul_ps(v, y);
+}
 
 // I don't like using #defines so here's a bunch of swizzle functions.
 // Sorry if it slows down compiles, so far it's worked fine!
@@ -81,12 +104,6 @@ __forceinline __m128 _mm_shuffle_ps_1(__m128 a, __m128 b) { return  _mm_shuffle_
 __forceinline __m128 _mm_shuffle_ps_2(__m128 a, __m128 b) { return  _mm_shuffle_ps(a, b, 0b10101010); }
 __forceinline __m128 _mm_shuffle_ps_3(__m128 a, __m128 b) { return  _mm_shuffle_ps(a, b, 0b11111111); }
 
-#if (_MSC_VER < 1920)
-// If you get linker errors for duplicate implementations, simply turn these off as Visual Studio 2019 and the latest Windows 10 SDK has these functions available!
-__m128 _mm_sin_ps(__m128 x);
-__m128 _mm_cos_ps(__m128 x);
-#endif
-
 extern const __m128 F32_ZERO;
 extern const __m128 F32_ONE;
 extern const __m128 F32_NEG_ONE;
@@ -103,6 +120,8 @@ extern const __m128 F32_UNIT_NEG_W;
 extern const __m128 F32_SIGNFLIP_0101; // in the naming 1 means _do_ sign flip => (1, -1, 1, -1)
 extern const __m128 F32_SIGNFLIP_0110;
 extern const __m128 F32_SIGNFLIP_0011;
+extern const __m128 F32_SIGNFLIP_1110;
+extern const __m128 F32_SIGNFLIP_1001;
 
 extern const __m128 F32_SIGNFLIP_VEC3_100; // multiply with this to get the sign flip and w = 0
 extern const __m128 F32_SIGNFLIP_VEC3_010;
@@ -126,6 +145,8 @@ const __m128 F32_UNIT_NEG_W = { 0.0f, 0.0f, 0.0f, -1.0f };
 const __m128 F32_SIGNFLIP_0101 = { 1.0f, -1.0f, 1.0f, -1.0f };
 const __m128 F32_SIGNFLIP_0011 = { 1.0f, 1.0f, -1.0f, -1.0f };
 const __m128 F32_SIGNFLIP_0110 = { 1.0f, -1.0f, -1.0f, 1.0f };
+const __m128 F32_SIGNFLIP_1110 = { -1.0f, -1.0f, -1.0f, 1.0f };
+const __m128 F32_SIGNFLIP_1001 = { -1.0f, 1.0f, 1.0f, -1.0f };
 
 // sign flip and zero out w
 const __m128 F32_SIGNFLIP_VEC3_100 = { -1.0f, 1.0f, 1.0f, 0.0f };
@@ -0,0 +1,211 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Skinning.h"
+#include "SIMD.h"
+#include "Dispatch.h"
+#include "Parallel.h"
+
+// Below this many vertices per thread, starting the thread costs more than it saves
+static const unsigned int SKIN_GRAIN = 8192; // vertices per chunk
+
+// Blended matrix accumulation: sum the weighted palette matrices, then transform the position and normal once.
+// That is 4 multiply-adds per influence instead of a full Mat44VectorTransform per influence and attribute.
+// INFLUENCES is 0 for the generic loop, 4 and 8 get fully unrolled.
+template<unsigned int INFLUENCES>
+__forceinline void _SkinLinearBlendRangeSSE(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	const unsigned int influences = INFLUENCES ? INFLUENCES : influencesPerVertex;
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const unsigned int* indices = jointIndices + i * influences;
+		const float* w = weights + i * influences;
+
+		const Mat44& first = palette[indices[0]];
+		__m128 weight = _mm_set_ps1(w[0]);
+		__m128 col0 = _mm_mul_ps(first.col0, weight);
+		__m128 col1 = _mm_mul_ps(first.col1, weight);
+		__m128 col2 = _mm_mul_ps(first.col2, weight);
+		__m128 col3 = _mm_mul_ps(first.col3, weight);
+		for (unsigned int k = 1; k < influences; ++k)
+		{
+			const Mat44& m = palette[indices[k]];
+			weight = _mm_set_ps1(w[k]);
+			col0 = _mm_add_ps(col0, _mm_mul_ps(m.col0, weight));
+			col1 = _mm_add_ps(col1, _mm_mul_ps(m.col1, weight));
+			col2 = _mm_add_ps(col2, _mm_mul_ps(m.col2, weight));
+			col3 = _mm_add_ps(col3, _mm_mul_ps(m.col3, weight));
+		}
+
+		const __m128 p = positions[i].s;
+		outPositions[i].s = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, _mm_swizzle_ps_0(p)), _mm_mul_ps(col1, _mm_swizzle_ps_1(p))),
+			_mm_add_ps(_mm_mul_ps(col2, _mm_swizzle_ps_2(p)), col3));
+
+		if (normals)
+		{
+			const __m128 n = normals[i].s;
+			__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, _mm_swizzle_ps_0(n)), _mm_mul_ps(col1, _mm_swizzle_ps_1(n))), _mm_mul_ps(col2, _mm_swizzle_ps_2(n)));
+			// degenerate normals stay zero instead of turning into NaN
+			__m128 sqrLength = _mm_dp_ps(r, r, 0x77);
+			outNormals[i].s = _mm_and_ps(_mm_div_ps(r, _mm_sqrt_ps(sqrLength)), _mm_cmpgt_ps(sqrLength, F32_ZERO));
+		}
+	}
+}
+
+void _SkinLinearBlendSSE(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	switch (influencesPerVertex)
+	{
+	case 4:
+		_SkinLinearBlendRangeSSE<4>(positions, normals, jointIndices, weights, 4, palette, outPositions, outNormals, count);
+		break;
+	case 8:
+		_SkinLinearBlendRangeSSE<8>(positions, normals, jointIndices, weights, 8, palette, outPositions, outNormals, count);
+		break;
+	default:
+		_SkinLinearBlendRangeSSE<0>(positions, normals, jointIndices, weights, influencesPerVertex, palette, outPositions, outNormals, count);
+		break;
+	}
+}
+
+// Same as _SkinLinearBlendRangeSSE with an affine palette, 3 multiply-adds per influence and a quarter less palette to gather.
+// Three rows do not pair up into 256-bit registers, so there is no AVX2 version of this one.
+template<unsigned int INFLUENCES>
+__forceinline void _SkinLinearBlendMat34RangeSSE(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat34* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	const unsigned int influences = INFLUENCES ? INFLUENCES : influencesPerVertex;
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const unsigned int* indices = jointIndices + i * influences;
+		const float* w = weights + i * influences;
+
+		const Mat34& first = palette[indices[0]];
+		__m128 weight = _mm_set_ps1(w[0]);
+		__m128 row0 = _mm_mul_ps(first.row0, weight);
+		__m128 row1 = _mm_mul_ps(first.row1, weight);
+		__m128 row2 = _mm_mul_ps(first.row2, weight);
+		for (unsigned int k = 1; k < influences; ++k)
+		{
+			const Mat34& m = palette[indices[k]];
+			weight = _mm_set_ps1(w[k]);
+			row0 = _mm_add_ps(row0, _mm_mul_ps(m.row0, weight));
+			row1 = _mm_add_ps(row1, _mm_mul_ps(m.row1, weight));
+			row2 = _mm_add_ps(row2, _mm_mul_ps(m.row2, weight));
+		}
+
+		outPositions[i].s = _Mat34Transform(row0, row1, row2, _mm_blend_ps(positions[i].s, F32_ONE, 0b1000));
+
+		if (normals)
+		{
+			__m128 r = _Mat34Transform(row0, row1, row2, _mm_blend_ps(normals[i].s, F32_ZERO, 0b1000));
+			// degenerate normals stay zero instead of turning into NaN
+			__m128 sqrLength = _mm_dp_ps(r, r, 0x77);
+			outNormals[i].s = _mm_and_ps(_mm_div_ps(r, _mm_sqrt_ps(sqrLength)), _mm_cmpgt_ps(sqrLength, F32_ZERO));
+		}
+	}
+}
+
+static void _SkinLinearBlendMat34SSE(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat34* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	switch (influencesPerVertex)
+	{
+	case 4:
+		_SkinLinearBlendMat34RangeSSE<4>(positions, normals, jointIndices, weights, 4, palette, outPositions, outNormals, count);
+		break;
+	case 8:
+		_SkinLinearBlendMat34RangeSSE<8>(positions, normals, jointIndices, weights, 8, palette, outPositions, outNormals, count);
+		break;
+	default:
+		_SkinLinearBlendMat34RangeSSE<0>(positions, normals, jointIndices, weights, influencesPerVertex, palette, outPositions, outNormals, count);
+		break;
+	}
+}
+
+// Dual quaternion linear blending: flip every influence into the hemisphere of the first one, sum, normalize, transform.
+template<unsigned int INFLUENCES>
+__forceinline void _SkinDualQuatRangeSSE(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	const unsigned int influences = INFLUENCES ? INFLUENCES : influencesPerVertex;
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const unsigned int* indices = jointIndices + i * influences;
+		const float* w = weights + i * influences;
+
+		const DualQuat& first = palette[indices[0]];
+		__m128 weight = _mm_set_ps1(w[0]);
+		__m128 real = _mm_mul_ps(first.real.q, weight);
+		__m128 dual = _mm_mul_ps(first.dual.q, weight);
+		for (unsigned int k = 1; k < influences; ++k)
+		{
+			const DualQuat& dq = palette[indices[k]];
+			weight = _mm_xor_ps(_mm_set_ps1(w[k]), _mm_and_ps(_mm_dp_ps(dq.real.q, first.real.q, 0xFF), signMask));
+			real = _mm_add_ps(real, _mm_mul_ps(dq.real.q, weight));
+			dual = _mm_add_ps(dual, _mm_mul_ps(dq.dual.q, weight));
+		}
+
+		const __m128 invLength = _mm_div_ps(F32_ONE, _mm_sqrt_ps(_mm_dp_ps(real, real, 0xFF)));
+		real = _mm_mul_ps(real, invLength);
+		dual = _mm_mul_ps(dual, invLength);
+
+		outPositions[i].s = _DualQuatPointTransform(real, dual, _mm_blend_ps(positions[i].s, F32_ONE, 0b1000));
+		if (normals)
+			outNormals[i].s = _DualQuatVectorTransform(real, _mm_blend_ps(normals[i].s, F32_ZERO, 0b1000));
+	}
+}
+
+void _SkinDualQuatSSE(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	switch (influencesPerVertex)
+	{
+	case 4:
+		_SkinDualQuatRangeSSE<4>(positions, normals, jointIndices, weights, 4, palette, outPositions, outNormals, count);
+		break;
+	case 8:
+		_SkinDualQuatRangeSSE<8>(positions, normals, jointIndices, weights, 8, palette, outPositions, outNormals, count);
+		break;
+	default:
+		_SkinDualQuatRangeSSE<0>(positions, normals, jointIndices, weights, influencesPerVertex, palette, outPositions, outNormals, count);
+		break;
+	}
+}
+
+// Runs the kernel on chunks of the mesh on the thread pool.
+template<typename PALETTE>
+static inline void _SkinChunked(void(*kernel)(const Vec*, const Vec*, const unsigned int*, const float*, const unsigned int, const PALETTE*, Vec*, Vec*, const unsigned int),
+	const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const PALETTE* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+{
+	// Chunks start on a multiple of 4 vertices so no two threads write to the same cache line
+	const unsigned int grain = (ParallelGrain(SKIN_GRAIN) + 3) & ~3u;
+	ParallelFor(0, count, grain, [&](const unsigned int begin, const unsigned int end)
+	{
+		kernel(positions + begin, normals ? normals + begin : nullptr,
+			jointIndices + begin * influencesPerVertex, weights + begin * influencesPerVertex, influencesPerVertex, palette,
+			outPositions + begin, outNormals ? outNormals + begin : nullptr, end - begin);
+	});
+}
+
+extern "C"
+{
+	DLL void SkinLinearBlend(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+	{
+		_SkinChunked(DISPATCH(SkinLinearBlend), positions, normals, jointIndices, weights, influencesPerVertex, palette, outPositions, outNormals, count);
+	}
+	DLL void SkinLinearBlendMat34(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat34* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+	{
+		_SkinChunked(_SkinLinearBlendMat34SSE, positions, normals, jointIndices, weights, influencesPerVertex, palette, outPositions, outNormals, count);
+	}
+	DLL void SkinDualQuat(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count)
+	{
+		_SkinChunked(DISPATCH(SkinDualQuat), positions, normals, jointIndices, weights, influencesPerVertex, palette, outPositions, outNormals, count);
+	}
+}
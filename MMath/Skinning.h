@@ -0,0 +1,36 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include "Vector.h"
+#include "Mat44.h"
+#include "Mat34.h"
+#include "DualQuat.h"
+
+extern "C"
+{
+	// Linear blend skinning of positions and normals in one pass.
+	// Every vertex has influencesPerVertex (1 to 8, meant for 4 or 8) joint indices and weights, stored contiguously per vertex.
+	// Unused influences need a weight of 0 and a valid joint index, weights should sum to 1.
+	// palette holds one skin matrix (world * inverse bind) per joint.
+	// Positions are transformed as points, normals as directions and renormalized, w of the inputs is ignored.
+	// normals and outNormals may both be null to skip normals, outputs may alias their inputs.
+	// Large meshes are split in chunks that are skinned on multiple threads, see Parallel.h.
+	DLL void SkinLinearBlend(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat44* palette, Vec* outPositions, Vec* outNormals, const unsigned int count);
+	// Same as SkinLinearBlend with an affine palette (see Mat44ToMat34Array), a quarter less palette to read and blend.
+	DLL void SkinLinearBlendMat34(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const Mat34* palette, Vec* outPositions, Vec* outNormals, const unsigned int count);
+	// Dual quaternion skinning with the same inputs, palette holds unit dual quaternions (see Mat44ToDualQuatArray).
+	// Half the palette bandwidth of SkinLinearBlend and no candy wrapper artifacts, but the skin matrices must be rigid.
+	DLL void SkinDualQuat(const Vec* positions, const Vec* normals, const unsigned int* jointIndices, const float* weights, const unsigned int influencesPerVertex, const DualQuat* palette, Vec* outPositions, Vec* outNormals, const unsigned int count);
+}
@@ -0,0 +1,270 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Stream.h"
+#include "SIMD.h"
+#include "Dispatch.h"
+#include "Parallel.h"
+#include <malloc.h>
+#include <string.h>
+
+// Stream capacity is a multiple of this, so 2x unrolled 8-wide kernels never need a scalar loop
+static const unsigned int STREAM_PADDING = 16;
+
+// Float results have no padding, the last (partial) block goes through a temporary
+__forceinline void _StreamStore8(float* dst, const unsigned int i, const unsigned int count, const __m128 a, const __m128 b)
+{
+	if (i + 8 <= count)
+	{
+		_mm_storeu_ps(dst + i, a);
+		_mm_storeu_ps(dst + i + 4, b);
+		return;
+	}
+	__declspec(align(16)) float tmp[8];
+	_mm_store_ps(tmp, a);
+	_mm_store_ps(tmp + 4, b);
+	memcpy(dst + i, tmp, sizeof(float) * (count - i));
+}
+
+void _Vec3StreamDotSSE(const Vec3Stream* a, const Vec3Stream* b, float* result)
+{
+	const unsigned int count = a->count;
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		__m128 d0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(a->x + i), _mm_load_ps(b->x + i)),
+			_mm_mul_ps(_mm_load_ps(a->y + i), _mm_load_ps(b->y + i))),
+			_mm_mul_ps(_mm_load_ps(a->z + i), _mm_load_ps(b->z + i)));
+		__m128 d1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(a->x + i + 4), _mm_load_ps(b->x + i + 4)),
+			_mm_mul_ps(_mm_load_ps(a->y + i + 4), _mm_load_ps(b->y + i + 4))),
+			_mm_mul_ps(_mm_load_ps(a->z + i + 4), _mm_load_ps(b->z + i + 4)));
+		_StreamStore8(result, i, count, d0, d1);
+	}
+}
+
+void _Vec3StreamCrossSSE(const Vec3Stream* a, const Vec3Stream* b, Vec3Stream* result)
+{
+	const unsigned int count = a->count;
+	for (unsigned int i = 0; i < count; i += 4)
+	{
+		__m128 ax = _mm_load_ps(a->x + i), ay = _mm_load_ps(a->y + i), az = _mm_load_ps(a->z + i);
+		__m128 bx = _mm_load_ps(b->x + i), by = _mm_load_ps(b->y + i), bz = _mm_load_ps(b->z + i);
+		_mm_store_ps(result->x + i, _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+		_mm_store_ps(result->y + i, _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+		_mm_store_ps(result->z + i, _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+	}
+	result->count = count;
+}
+
+void _Vec3StreamMagnitudeSSE(const Vec3Stream* v, float* result)
+{
+	const unsigned int count = v->count;
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		__m128 x0 = _mm_load_ps(v->x + i), y0 = _mm_load_ps(v->y + i), z0 = _mm_load_ps(v->z + i);
+		__m128 x1 = _mm_load_ps(v->x + i + 4), y1 = _mm_load_ps(v->y + i + 4), z1 = _mm_load_ps(v->z + i + 4);
+		__m128 m0 = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x0, x0), _mm_mul_ps(y0, y0)), _mm_mul_ps(z0, z0)));
+		__m128 m1 = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, x1), _mm_mul_ps(y1, y1)), _mm_mul_ps(z1, z1)));
+		_StreamStore8(result, i, count, m0, m1);
+	}
+}
+
+template<ENormalizeMode MODE>
+void _Vec3StreamNormalizedSSE(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result)
+{
+	const unsigned int count = v->count;
+	const __m128 fx = _mm_swizzle_ps_0(fallback), fy = _mm_swizzle_ps_1(fallback), fz = _mm_swizzle_ps_2(fallback);
+	for (unsigned int i = 0; i < count; i += 4)
+	{
+		__m128 x = _mm_load_ps(v->x + i), y = _mm_load_ps(v->y + i), z = _mm_load_ps(v->z + i);
+		__m128 sqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+		__m128 isZero = _mm_cmpeq_ps(sqr, F32_ZERO);
+		_mm_store_ps(result->x + i, _mm_blendv_ps(_mm_mul_rsqrt_ps<MODE>(x, sqr), fx, isZero));
+		_mm_store_ps(result->y + i, _mm_blendv_ps(_mm_mul_rsqrt_ps<MODE>(y, sqr), fy, isZero));
+		_mm_store_ps(result->z + i, _mm_blendv_ps(_mm_mul_rsqrt_ps<MODE>(z, sqr), fz, isZero));
+	}
+	result->count = count;
+}
+
+void _Vec3StreamNormalizedSSE(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result, const ENormalizeMode mode)
+{
+	switch (mode)
+	{
+	case ENormalizeMode::Fast:
+		_Vec3StreamNormalizedSSE<ENormalizeMode::Fast>(v, fallback, result);
+		break;
+	case ENormalizeMode::Refined:
+		_Vec3StreamNormalizedSSE<ENormalizeMode::Refined>(v, fallback, result);
+		break;
+	default:
+		_Vec3StreamNormalizedSSE<ENormalizeMode::Exact>(v, fallback, result);
+		break;
+	}
+}
+
+void _Vec3StreamPerpendicularSSE(const Vec3Stream* v, Vec3Stream* result)
+{
+	// Vec3Perpendicular per lane, (-y, x, 0) where |x| > |z| and (0, -z, y) elsewhere
+	const unsigned int count = v->count;
+	const __m128 sign = _mm_set_ps1(-0.0f);
+	for (unsigned int i = 0; i < count; i += 4)
+	{
+		__m128 x = _mm_load_ps(v->x + i), y = _mm_load_ps(v->y + i), z = _mm_load_ps(v->z + i);
+		__m128 crossZ = _mm_cmpgt_ps(_mm_andnot_ps(sign, x), _mm_andnot_ps(sign, z));
+		__m128 px = _mm_and_ps(crossZ, _mm_xor_ps(y, sign));
+		__m128 py = _mm_blendv_ps(_mm_xor_ps(z, sign), x, crossZ);
+		__m128 pz = _mm_andnot_ps(crossZ, y);
+		__m128 sqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py)), _mm_mul_ps(pz, pz));
+		__m128 isZero = _mm_cmpeq_ps(sqr, F32_ZERO);
+		__m128 inv = _mm_rsqrt_ps(sqr);
+		_mm_store_ps(result->x + i, _mm_blendv_ps(_mm_mul_ps(px, inv), F32_ONE, isZero));
+		_mm_store_ps(result->y + i, _mm_andnot_ps(isZero, _mm_mul_ps(py, inv)));
+		_mm_store_ps(result->z + i, _mm_andnot_ps(isZero, _mm_mul_ps(pz, inv)));
+	}
+	result->count = count;
+}
+
+void _Vec3StreamLerpSSE(const Vec3Stream* a, const Vec3Stream* b, const float t, Vec3Stream* result)
+{
+	const unsigned int count = a->count;
+	const __m128 vt = _mm_set_ps1(t);
+	for (unsigned int i = 0; i < count; i += 4)
+	{
+		__m128 ax = _mm_load_ps(a->x + i), ay = _mm_load_ps(a->y + i), az = _mm_load_ps(a->z + i);
+		_mm_store_ps(result->x + i, _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(b->x + i), ax), vt)));
+		_mm_store_ps(result->y + i, _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(b->y + i), ay), vt)));
+		_mm_store_ps(result->z + i, _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(b->z + i), az), vt)));
+	}
+	result->count = count;
+}
+
+void _Vec3StreamTransformSSE(const Vec3Stream* v, const Mat44 m, const float w, Vec3Stream* result)
+{
+	const unsigned int count = v->count;
+	// Every matrix element becomes a register, translation is folded in up front
+	const __m128 m00 = _mm_set_ps1(m.m00), m01 = _mm_set_ps1(m.m01), m02 = _mm_set_ps1(m.m02);
+	const __m128 m10 = _mm_set_ps1(m.m10), m11 = _mm_set_ps1(m.m11), m12 = _mm_set_ps1(m.m12);
+	const __m128 m20 = _mm_set_ps1(m.m20), m21 = _mm_set_ps1(m.m21), m22 = _mm_set_ps1(m.m22);
+	const __m128 tx = _mm_set_ps1(m.m30 * w), ty = _mm_set_ps1(m.m31 * w), tz = _mm_set_ps1(m.m32 * w);
+	for (unsigned int i = 0; i < count; i += 4)
+	{
+		__m128 x = _mm_load_ps(v->x + i), y = _mm_load_ps(v->y + i), z = _mm_load_ps(v->z + i);
+		_mm_store_ps(result->x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m10, y)), _mm_add_ps(_mm_mul_ps(m20, z), tx)));
+		_mm_store_ps(result->y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m21, z), ty)));
+		_mm_store_ps(result->z + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, x), _mm_mul_ps(m12, y)), _mm_add_ps(_mm_mul_ps(m22, z), tz)));
+	}
+	result->count = count;
+}
+
+extern "C"
+{
+	DLL Vec3Stream Vec3StreamAlloc(const unsigned int count)
+	{
+		Vec3Stream stream = {};
+		const unsigned int capacity = (count + STREAM_PADDING - 1) / STREAM_PADDING * STREAM_PADDING;
+		// Counts close to UINT_MAX wrap around when padded
+		if (capacity < count)
+			return stream;
+		// One allocation, capacity * sizeof(float) is a multiple of 64 so y and z stay aligned too
+		stream.x = (float*)_aligned_malloc(sizeof(float) * 3 * (size_t)capacity, 64);
+		if (!stream.x)
+			return stream;
+		stream.count = count;
+		stream.capacity = capacity;
+		memset(stream.x, 0, sizeof(float) * 3 * stream.capacity);
+		stream.y = stream.x + stream.capacity;
+		stream.z = stream.y + stream.capacity;
+		return stream;
+	}
+	DLL void Vec3StreamFree(Vec3Stream* stream)
+	{
+		_aligned_free(stream->x);
+		stream->x = stream->y = stream->z = nullptr;
+		stream->count = stream->capacity = 0;
+	}
+	DLL void Vec3StreamFromVecs(const Vec* vecs, Vec3Stream* stream)
+	{
+		const unsigned int count = stream->count;
+		unsigned int i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 r0 = vecs[i].s, r1 = vecs[i + 1].s, r2 = vecs[i + 2].s, r3 = vecs[i + 3].s;
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			_mm_store_ps(stream->x + i, r0);
+			_mm_store_ps(stream->y + i, r1);
+			_mm_store_ps(stream->z + i, r2);
+		}
+		for (; i < count; ++i)
+		{
+			stream->x[i] = vecs[i].x;
+			stream->y[i] = vecs[i].y;
+			stream->z[i] = vecs[i].z;
+		}
+	}
+	DLL void Vec3StreamToVecs(const Vec3Stream* stream, Vec* vecs)
+	{
+		const unsigned int count = stream->count;
+		unsigned int i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 r0 = _mm_load_ps(stream->x + i), r1 = _mm_load_ps(stream->y + i), r2 = _mm_load_ps(stream->z + i), r3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			vecs[i].s = r0;
+			vecs[i + 1].s = r1;
+			vecs[i + 2].s = r2;
+			vecs[i + 3].s = r3;
+		}
+		for (; i < count; ++i)
+			vecs[i].s = _mm_set_ps(0.0f, stream->z[i], stream->y[i], stream->x[i]);
+	}
+
+	DLL void Vec3StreamDot(const Vec3Stream* a, const Vec3Stream* b, float* result)
+	{
+		DISPATCH(Vec3StreamDot)(a, b, result);
+	}
+	DLL void Vec3StreamCross(const Vec3Stream* a, const Vec3Stream* b, Vec3Stream* result)
+	{
+		DISPATCH(Vec3StreamCross)(a, b, result);
+	}
+	DLL void Vec3StreamMagnitude(const Vec3Stream* v, float* result)
+	{
+		DISPATCH(Vec3StreamMagnitude)(v, result);
+	}
+	DLL void Vec3StreamNormalized(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result)
+	{
+		DISPATCH(Vec3StreamNormalized)(v, fallback, result, ENormalizeMode::Fast);
+	}
+	DLL void Vec3StreamNormalizedMode(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result, const ENormalizeMode mode)
+	{
+		DISPATCH(Vec3StreamNormalized)(v, fallback, result, mode);
+	}
+	DLL void Vec3StreamPerpendicular(const Vec3Stream* v, Vec3Stream* result)
+	{
+		DISPATCH(Vec3StreamPerpendicular)(v, result);
+	}
+	DLL void Vec3StreamLerp(const Vec3Stream* a, const Vec3Stream* b, const float t, Vec3Stream* result)
+	{
+		DISPATCH(Vec3StreamLerp)(a, b, t, result);
+	}
+	DLL void Vec3StreamTransform(const Vec3Stream* v, const Mat44 m, const float w, Vec3Stream* result)
+	{
+		// Chunks of a multiple of STREAM_PADDING keep every view 64 byte aligned
+		auto kernel = DISPATCH(Vec3StreamTransform);
+		const unsigned int grain = (ParallelGrain(65536) + STREAM_PADDING - 1) / STREAM_PADDING * STREAM_PADDING;
+		ParallelFor(0, v->count, grain, [&](const unsigned int begin, const unsigned int end)
+		{
+			const Vec3Stream in = { v->x + begin, v->y + begin, v->z + begin, end - begin, end - begin };
+			Vec3Stream out = { result->x + begin, result->y + begin, result->z + begin, end - begin, end - begin };
+			kernel(&in, m, w, &out);
+		});
+		result->count = v->count;
+	}
+}
@@ -0,0 +1,48 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include "Vector.h"
+#include "Mat44.h"
+
+extern "C"
+{
+	// Structure of arrays storage for Vec3s, so kernels can process 4 or 8 points per instruction without any horizontal operations.
+	// x, y and z are separate 64 byte aligned arrays and capacity is padded to a multiple of 16.
+	// The padding is zero initialized, kernels are free to read and write it so treat its contents as garbage afterwards.
+	struct Vec3Stream
+	{
+		float* x;
+		float* y;
+		float* z;
+		unsigned int count;
+		unsigned int capacity;
+	};
+
+	DLL Vec3Stream Vec3StreamAlloc(const unsigned int count); // Returns an empty stream (null arrays, count and capacity 0) when the allocation fails
+	DLL void Vec3StreamFree(Vec3Stream* stream); // Also safe on an empty stream
+	DLL void Vec3StreamFromVecs(const Vec* vecs, Vec3Stream* stream); // Reads stream->count vecs, w is ignored
+	DLL void Vec3StreamToVecs(const Vec3Stream* stream, Vec* vecs); // Writes stream->count vecs with w = 0
+
+	// All streams passed to one call must hold the same count, results may alias the inputs.
+	// Stream results get their count set, float results must have room for count floats.
+	DLL void Vec3StreamDot(const Vec3Stream* a, const Vec3Stream* b, float* result);
+	DLL void Vec3StreamCross(const Vec3Stream* a, const Vec3Stream* b, Vec3Stream* result);
+	DLL void Vec3StreamMagnitude(const Vec3Stream* v, float* result);
+	DLL void Vec3StreamNormalized(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result); // Zero length vectors are replaced by fallback, like Vec3Normalized
+	DLL void Vec3StreamNormalizedMode(const Vec3Stream* v, const __m128 fallback, Vec3Stream* result, const ENormalizeMode mode);
+	DLL void Vec3StreamPerpendicular(const Vec3Stream* v, Vec3Stream* result); // Vec3Perpendicular per vector, e.g. for tangent frames
+	DLL void Vec3StreamLerp(const Vec3Stream* a, const Vec3Stream* b, const float t, Vec3Stream* result);
+	DLL void Vec3StreamTransform(const Vec3Stream* v, const Mat44 m, const float w, Vec3Stream* result); // Mat44VectorTransform with the given w, so 1 for points and 0 for directions
+}
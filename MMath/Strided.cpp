@@ -0,0 +1,419 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+// Generated by codegen.py, do not edit.
+#include "Strided.h"
+#include "Friends.h"
+
+// Element i of a strided array
+template<typename T>
+__forceinline T& _StridedAt(T* data, const unsigned int stride, const unsigned int i)
+{
+	return *(T*)((char*)data + (size_t)stride * i);
+}
+template<typename T>
+__forceinline const T& _StridedAt(const T* data, const unsigned int stride, const unsigned int i)
+{
+	return *(const T*)((const char*)data + (size_t)stride * i);
+}
+
+extern "C"
+{
+	DLL void Mat44TranslateStrided(const float* x, const unsigned int xStride, const float* y, const unsigned int yStride, const float* z, const unsigned int zStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Translate(_StridedAt(x, xStride, i), _StridedAt(y, yStride, i), _StridedAt(z, zStride, i));
+	}
+	DLL void Mat44RotateXStrided(const float* radians, const unsigned int radiansStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44RotateX(_StridedAt(radians, radiansStride, i));
+	}
+	DLL void Mat44RotateYStrided(const float* radians, const unsigned int radiansStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44RotateY(_StridedAt(radians, radiansStride, i));
+	}
+	DLL void Mat44RotateZStrided(const float* radians, const unsigned int radiansStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44RotateZ(_StridedAt(radians, radiansStride, i));
+	}
+	DLL void Mat44ScaleStrided(const float* x, const unsigned int xStride, const float* y, const unsigned int yStride, const float* z, const unsigned int zStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Scale(_StridedAt(x, xStride, i), _StridedAt(y, yStride, i), _StridedAt(z, zStride, i));
+	}
+	DLL void Mat44Scale2Strided(const __m128* scale, const unsigned int scaleStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Scale2(_StridedAt(scale, scaleStride, i));
+	}
+	DLL void Mat44MulStrided(const Mat44* rhs, const unsigned int rhsStride, const Mat44* lhs, const unsigned int lhsStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Mul(_StridedAt(rhs, rhsStride, i), _StridedAt(lhs, lhsStride, i));
+	}
+	DLL void Mat44InversedStrided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Inversed(_StridedAt(m, mStride, i));
+	}
+	DLL void Mat44InversedFastStrided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44InversedFast(_StridedAt(m, mStride, i));
+	}
+	DLL void Mat44InversedFastNoScaleStrided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44InversedFastNoScale(_StridedAt(m, mStride, i));
+	}
+	DLL void Mat44TransposedStrided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Transposed(_StridedAt(m, mStride, i));
+	}
+	DLL void Mat44DeterminantStrided(const Mat44* m, const unsigned int mStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Determinant(_StridedAt(m, mStride, i));
+	}
+	DLL void Mat44VectorTransformStrided(const Mat44* m, const unsigned int mStride, const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44VectorTransform(_StridedAt(m, mStride, i), _StridedAt(v, vStride, i));
+	}
+	DLL void Mat44ToEulerStrided(const Mat44* m, const unsigned int mStride, const ERotateOrder ro, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44ToEuler(_StridedAt(m, mStride, i), ro);
+	}
+	DLL void Mat44AxisAngleStrided(const __m128* axis, const unsigned int axisStride, const float* radians, const unsigned int radiansStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44AxisAngle(_StridedAt(axis, axisStride, i), _StridedAt(radians, radiansStride, i));
+	}
+	DLL void Mat44AlignStrided(const __m128* from, const unsigned int fromStride, const __m128* to, const unsigned int toStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Align(_StridedAt(from, fromStride, i), _StridedAt(to, toStride, i));
+	}
+	DLL void Mat44RotateTowardsStrided(const __m128* from, const unsigned int fromStride, const __m128* to, const unsigned int toStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44RotateTowards(_StridedAt(from, fromStride, i), _StridedAt(to, toStride, i));
+	}
+	DLL void Mat44LookAtStrided(const __m128* targetDirection, const unsigned int targetDirectionStride, const __m128* upDirection, const unsigned int upDirectionStride, const EAxis forward, const EAxis upAxis, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44LookAt(_StridedAt(targetDirection, targetDirectionStride, i), _StridedAt(upDirection, upDirectionStride, i), forward, upAxis);
+	}
+	DLL void Mat44FromVectorsStrided(const __m128* c0, const unsigned int c0Stride, const __m128* c1, const unsigned int c1Stride, const __m128* c2, const unsigned int c2Stride, const __m128* translate, const unsigned int translateStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44FromVectors(_StridedAt(c0, c0Stride, i), _StridedAt(c1, c1Stride, i), _StridedAt(c2, c2Stride, i), _StridedAt(translate, translateStride, i));
+	}
+	DLL void Mat44ToTop33Strided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44ToTop33(_StridedAt(m, mStride, i));
+	}
+	DLL void Mat44DeltaStrided(const Mat44* m, const unsigned int mStride, const Mat44* newParent, const unsigned int newParentStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Delta(_StridedAt(m, mStride, i), _StridedAt(newParent, newParentStride, i));
+	}
+	DLL void Mat44RotateStrided(const float* radiansX, const unsigned int radiansXStride, const float* radiansY, const unsigned int radiansYStride, const float* radiansZ, const unsigned int radiansZStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Rotate(_StridedAt(radiansX, radiansXStride, i), _StridedAt(radiansY, radiansYStride, i), _StridedAt(radiansZ, radiansZStride, i), rotateOrder);
+	}
+	DLL void Mat44Rotate2Strided(const __m128* radians, const unsigned int radiansStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Rotate2(_StridedAt(radians, radiansStride, i), rotateOrder);
+	}
+	DLL void EulerToMat44Strided(const __m128* radians, const unsigned int radiansStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = EulerToMat44(_StridedAt(radians, radiansStride, i), rotateOrder);
+	}
+	DLL void Mat44TranslateRotateStrided(const float* x, const unsigned int xStride, const float* y, const unsigned int yStride, const float* z, const unsigned int zStride, const float* radiansX, const unsigned int radiansXStride, const float* radiansY, const unsigned int radiansYStride, const float* radiansZ, const unsigned int radiansZStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44TranslateRotate(_StridedAt(x, xStride, i), _StridedAt(y, yStride, i), _StridedAt(z, zStride, i), _StridedAt(radiansX, radiansXStride, i), _StridedAt(radiansY, radiansYStride, i), _StridedAt(radiansZ, radiansZStride, i), rotateOrder);
+	}
+	DLL void Mat44TranslateRotate2Strided(const __m128* translate, const unsigned int translateStride, const __m128* radians, const unsigned int radiansStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44TranslateRotate2(_StridedAt(translate, translateStride, i), _StridedAt(radians, radiansStride, i), rotateOrder);
+	}
+	DLL void Mat44TRSStrided(const float* x, const unsigned int xStride, const float* y, const unsigned int yStride, const float* z, const unsigned int zStride, const float* radiansX, const unsigned int radiansXStride, const float* radiansY, const unsigned int radiansYStride, const float* radiansZ, const unsigned int radiansZStride, const float* scaleX, const unsigned int scaleXStride, const float* scaleY, const unsigned int scaleYStride, const float* scaleZ, const unsigned int scaleZStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44TRS(_StridedAt(x, xStride, i), _StridedAt(y, yStride, i), _StridedAt(z, zStride, i), _StridedAt(radiansX, radiansXStride, i), _StridedAt(radiansY, radiansYStride, i), _StridedAt(radiansZ, radiansZStride, i), _StridedAt(scaleX, scaleXStride, i), _StridedAt(scaleY, scaleYStride, i), _StridedAt(scaleZ, scaleZStride, i), rotateOrder);
+	}
+	DLL void Mat44TRS2Strided(const __m128* translate, const unsigned int translateStride, const __m128* radians, const unsigned int radiansStride, const __m128* scale, const unsigned int scaleStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44TRS2(_StridedAt(translate, translateStride, i), _StridedAt(radians, radiansStride, i), _StridedAt(scale, scaleStride, i), rotateOrder);
+	}
+	DLL void Mat44ParentedStrided(const Mat44* child, const unsigned int childStride, const Mat44* parent, const unsigned int parentStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Parented(_StridedAt(child, childStride, i), _StridedAt(parent, parentStride, i));
+	}
+	DLL void Mat44MakeValidStrided(const Mat44* m, const unsigned int mStride, const Mat44ValidationFlags flags, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44MakeValid(_StridedAt(m, mStride, i), flags);
+	}
+	DLL void Mat44ToScaleStrided(const Mat44* m, const unsigned int mStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44ToScale(_StridedAt(m, mStride, i));
+	}
+	DLL void Mat44ToTranslateStrided(const Mat44* m, const unsigned int mStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44ToTranslate(_StridedAt(m, mStride, i));
+	}
+	DLL void Mat44FrustumStrided(const float* left, const unsigned int leftStride, const float* right, const unsigned int rightStride, const float* top, const unsigned int topStride, const float* bottom, const unsigned int bottomStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Frustum(_StridedAt(left, leftStride, i), _StridedAt(right, rightStride, i), _StridedAt(top, topStride, i), _StridedAt(bottom, bottomStride, i), _StridedAt(near, nearStride, i), _StridedAt(far, farStride, i));
+	}
+	DLL void Mat44PerspectiveXStrided(const float* horizontalFieldOfViewRadians, const unsigned int horizontalFieldOfViewRadiansStride, const float* aspectRatio, const unsigned int aspectRatioStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44PerspectiveX(_StridedAt(horizontalFieldOfViewRadians, horizontalFieldOfViewRadiansStride, i), _StridedAt(aspectRatio, aspectRatioStride, i), _StridedAt(near, nearStride, i), _StridedAt(far, farStride, i));
+	}
+	DLL void Mat44PerspectiveYStrided(const float* verticalFieldOfViewRadians, const unsigned int verticalFieldOfViewRadiansStride, const float* aspectRatio, const unsigned int aspectRatioStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44PerspectiveY(_StridedAt(verticalFieldOfViewRadians, verticalFieldOfViewRadiansStride, i), _StridedAt(aspectRatio, aspectRatioStride, i), _StridedAt(near, nearStride, i), _StridedAt(far, farStride, i));
+	}
+	DLL void Mat44OrthographicStrided(const float* left, const unsigned int leftStride, const float* right, const unsigned int rightStride, const float* top, const unsigned int topStride, const float* bottom, const unsigned int bottomStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44Orthographic(_StridedAt(left, leftStride, i), _StridedAt(right, rightStride, i), _StridedAt(top, topStride, i), _StridedAt(bottom, bottomStride, i), _StridedAt(near, nearStride, i), _StridedAt(far, farStride, i));
+	}
+	DLL void Mat44OrthoSymmetricStrided(const float* width, const unsigned int widthStride, const float* height, const unsigned int heightStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44OrthoSymmetric(_StridedAt(width, widthStride, i), _StridedAt(height, heightStride, i), _StridedAt(near, nearStride, i), _StridedAt(far, farStride, i));
+	}
+
+	DLL void QuatRotateXStrided(const float* radians, const unsigned int radiansStride, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatRotateX(_StridedAt(radians, radiansStride, i));
+	}
+	DLL void QuatRotateYStrided(const float* radians, const unsigned int radiansStride, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatRotateY(_StridedAt(radians, radiansStride, i));
+	}
+	DLL void QuatRotateZStrided(const float* radians, const unsigned int radiansStride, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatRotateZ(_StridedAt(radians, radiansStride, i));
+	}
+	DLL void QuatMulStrided(const Quat* lhs, const unsigned int lhsStride, const Quat* rhs, const unsigned int rhsStride, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatMul(_StridedAt(lhs, lhsStride, i), _StridedAt(rhs, rhsStride, i));
+	}
+	DLL void QuatDotStrided(const Quat* a, const unsigned int aStride, const Quat* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatDot(_StridedAt(a, aStride, i), _StridedAt(b, bStride, i));
+	}
+	DLL void QuatSqrMagnitudeStrided(const Quat* q, const unsigned int qStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatSqrMagnitude(_StridedAt(q, qStride, i));
+	}
+	DLL void QuatMagnitudeStrided(const Quat* q, const unsigned int qStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatMagnitude(_StridedAt(q, qStride, i));
+	}
+	DLL void QuatNormalizedStrided(const Quat* q, const unsigned int qStride, const Quat* fallback, const unsigned int fallbackStride, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatNormalized(_StridedAt(q, qStride, i), _StridedAt(fallback, fallbackStride, i));
+	}
+	DLL void QuatNormalizedModeStrided(const Quat* q, const unsigned int qStride, const Quat* fallback, const unsigned int fallbackStride, const ENormalizeMode mode, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatNormalizedMode(_StridedAt(q, qStride, i), _StridedAt(fallback, fallbackStride, i), mode);
+	}
+	DLL void QuatInversedStrided(const Quat* q, const unsigned int qStride, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatInversed(_StridedAt(q, qStride, i));
+	}
+	DLL void QuatConjugatedStrided(const Quat* q, const unsigned int qStride, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatConjugated(_StridedAt(q, qStride, i));
+	}
+	DLL void QuatSlerpStrided(const Quat* l, const unsigned int lStride, const Quat* r, const unsigned int rStride, const float* t, const unsigned int tStride, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatSlerp(_StridedAt(l, lStride, i), _StridedAt(r, rStride, i), _StridedAt(t, tStride, i));
+	}
+	DLL void QuatVectorTransformStrided(const Quat* q, const unsigned int qStride, const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatVectorTransform(_StridedAt(q, qStride, i), _StridedAt(v, vStride, i));
+	}
+	DLL void QuatToEulerStrided(const Quat* q, const unsigned int qStride, const ERotateOrder order, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatToEuler(_StridedAt(q, qStride, i), order);
+	}
+
+	DLL void Vec4DotStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec4Dot(_StridedAt(a, aStride, i), _StridedAt(b, bStride, i));
+	}
+	DLL void Vec4SqrMagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec4SqrMagnitude(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec4MagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec4Magnitude(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec4NormalizedStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec4Normalized(_StridedAt(v, vStride, i), _StridedAt(fallback, fallbackStride, i));
+	}
+	DLL void Vec4NormalizedModeStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, const ENormalizeMode mode, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec4NormalizedMode(_StridedAt(v, vStride, i), _StridedAt(fallback, fallbackStride, i), mode);
+	}
+	DLL void Vec4NormalizedUnsafeStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec4NormalizedUnsafe(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec4PerpendicularStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec4Perpendicular(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec3DotStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec3Dot(_StridedAt(a, aStride, i), _StridedAt(b, bStride, i));
+	}
+	DLL void Vec3CrossStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec3Cross(_StridedAt(a, aStride, i), _StridedAt(b, bStride, i));
+	}
+	DLL void Vec3SqrMagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec3SqrMagnitude(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec3MagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec3Magnitude(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec3NormalizedStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec3Normalized(_StridedAt(v, vStride, i), _StridedAt(fallback, fallbackStride, i));
+	}
+	DLL void Vec3NormalizedModeStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, const ENormalizeMode mode, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec3NormalizedMode(_StridedAt(v, vStride, i), _StridedAt(fallback, fallbackStride, i), mode);
+	}
+	DLL void Vec3NormalizedUnsafeStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec3NormalizedUnsafe(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec3PerpendicularStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec3Perpendicular(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec2DotStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec2Dot(_StridedAt(a, aStride, i), _StridedAt(b, bStride, i));
+	}
+	DLL void Vec2CrossStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec2Cross(_StridedAt(a, aStride, i), _StridedAt(b, bStride, i));
+	}
+	DLL void Vec2SqrMagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec2SqrMagnitude(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec2MagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec2Magnitude(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec2NormalizedStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec2Normalized(_StridedAt(v, vStride, i), _StridedAt(fallback, fallbackStride, i));
+	}
+	DLL void Vec2NormalizedModeStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, const ENormalizeMode mode, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec2NormalizedMode(_StridedAt(v, vStride, i), _StridedAt(fallback, fallbackStride, i), mode);
+	}
+	DLL void Vec2NormalizedUnsafeStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec2NormalizedUnsafe(_StridedAt(v, vStride, i));
+	}
+	DLL void Vec2PerpendicularStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Vec2Perpendicular(_StridedAt(v, vStride, i));
+	}
+
+	DLL void QuatToMat44Strided(const Quat* q, const unsigned int qStride, Mat44* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = QuatToMat44(_StridedAt(q, qStride, i));
+	}
+	DLL void Mat44ToQuatStrided(const Mat44* m, const unsigned int mStride, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44ToQuat(_StridedAt(m, mStride, i));
+	}
+	DLL void Mat44ToQuatModeStrided(const Mat44* m, const unsigned int mStride, const ENormalizeMode mode, Quat* result, const unsigned int resultStride, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			_StridedAt(result, resultStride, i) = Mat44ToQuatMode(_StridedAt(m, mStride, i), mode);
+	}
+}
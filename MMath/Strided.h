@@ -0,0 +1,114 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+// Generated by codegen.py, do not edit.
+#include "DLL.h"
+
+#include "Enums.h"
+#include "Vector.h"
+#include "Quat.h"
+#include "Mat44.h"
+
+extern "C"
+{
+	// Batch versions of the scalar functions: result[i] = Function(a[i], b[i], ...) for i < count.
+	// Every per element argument is a pointer with a stride in bytes, so fields of interleaved
+	// structures can be read and written in place. A stride of 0 repeats the first element.
+	// Strides of vectors, quaternions and matrices must be multiples of 16.
+	// A result may only alias an input in place: same start and same stride, as big as the larger of the two elements.
+	// Any other overlap, like QuatToMat44Strided over one compact buffer, overwrites inputs before they are read.
+	// Mat44.h
+	DLL void Mat44TranslateStrided(const float* x, const unsigned int xStride, const float* y, const unsigned int yStride, const float* z, const unsigned int zStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44RotateXStrided(const float* radians, const unsigned int radiansStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44RotateYStrided(const float* radians, const unsigned int radiansStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44RotateZStrided(const float* radians, const unsigned int radiansStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44ScaleStrided(const float* x, const unsigned int xStride, const float* y, const unsigned int yStride, const float* z, const unsigned int zStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44Scale2Strided(const __m128* scale, const unsigned int scaleStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44MulStrided(const Mat44* rhs, const unsigned int rhsStride, const Mat44* lhs, const unsigned int lhsStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44InversedStrided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44InversedFastStrided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44InversedFastNoScaleStrided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44TransposedStrided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44DeterminantStrided(const Mat44* m, const unsigned int mStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44VectorTransformStrided(const Mat44* m, const unsigned int mStride, const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44ToEulerStrided(const Mat44* m, const unsigned int mStride, const ERotateOrder ro, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44AxisAngleStrided(const __m128* axis, const unsigned int axisStride, const float* radians, const unsigned int radiansStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44AlignStrided(const __m128* from, const unsigned int fromStride, const __m128* to, const unsigned int toStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44RotateTowardsStrided(const __m128* from, const unsigned int fromStride, const __m128* to, const unsigned int toStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44LookAtStrided(const __m128* targetDirection, const unsigned int targetDirectionStride, const __m128* upDirection, const unsigned int upDirectionStride, const EAxis forward, const EAxis upAxis, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44FromVectorsStrided(const __m128* c0, const unsigned int c0Stride, const __m128* c1, const unsigned int c1Stride, const __m128* c2, const unsigned int c2Stride, const __m128* translate, const unsigned int translateStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44ToTop33Strided(const Mat44* m, const unsigned int mStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44DeltaStrided(const Mat44* m, const unsigned int mStride, const Mat44* newParent, const unsigned int newParentStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44RotateStrided(const float* radiansX, const unsigned int radiansXStride, const float* radiansY, const unsigned int radiansYStride, const float* radiansZ, const unsigned int radiansZStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44Rotate2Strided(const __m128* radians, const unsigned int radiansStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void EulerToMat44Strided(const __m128* radians, const unsigned int radiansStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44TranslateRotateStrided(const float* x, const unsigned int xStride, const float* y, const unsigned int yStride, const float* z, const unsigned int zStride, const float* radiansX, const unsigned int radiansXStride, const float* radiansY, const unsigned int radiansYStride, const float* radiansZ, const unsigned int radiansZStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44TranslateRotate2Strided(const __m128* translate, const unsigned int translateStride, const __m128* radians, const unsigned int radiansStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44TRSStrided(const float* x, const unsigned int xStride, const float* y, const unsigned int yStride, const float* z, const unsigned int zStride, const float* radiansX, const unsigned int radiansXStride, const float* radiansY, const unsigned int radiansYStride, const float* radiansZ, const unsigned int radiansZStride, const float* scaleX, const unsigned int scaleXStride, const float* scaleY, const unsigned int scaleYStride, const float* scaleZ, const unsigned int scaleZStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44TRS2Strided(const __m128* translate, const unsigned int translateStride, const __m128* radians, const unsigned int radiansStride, const __m128* scale, const unsigned int scaleStride, const ERotateOrder rotateOrder, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44ParentedStrided(const Mat44* child, const unsigned int childStride, const Mat44* parent, const unsigned int parentStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44MakeValidStrided(const Mat44* m, const unsigned int mStride, const Mat44ValidationFlags flags, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44ToScaleStrided(const Mat44* m, const unsigned int mStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44ToTranslateStrided(const Mat44* m, const unsigned int mStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44FrustumStrided(const float* left, const unsigned int leftStride, const float* right, const unsigned int rightStride, const float* top, const unsigned int topStride, const float* bottom, const unsigned int bottomStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44PerspectiveXStrided(const float* horizontalFieldOfViewRadians, const unsigned int horizontalFieldOfViewRadiansStride, const float* aspectRatio, const unsigned int aspectRatioStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44PerspectiveYStrided(const float* verticalFieldOfViewRadians, const unsigned int verticalFieldOfViewRadiansStride, const float* aspectRatio, const unsigned int aspectRatioStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44OrthographicStrided(const float* left, const unsigned int leftStride, const float* right, const unsigned int rightStride, const float* top, const unsigned int topStride, const float* bottom, const unsigned int bottomStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44OrthoSymmetricStrided(const float* width, const unsigned int widthStride, const float* height, const unsigned int heightStride, const float* near, const unsigned int nearStride, const float* far, const unsigned int farStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+
+	// Quat.h
+	DLL void QuatRotateXStrided(const float* radians, const unsigned int radiansStride, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatRotateYStrided(const float* radians, const unsigned int radiansStride, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatRotateZStrided(const float* radians, const unsigned int radiansStride, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatMulStrided(const Quat* lhs, const unsigned int lhsStride, const Quat* rhs, const unsigned int rhsStride, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatDotStrided(const Quat* a, const unsigned int aStride, const Quat* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatSqrMagnitudeStrided(const Quat* q, const unsigned int qStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatMagnitudeStrided(const Quat* q, const unsigned int qStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatNormalizedStrided(const Quat* q, const unsigned int qStride, const Quat* fallback, const unsigned int fallbackStride, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatNormalizedModeStrided(const Quat* q, const unsigned int qStride, const Quat* fallback, const unsigned int fallbackStride, const ENormalizeMode mode, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatInversedStrided(const Quat* q, const unsigned int qStride, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatConjugatedStrided(const Quat* q, const unsigned int qStride, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatSlerpStrided(const Quat* l, const unsigned int lStride, const Quat* r, const unsigned int rStride, const float* t, const unsigned int tStride, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatVectorTransformStrided(const Quat* q, const unsigned int qStride, const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void QuatToEulerStrided(const Quat* q, const unsigned int qStride, const ERotateOrder order, Vec* result, const unsigned int resultStride, const unsigned int count);
+
+	// Vector.h
+	DLL void Vec4DotStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec4SqrMagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec4MagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec4NormalizedStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec4NormalizedModeStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, const ENormalizeMode mode, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec4NormalizedUnsafeStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec4PerpendicularStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec3DotStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec3CrossStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec3SqrMagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec3MagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec3NormalizedStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec3NormalizedModeStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, const ENormalizeMode mode, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec3NormalizedUnsafeStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec3PerpendicularStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec2DotStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec2CrossStrided(const __m128* a, const unsigned int aStride, const __m128* b, const unsigned int bStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec2SqrMagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec2MagnitudeStrided(const __m128* v, const unsigned int vStride, float* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec2NormalizedStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec2NormalizedModeStrided(const __m128* v, const unsigned int vStride, const __m128* fallback, const unsigned int fallbackStride, const ENormalizeMode mode, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec2NormalizedUnsafeStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Vec2PerpendicularStrided(const __m128* v, const unsigned int vStride, Vec* result, const unsigned int resultStride, const unsigned int count);
+
+	// Friends.h
+	DLL void QuatToMat44Strided(const Quat* q, const unsigned int qStride, Mat44* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44ToQuatStrided(const Mat44* m, const unsigned int mStride, Quat* result, const unsigned int resultStride, const unsigned int count);
+	DLL void Mat44ToQuatModeStrided(const Mat44* m, const unsigned int mStride, const ENormalizeMode mode, Quat* result, const unsigned int resultStride, const unsigned int count);
+}
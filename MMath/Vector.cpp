@@ -16,24 +16,24 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "SIMD.h"
 #include <math.h>
 
-const __m128 F32_VEC2_MASK = { 1.0f, 1.0f, 0.0f, 0.0f };
-const __m128 F32_VEC3_MASK = { 1.0f, 1.0f, 1.0f, 0.0f };
+DLL_CONST const __m128 F32_VEC2_MASK = { 1.0f, 1.0f, 0.0f, 0.0f };
+DLL_CONST const __m128 F32_VEC3_MASK = { 1.0f, 1.0f, 1.0f, 0.0f };
 
-float VecMaskDot(__m128 a, __m128 b, __m128 mask)
+inline float VecMaskDot(__m128 a, __m128 b, __m128 mask)
 {
 	return Vec4Dot(_mm_mul_ps(a, mask), b);
 }
-float VecMaskSqrMagnitude(__m128 v, __m128 mask)
+inline float VecMaskSqrMagnitude(__m128 v, __m128 mask)
 {
 	v = _mm_mul_ps(v, mask);
 	return Vec4Dot(v, v);
 }
-float VecMaskMagnitude(__m128 v, __m128 mask)
+inline float VecMaskMagnitude(__m128 v, __m128 mask)
 {
 	v = _mm_mul_ps(v, mask);
 	return sqrtf(Vec4Dot(v, v));
 }
-Vec VecMaskNormalized(__m128 v, __m128 mask, __m128 fallback)
+inline Vec VecMaskNormalized(__m128 v, __m128 mask, __m128 fallback)
 {
 	v = _mm_mul_ps(v, mask);
 	__m128 a = _mm_mul_ps(v, v);
@@ -51,7 +51,29 @@ Vec VecMaskNormalized(__m128 v, __m128 mask, __m128 fallback)
 	return { _mm_blendv_ps(_mm_mul_ps(v, _mm_rsqrt_ps(a)), _mm_mul_ps(fallback, mask), isZero) };
 #endif
 }
-Vec VecMaskNormalized(__m128 v, __m128 mask)
+template<ENormalizeMode MODE>
+inline Vec VecMaskNormalizedMode(__m128 v, __m128 mask, __m128 fallback)
+{
+	v = _mm_mul_ps(v, mask);
+	__m128 a = _mm_mul_ps(v, v);
+	a = _mm_hadd_ps(a, a);
+	a = _mm_hadd_ps(a, a);
+	__m128 isZero = _mm_cmpeq_ps(a, F32_ZERO);
+	return { _mm_blendv_ps(_mm_mul_rsqrt_ps<MODE>(v, a), _mm_mul_ps(fallback, mask), isZero) };
+}
+inline Vec VecMaskNormalizedMode(__m128 v, __m128 mask, __m128 fallback, ENormalizeMode mode)
+{
+	switch (mode)
+	{
+	case ENormalizeMode::Fast:
+		return VecMaskNormalizedMode<ENormalizeMode::Fast>(v, mask, fallback);
+	case ENormalizeMode::Refined:
+		return VecMaskNormalizedMode<ENormalizeMode::Refined>(v, mask, fallback);
+	default:
+		return VecMaskNormalizedMode<ENormalizeMode::Exact>(v, mask, fallback);
+	}
+}
+inline Vec VecMaskNormalized(__m128 v, __m128 mask)
 {
 	v = _mm_mul_ps(v, mask);
 	__m128 a = _mm_mul_ps(v, v);
@@ -102,6 +124,11 @@ extern "C"
 #endif
 	}
 
+	DLL Vec Vec4NormalizedMode(const __m128 v, const __m128 fallback, const ENormalizeMode mode)
+	{
+		return VecMaskNormalizedMode(v, F32_ONE, fallback, mode);
+	}
+
 	DLL Vec Vec4NormalizedUnsafe(const __m128 v)
 	{
 		__m128 a = _mm_mul_ps(v, v);
@@ -116,6 +143,7 @@ extern "C"
 
 	DLL Vec Vec4Perpendicular(const __m128 v)
 	{
+#if 0
 		// Find a vector at 90 degrees from this vector in any plane this vector lies in, implented from this answer as reference:
 		// https://math.stackexchange.com/questions/133177/finding-a-unit-vector-perpendicular-to-another-vector/413235#413235
 		__m128 y = _mm_setzero_ps();
@@ -131,12 +159,23 @@ extern "C"
 		y.m128_f32[n] = v.m128_f32[m];
 		y.m128_f32[m] = -v.m128_f32[n];
 		return Vec4NormalizedUnsafe(y);
+#endif
+#if 1
+		// Same idea without scanning the lanes: swap the (x, y) or the (z, w) pair, whichever is longer, so the result
+		// is only zero for a zero vector, in which case the fallback is UNIT_X
+		__m128 sqr = _mm_mul_ps(v, v);
+		sqr = _mm_hadd_ps(sqr, sqr);
+		const __m128 useXY = _mm_cmpge_ps(_mm_swizzle_ps_0(sqr), _mm_swizzle_ps_1(sqr));
+		const __m128 swapped = _mm_mul_ps(_mm_swizzle_ps_1032(v), F32_SIGNFLIP_0101);
+		return Vec4Normalized(_mm_blendv_ps(_mm_blend_ps(swapped, F32_ZERO, 0b0011), _mm_blend_ps(swapped, F32_ZERO, 0b1100), useXY), F32_UNIT_X);
+#endif
 	}
 	
 	DLL float Vec3Dot(const __m128 a, const __m128 b) { return VecMaskDot(a, b, F32_VEC3_MASK); }
 	DLL float Vec3SqrMagnitude(const __m128 v) { return VecMaskSqrMagnitude(v, F32_VEC3_MASK); }
 	DLL float Vec3Magnitude(const __m128 v) { return VecMaskMagnitude(v, F32_VEC3_MASK); }
 	DLL Vec Vec3Normalized(const __m128 v, const __m128 fallback) { return VecMaskNormalized(v, F32_VEC3_MASK, fallback); }
+	DLL Vec Vec3NormalizedMode(const __m128 v, const __m128 fallback, const ENormalizeMode mode) { return VecMaskNormalizedMode(v, F32_VEC3_MASK, fallback, mode); }
 	DLL Vec Vec3NormalizedUnsafe(const __m128 v) { return VecMaskNormalized(v, F32_VEC3_MASK); }
 	
 	DLL Vec Vec3Cross(const __m128 a, const __m128 b)
@@ -149,6 +188,7 @@ extern "C"
 
 	DLL Vec Vec3Perpendicular(const __m128 v)
 	{
+#if 0
 		// Find a vector at 90 degrees from this vector in any plane this vector lies in, implented from this answer as reference:
 		// https://math.stackexchange.com/questions/133177/finding-a-unit-vector-perpendicular-to-another-vector/413235#413235
 		__m128 y = _mm_setzero_ps();
@@ -164,12 +204,22 @@ extern "C"
 		y.m128_f32[n] = v.m128_f32[m];
 		y.m128_f32[m] = -v.m128_f32[n];
 		return Vec4NormalizedUnsafe(y);
+#endif
+#if 1
+		// Same idea without scanning the lanes: cross with Z, (-y, x, 0), when |x| > |z| and with X, (0, -z, y), otherwise,
+		// so the result is only zero for a zero vector, in which case the fallback is UNIT_X
+		const __m128 a = _mm_andnot_ps(_mm_set_ps1(-0.0f), v);
+		const __m128 crossZ = _mm_mul_ps(_mm_blend_ps(_mm_swizzle_ps_1032(v), F32_ZERO, 0b1100), F32_SIGNFLIP_VEC3_100);
+		const __m128 crossX = _mm_mul_ps(_mm_blend_ps(_mm_swizzle_ps_2211(v), F32_ZERO, 0b1001), F32_SIGNFLIP_VEC3_010);
+		return Vec4Normalized(_mm_blendv_ps(crossX, crossZ, _mm_cmpgt_ps(_mm_swizzle_ps_0(a), _mm_swizzle_ps_2(a))), F32_UNIT_X);
+#endif
 	}
 
 	DLL float Vec2Dot(const __m128 a, const __m128 b) { return VecMaskDot(a, b, F32_VEC2_MASK); }
 	DLL float Vec2SqrMagnitude(const __m128 v) { return VecMaskSqrMagnitude(v, F32_VEC2_MASK); }
 	DLL float Vec2Magnitude(const __m128 v) { return VecMaskMagnitude(v, F32_VEC2_MASK); }
 	DLL Vec Vec2Normalized(const __m128 v, const __m128 fallback) { return VecMaskNormalized(v, F32_VEC2_MASK, fallback); }
+	DLL Vec Vec2NormalizedMode(const __m128 v, const __m128 fallback, const ENormalizeMode mode) { return VecMaskNormalizedMode(v, F32_VEC2_MASK, fallback, mode); }
 	DLL Vec Vec2NormalizedUnsafe(const __m128 v) { return VecMaskNormalized(v, F32_VEC2_MASK); }
 
 	DLL float Vec2Cross(const __m128 a, const __m128 b)
@@ -184,6 +234,7 @@ extern "C"
 
 	DLL Vec Vec2Perpendicular(const __m128 v)
 	{
+#if 0
 		// Find a vector at 90 degrees from this vector in any plane this vector lies in, implented from this answer as reference:
 		// https://math.stackexchange.com/questions/133177/finding-a-unit-vector-perpendicular-to-another-vector/413235#413235
 		__m128 y = _mm_setzero_ps();
@@ -199,13 +250,17 @@ extern "C"
 		y.m128_f32[n] = v.m128_f32[m];
 		y.m128_f32[m] = -v.m128_f32[n];
 		return Vec4NormalizedUnsafe(y);
+#endif
+#if 1
+		// (-y, x), UNIT_X for a zero vector
+		return Vec4Normalized(_mm_mul_ps(_mm_blend_ps(_mm_swizzle_ps_1032(v), F32_ZERO, 0b1100), F32_SIGNFLIP_VEC3_100), F32_UNIT_X);
+#endif
 	}
 }
 
 // This section is to export commonly used component-wise SIMD functions for vectors
 // C++ users should not be using these so they're not incuded in the header file.
 #include "SIMD.h"
-#include <windows.h>
 
 extern "C"
 {
@@ -218,8 +273,8 @@ extern "C"
 	DLL Vec VecAbs(const __m128 lhs) { return { _mm_abs_ps(lhs) }; }
 	DLL Vec VecSign(const __m128 lhs) { return { _mm_sign_ps(lhs) }; }
 	DLL Vec VecNegate(const __m128 lhs) { return { _mm_neg_ps(lhs) }; }
-	DLL Vec VecSin(const __m128 lhs) { return { _mm_sin_ps(lhs) }; }
-	DLL Vec VecCos(const __m128 lhs) { return { _mm_cos_ps(lhs) }; }
+	DLL Vec VecSin(const __m128 lhs) { __m128 s, c; _mm_sincos_ps(lhs, &s, &c); return { s }; }
+	DLL Vec VecCos(const __m128 lhs) { __m128 s, c; _mm_sincos_ps(lhs, &s, &c); return { c }; }
 	DLL Vec VecFloor(const __m128 lhs) { return { _mm_floor_ps(lhs) }; }
 	DLL Vec VecCeil(const __m128 lhs) { return { _mm_ceil_ps(lhs) }; }
 	DLL Vec VecRound(const __m128 lhs) { return { _mm_round_ps(lhs, _MM_FROUND_NINT) }; }
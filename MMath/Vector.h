@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "DLL.h"
 
 #include <xmmintrin.h>
+#include "Enums.h"
 
 extern "C"
 {
@@ -36,8 +37,9 @@ extern "C"
 	DLL float Vec4SqrMagnitude(const __m128 v); // Get the squared length of the vector, avoid Magnitude() and sqrt() calls whenever possible.
 	DLL float Vec4Magnitude(const __m128 v); // Get the length of the vector.
 	DLL Vec Vec4Normalized(const __m128 v, const __m128 fallback); // Divide the vector by it's own length. Returns fallback if input is ZERO (to avoid returning NaN or infinity).
+	DLL Vec Vec4NormalizedMode(const __m128 v, const __m128 fallback, const ENormalizeMode mode); // Normalized with a choice of precision, see ENormalizeMode. Vec4Normalized is the same as ENormalizeMode::Fast.
 	DLL Vec Vec4NormalizedUnsafe(const __m128 v); // This version has no fallback and will return garbage when used on zero-length vectors. Breaks in debug mode to help you spot when that happens.
-	DLL Vec Vec4Perpendicular(const __m128 v); // Find a vector at 90 degrees from this vector in any plane this vector lies in
+	DLL Vec Vec4Perpendicular(const __m128 v); // Find a vector at 90 degrees from this vector in any plane this vector lies in, normalized. Returns UNIT_X if the input is ZERO.
 
 	// As a rule of thumb all Vec3 functions return with w = 0 and assume the input w is garbage
 	DLL float Vec3Dot(const __m128 a, const __m128 b);
@@ -45,8 +47,9 @@ extern "C"
 	DLL float Vec3SqrMagnitude(const __m128 v);
 	DLL float Vec3Magnitude(const __m128 v);
 	DLL Vec Vec3Normalized(const __m128 v, const __m128 fallback);
+	DLL Vec Vec3NormalizedMode(const __m128 v, const __m128 fallback, const ENormalizeMode mode);
 	DLL Vec Vec3NormalizedUnsafe(const __m128 v);
-	DLL Vec Vec3Perpendicular(const __m128 v); // Find a vector at 90 degrees from this vector in any plane this vector lies in
+	DLL Vec Vec3Perpendicular(const __m128 v); // Find a vector at 90 degrees from this vector in any plane this vector lies in, normalized. Returns UNIT_X if the input is ZERO.
 
 	// As a rule of thumb all Vec2 functions return with zw = 0 and assume the input zw is garbage
 	DLL float Vec2Dot(const __m128 a, const __m128 b);
@@ -54,8 +57,9 @@ extern "C"
 	DLL float Vec2SqrMagnitude(const __m128 v);
 	DLL float Vec2Magnitude(const __m128 v);
 	DLL Vec Vec2Normalized(const __m128 v, const __m128 fallback);
+	DLL Vec Vec2NormalizedMode(const __m128 v, const __m128 fallback, const ENormalizeMode mode);
 	DLL Vec Vec2NormalizedUnsafe(const __m128 v);
-	DLL Vec Vec2Perpendicular(const __m128 v); // Find a vector at 90 degrees from this vector in any plane this vector lies in
+	DLL Vec Vec2Perpendicular(const __m128 v); // Find a vector at 90 degrees from this vector in any plane this vector lies in, normalized. Returns UNIT_X if the input is ZERO.
 }
 
 extern const __m128 F32_VEC2_MASK;
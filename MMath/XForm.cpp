@@ -0,0 +1,131 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "XForm.h"
+#include "DualQuat.h"
+#include "Friends.h"
+#include "SIMD.h"
+#include "Dispatch.h"
+
+// _DualQuatVectorTransform is a plain quaternion rotation, v + 2 * cross(q.xyz, cross(q.xyz, v) + q.w * v).
+// It keeps the w of v, so translations and scales are kept at w = 0.
+
+// Mat44ToQuat normalizes with rsqrt, which is not accurate enough to round trip
+__forceinline Quat _XFormRotation(const Mat44& rotation)
+{
+	return Mat44ToQuatMode(rotation, ENormalizeMode::Exact);
+}
+
+__forceinline XFormScale _XFormScaleMul(const XFormScale& lhs, const XFormScale& rhs)
+{
+	XFormScale r;
+	r.rotation = DISPATCH(QuatMul)(lhs.rotation, rhs.rotation);
+	r.translate = _mm_add_ps(_DualQuatVectorTransform(rhs.rotation.q, _mm_mul_ps(lhs.translate, rhs.scale)), rhs.translate);
+	r.scale = _mm_mul_ps(lhs.scale, rhs.scale);
+	return r;
+}
+
+extern "C"
+{
+	DLL XForm XFormIdentity()
+	{
+		return { { F32_UNIT_W }, F32_ZERO };
+	}
+	DLL XForm XFormMul(const XForm lhs, const XForm rhs)
+	{
+		return { DISPATCH(QuatMul)(lhs.rotation, rhs.rotation), _mm_add_ps(_DualQuatVectorTransform(rhs.rotation.q, lhs.translate), rhs.translate) };
+	}
+	DLL XForm XFormInversed(const XForm x)
+	{
+		const __m128 rotation = _mm_mul_ps(x.rotation.q, F32_SIGNFLIP_1110);
+		return { { rotation }, _mm_sub_ps(F32_ZERO, _DualQuatVectorTransform(rotation, x.translate)) };
+	}
+	DLL Vec XFormPointTransform(const XForm x, const __m128 p)
+	{
+		return { _mm_add_ps(_DualQuatVectorTransform(x.rotation.q, _mm_blend_ps(p, F32_ZERO, 0b1000)), _mm_blend_ps(x.translate, F32_ONE, 0b1000)) };
+	}
+	DLL Vec XFormVectorTransform(const XForm x, const __m128 v)
+	{
+		return { _DualQuatVectorTransform(x.rotation.q, _mm_blend_ps(v, F32_ZERO, 0b1000)) };
+	}
+	DLL Mat44 XFormToMat44(const XForm x)
+	{
+		Mat44 m = DISPATCH(QuatToMat44)(x.rotation);
+		m.col3 = _mm_blend_ps(x.translate, F32_ONE, 0b1000);
+		return m;
+	}
+	DLL XForm Mat44ToXForm(const Mat44 m)
+	{
+		return { _XFormRotation(m), _mm_blend_ps(m.col3, F32_ZERO, 0b1000) };
+	}
+
+	DLL XFormScale XFormScaleIdentity()
+	{
+		return { { F32_UNIT_W }, F32_ZERO, _mm_blend_ps(F32_ONE, F32_ZERO, 0b1000) };
+	}
+	DLL XFormScale XFormScaleMul(const XFormScale lhs, const XFormScale rhs)
+	{
+		return _XFormScaleMul(lhs, rhs);
+	}
+	DLL XFormScale XFormScaleInversed(const XFormScale x)
+	{
+		// 1 / scale, with 0 instead of inf for collapsed axes (and w), mirrored axes invert like any other
+		const __m128 inverseScale = _mm_and_ps(_mm_div_ps(F32_ONE, x.scale), _mm_cmpneq_ps(x.scale, F32_ZERO));
+		const __m128 rotation = _mm_mul_ps(x.rotation.q, F32_SIGNFLIP_1110);
+		return { { rotation }, _mm_mul_ps(_DualQuatVectorTransform(rotation, x.translate), _mm_sub_ps(F32_ZERO, inverseScale)), inverseScale };
+	}
+	DLL Vec XFormScalePointTransform(const XFormScale x, const __m128 p)
+	{
+		return { _mm_add_ps(_DualQuatVectorTransform(x.rotation.q, _mm_mul_ps(p, x.scale)), _mm_blend_ps(x.translate, F32_ONE, 0b1000)) };
+	}
+	DLL Vec XFormScaleVectorTransform(const XFormScale x, const __m128 v)
+	{
+		return { _DualQuatVectorTransform(x.rotation.q, _mm_mul_ps(v, x.scale)) };
+	}
+	DLL Mat44 XFormScaleToMat44(const XFormScale x)
+	{
+		Mat44 m = DISPATCH(QuatToMat44)(x.rotation);
+		m.col0 = _mm_mul_ps(m.col0, _mm_swizzle_ps_0(x.scale));
+		m.col1 = _mm_mul_ps(m.col1, _mm_swizzle_ps_1(x.scale));
+		m.col2 = _mm_mul_ps(m.col2, _mm_swizzle_ps_2(x.scale));
+		m.col3 = _mm_blend_ps(x.translate, F32_ONE, 0b1000);
+		return m;
+	}
+	DLL XFormScale Mat44ToXFormScale(const Mat44 m)
+	{
+		const __m128 scale = Mat44ToScale(m).s;
+		// 1 / scale, with 0 instead of inf for collapsed axes, those get no rotation
+		const __m128 inverseScale = _mm_and_ps(_mm_div_ps(F32_ONE, scale), _mm_cmpneq_ps(scale, F32_ZERO));
+		Mat44 rotation;
+		rotation.col0 = _mm_mul_ps(m.col0, _mm_swizzle_ps_0(inverseScale));
+		rotation.col1 = _mm_mul_ps(m.col1, _mm_swizzle_ps_1(inverseScale));
+		rotation.col2 = _mm_mul_ps(m.col2, _mm_swizzle_ps_2(inverseScale));
+		rotation.col3 = F32_UNIT_W;
+		return { _XFormRotation(rotation), _mm_blend_ps(m.col3, F32_ZERO, 0b1000), scale };
+	}
+
+	DLL void XFormToMat44Array(const XForm* xforms, Mat44* result, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = XFormToMat44(xforms[i]);
+	}
+	DLL void XFormScaleToMat44Array(const XFormScale* xforms, Mat44* result, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = XFormScaleToMat44(xforms[i]);
+	}
+	DLL void XFormScaleMulArray(const XFormScale* children, const XFormScale* parents, XFormScale* result, const unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			result[i] = _XFormScaleMul(children[i], parents[i]);
+	}
+}
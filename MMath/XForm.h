@@ -0,0 +1,60 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+#include "DLL.h"
+
+#include "Vector.h"
+#include "Quat.h"
+#include "Mat44.h"
+
+extern "C"
+{
+	// Rigid transform as rotation + translation, composes and inverts without going through a Mat44.
+	// Points are rotated, then translated. w of translate is 0.
+	__declspec(align(16)) struct XForm
+	{
+		Quat rotation;
+		__m128 translate;
+	};
+
+	// Same with a scale that is applied before the rotation, like Mat44TRS2. w of translate and scale is 0.
+	// Non-uniform scale under a rotated child is shear, which this can not represent, so XFormScaleMul and XFormScaleInversed
+	// (like most engines) keep rotation and scale separate and are only exact when the scale of the parent is uniform.
+	__declspec(align(16)) struct XFormScale
+	{
+		Quat rotation;
+		__m128 translate;
+		__m128 scale;
+	};
+
+	DLL XForm XFormIdentity();
+	DLL XForm XFormMul(const XForm lhs, const XForm rhs); // lhs then rhs, same order as QuatMul and Mat44Mul
+	DLL XForm XFormInversed(const XForm x);
+	DLL Vec XFormPointTransform(const XForm x, const __m128 p); // rotate and translate, w = 1
+	DLL Vec XFormVectorTransform(const XForm x, const __m128 v); // rotate only, w = 0
+	DLL Mat44 XFormToMat44(const XForm x);
+	DLL XForm Mat44ToXForm(const Mat44 m); // m must be rigid, use Mat44ToXFormScale for scaled matrices
+
+	DLL XFormScale XFormScaleIdentity();
+	DLL XFormScale XFormScaleMul(const XFormScale lhs, const XFormScale rhs); // lhs then rhs, see the shear note above
+	DLL XFormScale XFormScaleInversed(const XFormScale x); // zero scale axes stay zero, see the shear note above
+	DLL Vec XFormScalePointTransform(const XFormScale x, const __m128 p); // scale, rotate and translate, w = 1
+	DLL Vec XFormScaleVectorTransform(const XFormScale x, const __m128 v); // scale and rotate, w = 0
+	DLL Mat44 XFormScaleToMat44(const XFormScale x);
+	DLL XFormScale Mat44ToXFormScale(const Mat44 m); // assumes no shear, like Mat44ToTRSArray
+
+	// Batch versions. The matrices are bigger than the transforms, so the ToMat44 results must not alias the input
+	DLL void XFormToMat44Array(const XForm* xforms, Mat44* result, const unsigned int count);
+	DLL void XFormScaleToMat44Array(const XFormScale* xforms, Mat44* result, const unsigned int count);
+	DLL void XFormScaleMulArray(const XFormScale* children, const XFormScale* parents, XFormScale* result, const unsigned int count); // result may alias either input
+}
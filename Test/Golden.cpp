@@ -0,0 +1,131 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#include "Golden.h"
+#include <string.h>
+#include <xmmintrin.h>
+#include <Windows.h>
+#undef min
+#undef max
+
+unsigned int GoldenId(const char* name)
+{
+	unsigned int hash = 2166136261u;
+	for (; *name; ++name)
+		hash = (hash ^ (unsigned char)*name) * 16777619u;
+	return hash;
+}
+
+static bool _GoldenValid(const GoldenFile& file)
+{
+	if (file.size < sizeof(GoldenHeader) || memcmp(file.header->magic, "MMGD", 4) != 0 || file.header->version != GOLDEN_VERSION)
+		return false;
+	if (file.size < sizeof(GoldenHeader) + sizeof(GoldenBlock) * (unsigned long long)file.header->blockCount)
+		return false;
+	for (unsigned int i = 0; i < file.header->blockCount; ++i)
+	{
+		const GoldenBlock& block = file.blocks[i];
+		if (memchr(block.name, 0, sizeof(block.name)) == nullptr || block.id != GoldenId(block.name))
+			return false;
+		if (block.inputOffset % 64 != 0 || block.outputOffset % 64 != 0)
+			return false;
+		if (block.inputOffset + 4ull * block.caseCount * block.inputFloats > file.size || block.outputOffset + 4ull * block.caseCount * block.outputFloats > file.size)
+			return false;
+	}
+	return true;
+}
+
+bool GoldenOpen(const char* path, GoldenFile& file)
+{
+	memset(&file, 0, sizeof(file));
+	HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+	file.fileHandle = handle;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0)
+	{
+		GoldenClose(file);
+		return false;
+	}
+	file.size = (unsigned long long)size.QuadPart;
+	file.mappingHandle = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (file.mappingHandle)
+		file.data = (const unsigned char*)MapViewOfFile(file.mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (!file.data)
+	{
+		GoldenClose(file);
+		return false;
+	}
+	file.header = (const GoldenHeader*)file.data;
+	file.blocks = (const GoldenBlock*)(file.data + sizeof(GoldenHeader));
+	if (!_GoldenValid(file))
+	{
+		GoldenClose(file);
+		return false;
+	}
+	return true;
+}
+
+void GoldenClose(GoldenFile& file)
+{
+	if (file.data)
+		UnmapViewOfFile(file.data);
+	if (file.mappingHandle)
+		CloseHandle(file.mappingHandle);
+	if (file.fileHandle)
+		CloseHandle(file.fileHandle);
+	memset(&file, 0, sizeof(file));
+}
+
+const GoldenBlock* GoldenFind(const GoldenFile& file, const unsigned int id)
+{
+	for (unsigned int i = 0; i < file.header->blockCount; ++i)
+	{
+		if (file.blocks[i].id == id)
+			return &file.blocks[i];
+	}
+	return nullptr;
+}
+
+GoldenError GoldenCompare(const float* expected, const float* actual, const unsigned int floatsPerCase, const unsigned int caseCount, const float tolerance)
+{
+	GoldenError error = {};
+	if (floatsPerCase == 0)
+		return error;
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	double total = 0.0;
+	for (unsigned int c = 0; c < caseCount; ++c, expected += floatsPerCase, actual += floatsPerCase)
+	{
+		// 4 floats at a time, the rest (3 for vectors, 1 for determinants) one by one
+		__m128 sum = _mm_setzero_ps();
+		unsigned int i = 0;
+		for (; i + 4 <= floatsPerCase; i += 4)
+			sum = _mm_add_ps(sum, _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(expected + i), _mm_loadu_ps(actual + i)), absMask));
+		for (; i < floatsPerCase; ++i)
+			sum = _mm_add_ss(sum, _mm_and_ps(_mm_sub_ss(_mm_load_ss(expected + i), _mm_load_ss(actual + i)), absMask));
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+		const float mean = _mm_cvtss_f32(sum) / (float)floatsPerCase;
+		if (!(mean <= tolerance))
+			++error.failedCases;
+		// The first NaN sticks as the worst case
+		if (!(mean <= error.max) && error.max == error.max)
+		{
+			error.max = mean;
+			error.worstCase = c;
+		}
+		total += mean;
+	}
+	error.mean = (float)(total / caseCount);
+	return error;
+}
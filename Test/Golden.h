@@ -0,0 +1,80 @@
+/**
+MMath - vector math library for 3D applications.
+Released under the MIT License:
+
+Copyright 2020 Trevor van Hoof
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**/
+#pragma once
+
+// Binary golden data: the inputs and expected outputs of many calls per function, as float32 arrays that are
+// compared straight from a memory mapped file. golden.py writes it from the in.json and out.json that Maya produced.
+//
+// Layout, little endian:
+// GoldenHeader
+// GoldenBlock[blockCount], one per function
+// float data, every array starts on a 64 byte boundary:
+//   inputs: caseCount * inputFloats, the arguments of a call flattened in order (rotate orders are stored as floats)
+//   outputs: caseCount * outputFloats, the expected result of each call
+
+static const unsigned int GOLDEN_VERSION = 1;
+// Mean absolute error per float a call may have, tweaked for Mat44Delta which has by far the largest error (see test_out_compare.py)
+static const float GOLDEN_TOLERANCE = 0.0002f;
+
+struct GoldenHeader
+{
+	char magic[4]; // "MMGD"
+	unsigned int version;
+	unsigned int blockCount;
+	unsigned int reserved;
+};
+
+struct GoldenBlock
+{
+	char name[40]; // zero terminated function name
+	unsigned int id; // GoldenId(name)
+	unsigned int arity; // arguments per call
+	unsigned int caseCount;
+	unsigned int inputFloats; // per call
+	unsigned int outputFloats; // per call
+	unsigned int reserved;
+	unsigned long long inputOffset; // in bytes from the start of the file
+	unsigned long long outputOffset;
+};
+static_assert(sizeof(GoldenHeader) == 16 && sizeof(GoldenBlock) == 80, "Must match golden.py");
+
+struct GoldenFile
+{
+	const unsigned char* data;
+	unsigned long long size;
+	const GoldenHeader* header;
+	const GoldenBlock* blocks;
+	void* fileHandle;
+	void* mappingHandle;
+};
+
+// Stable function ID, 32 bit FNV-1a of the name
+unsigned int GoldenId(const char* name);
+// Maps the file read only and validates the header and block table, the data is never copied.
+bool GoldenOpen(const char* path, GoldenFile& file);
+void GoldenClose(GoldenFile& file);
+const GoldenBlock* GoldenFind(const GoldenFile& file, const unsigned int id);
+inline const float* GoldenInputs(const GoldenFile& file, const GoldenBlock& block) { return (const float*)(file.data + block.inputOffset); }
+inline const float* GoldenOutputs(const GoldenFile& file, const GoldenBlock& block) { return (const float*)(file.data + block.outputOffset); }
+
+struct GoldenError
+{
+	float mean; // mean absolute error per float, averaged over all calls
+	float max; // of the per call means
+	unsigned int worstCase;
+	unsigned int failedCases; // calls whose mean absolute error per float exceeds the tolerance, or is NaN
+};
+
+// Compares caseCount results of floatsPerCase floats each. Like test_out_compare.py a call fails when the
+// mean absolute error of its floats exceeds tolerance, Maya works in doubles so exact matches are not expected.
+GoldenError GoldenCompare(const float* expected, const float* actual, const unsigned int floatsPerCase, const unsigned int caseCount, const float tolerance);
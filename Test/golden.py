@@ -0,0 +1,93 @@
+"""
+Writes the binary golden data that Test.exe memory maps, see Golden.h for the layout.
+Run it after maya_generate_json.py to convert in.json and out.json, or call write() directly with the same dictionaries.
+Works in Maya's Python 2 as well as Python 3.
+"""
+import json
+import os
+import struct
+from collections import OrderedDict
+
+MAGIC = b'MMGD'
+VERSION = 1
+HEADER = '<4sIII'
+BLOCK = '<40sIIIIIIQQ'
+ALIGN = 64
+
+
+def functionId(name):
+    # FNV-1a, GoldenId in Golden.cpp must agree
+    h = 2166136261
+    for c in bytearray(name.encode('ascii')):
+        h = ((h ^ c) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def flatten(value):
+    if isinstance(value, (list, tuple)):
+        result = []
+        for item in value:
+            result += flatten(item)
+        return result
+    return [float(value)]
+
+
+def cases(name, inData, outData):
+    # Returns (arity, [flat inputs per case], [flat outputs per case]).
+    # Most functions have a list of argument tuples with one result each, a few (Mat44Identity, Mat44FromVectors,
+    # Mat44PerspectiveX) are a single call whose arguments and result are stored flat.
+    out = outData[name]
+    if name not in inData:
+        return 0, [[]], [flatten(out)]
+    args = inData[name]
+    if len(args) == len(out) and isinstance(args[0], (list, tuple)):
+        arity = len(args[0])
+        if name in ('Mat44ToTranslate', 'Mat44ToScale'):
+            arity = 1  # stored as the bare matrix instead of a tuple of one matrix
+        return arity, [flatten(a) for a in args], [flatten(o) for o in out]
+    return len(args), [flatten(args)], [flatten(out)]
+
+
+def write(fp, inData, outData):
+    blocks = []
+    for name in outData:
+        arity, inputs, outputs = cases(name, inData, outData)
+        for i, o in zip(inputs, outputs):
+            assert len(i) == len(inputs[0]) and len(o) == len(outputs[0]), name
+        blocks.append((name, arity, inputs, outputs))
+
+    def aligned(offset):
+        return (offset + ALIGN - 1) // ALIGN * ALIGN
+
+    table = []
+    offset = aligned(struct.calcsize(HEADER) + struct.calcsize(BLOCK) * len(blocks))
+    for name, arity, inputs, outputs in blocks:
+        assert len(name) < 40, name
+        inputOffset = offset
+        offset = aligned(offset + 4 * len(inputs) * len(inputs[0]))
+        outputOffset = offset
+        offset = aligned(offset + 4 * len(outputs) * len(outputs[0]))
+        table.append((name, arity, inputs, outputs, inputOffset, outputOffset))
+
+    with open(fp, 'wb') as fh:
+        fh.write(struct.pack(HEADER, MAGIC, VERSION, len(blocks), 0))
+        for name, arity, inputs, outputs, inputOffset, outputOffset in table:
+            fh.write(struct.pack(BLOCK, name.encode('ascii'), functionId(name), arity, len(inputs), len(inputs[0]), len(outputs[0]), 0, inputOffset, outputOffset))
+        for name, arity, inputs, outputs, inputOffset, outputOffset in table:
+            for offset, values in ((inputOffset, inputs), (outputOffset, outputs)):
+                fh.write(b'\0' * (offset - fh.tell()))
+                for value in values:
+                    fh.write(struct.pack('<%df' % len(value), *value))
+
+
+def convert(inPath, outPath, goldenPath):
+    with open(inPath) as fh:
+        inData = json.load(fh, object_pairs_hook=OrderedDict)
+    with open(outPath) as fh:
+        outData = json.load(fh, object_pairs_hook=OrderedDict)
+    write(goldenPath, inData, outData)
+
+
+if __name__ == '__main__':
+    here = os.path.dirname(os.path.abspath(__file__))
+    convert(os.path.join(here, 'in.json'), os.path.join(here, 'out.json'), os.path.join(here, 'maya.golden'))
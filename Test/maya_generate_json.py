@@ -447,6 +447,10 @@ def run():
     dump(inData, outDir + '\\in.json')
     dump(outData, outDir + '\\out.json')
 
+    # the binary version of the same data that Test.exe reads
+    import golden
+    golden.write(outDir + '\\maya.golden', inData, outData)
+
 """
 import maya_generate_json
 reload(maya_generate_json)
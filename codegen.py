@@ -1,60 +1,300 @@
 # This utility regenerates a bunch of mmath.py, it is not fool proof so take caution with copying parts over.
+# The scalar bindings are printed for copying, the strided batch functions are written out directly:
+# MMath/Strided.h, MMath/Strided.cpp and the codegen:strided block at the end of mmath.py.
+# Benchmark/Generated.cpp times every value based function and every strided function.
 
 import re
 import os
 
 pat = re.compile('DLL[ \t]*([a-zA-Z0-9_]+)[ \t]*([a-zA-Z0-9_]+)[ \t]*\((.*?)\)[ \t]*;', re.DOTALL | re.MULTILINE)
+definitionPat = re.compile('DLL[ \t]*([a-zA-Z0-9_]+)[ \t]*([a-zA-Z0-9_]+)[ \t]*\(([^()]*)\)\s*\{', re.DOTALL | re.MULTILINE)
+commentPat = re.compile(r'//[^\n]*|/\*.*?\*/', re.DOTALL)
 
-wrapperCode = []
-dllCode = []
+root = os.path.dirname(os.path.abspath(__file__))
 
 keys = ('Mat44', 'Quat', 'Vector', 'Friends')
+# Headers with functions that take and return values, the rest is benchmarked by hand in Benchmark/Batch.cpp
+BENCHMARK_KEYS = ('MMath', 'SIMD', 'Vector', 'Quat', 'Mat44', 'Mat34', 'Friends', 'DualQuat', 'XForm')
+BENCHMARK_TYPES = ('float', '__m128', 'Quat', 'Mat44', 'Mat34', 'DualQuat', 'XForm', 'XFormScale', 'ERotateOrder', 'EAxis', 'Mat44ValidationFlags', 'ENormalizeMode', 'bool')
+BENCHMARK_RESULT_TYPES = ('float', 'Vec', '__m128', 'Quat', 'Mat44', 'Mat34', 'DualQuat', 'XForm', 'XFormScale', 'Mat44ValidationFlags', 'bool')
+
+# Per element types for the strided functions and how many floats they hold, other argument types are uniform
+STRIDED_TYPES = {'float': 1, '__m128': 4, 'Quat': 4, 'Mat44': 16}
+STRIDED_RESULT_TYPES = {'float': 1, 'Vec': 4, 'Quat': 4, 'Mat44': 16}
+UNIFORM_TYPES = {'ERotateOrder': 'ERotateOrder', 'EAxis': 'EAxis', 'Mat44ValidationFlags': 'Mat44ValidationFlags', 'ENormalizeMode': 'ENormalizeMode', 'bool': 'ctypes.c_bool'}
+PY_KEYWORDS = ('from', 'in', 'is', 'lambda', 'global', 'pass')
+
+BEGIN_MARKER = '# <codegen:strided>\n'
+END_MARKER = '# </codegen:strided>\n'
 
-for file_name in keys:
-    dllCode.append('    # %s.h' % file_name)
-    mat44 = os.path.join(os.path.abspath(__file__) + '/../MMath/%s.h' % file_name)
-    with open(mat44) as fh:
-        code = fh.read()
 
-    for match in pat.finditer(code):
-        # if the first argument is not T, this is a static method
-        funcName = match.group(2)
-        # find second capital letter to get type name
-        i = 1
-        while funcName[i] not in r'ABCDEFGHIJKLMNOPQRSTUVWXYZ':
-            i += 1
-        T = funcName[:i]
+def parse(file_name, pattern=pat):
+    # yields (restype, funcName, [(type, name), ...]) for every DLL function that is not commented out
+    with open(os.path.join(root, 'MMath', file_name if '.' in file_name else '%s.h' % file_name)) as fh:
+        code = commentPat.sub('', fh.read())
+    for match in pattern.finditer(code):
         args = match.group(3).strip()
         if args:
             args = [a.strip().rsplit(' ', 1) for a in args.split(',')]
+            args = [(T[len('const '):] if T.startswith('const ') else T, name) for T, name in args]
+            args = [(T.strip(), name) for T, name in args]
         else:
             args = []
-        if not args or args[0][0] != T:
-            wrapperCode.append('    @staticmethod')
-        else:
-            args[0][1] = 'self'
-        argNames = ', '.join(a[1] for a in args)
-        pyArgTypes = []
-        for a in args:
-            if a[0] == 'float':
-                pyArgTypes.append('ctypes.c_float')
+        yield match.group(1), match.group(2), args
+
+
+def pyName(name):
+    return '_' + name if name in PY_KEYWORDS else name
+
+
+def scalarBindings(parsed):
+    wrapperCode = []
+    dllCode = []
+    for file_name, functions in parsed:
+        dllCode.append('    # %s.h' % file_name)
+        for restype, funcName, args in functions:
+            if any('*' in a[0] for a in args):
+                # batch functions are bound by hand
+                continue
+            # find second capital letter to get type name
+            i = 1
+            while funcName[i] not in r'ABCDEFGHIJKLMNOPQRSTUVWXYZ':
+                i += 1
+            T = funcName[:i]
+            args = [list(a) for a in args]
+            if not args or args[0][0] != T:
+                wrapperCode.append('    @staticmethod')
             else:
-                pyArgTypes.append(a[0])
+                args[0][1] = 'self'
+            argNames = ', '.join(a[1] for a in args)
+            pyArgTypes = []
+            for a in args:
+                if a[0] == 'float':
+                    pyArgTypes.append('ctypes.c_float')
+                else:
+                    pyArgTypes.append(a[0])
 
-        if len(pyArgTypes) == 0:
-            pyArgTypes = 'tuple()'
-        elif len(pyArgTypes) == 1:
-            pyArgTypes = '(%s,)' % pyArgTypes[0]
+            if len(pyArgTypes) == 0:
+                pyArgTypes = 'tuple()'
+            elif len(pyArgTypes) == 1:
+                pyArgTypes = '(%s,)' % pyArgTypes[0]
+            else:
+                pyArgTypes = '(%s)' % ', '.join(pyArgTypes)
+            pyFuncName = funcName[len(T):]
+            pyFuncName = pyFuncName[0].lower() + pyFuncName[1:]
+            wrapperCode.append(
+                '    def %s(%s):\n        return _dll().%s(%s)\n' % (pyFuncName, argNames, funcName, argNames))
+            dllCode.append('    _instance.%s.argtypes = %s' % (funcName, pyArgTypes))
+            dllCode.append('    _instance.%s.restype = %s' % (funcName, restype))
+
+        print('\n'.join(wrapperCode).replace('__m128', 'Float4').replace('from', '_from'))
+        del wrapperCode[:]
+
+    print('\n'.join(dllCode).replace('__m128', 'Float4'))
+
+
+def isStrided(restype, args):
+    # only pure functions of per element values can be batched, at least one argument must vary per element
+    if restype not in STRIDED_RESULT_TYPES:
+        return False
+    if not any(T in STRIDED_TYPES for T, name in args):
+        return False
+    return all(T in STRIDED_TYPES or T in UNIFORM_TYPES for T, name in args)
+
+
+def stridedSignature(restype, funcName, args):
+    params = []
+    for T, name in args:
+        if T in STRIDED_TYPES:
+            params.append('const %s* %s, const unsigned int %sStride' % (T, name, name))
         else:
-            pyArgTypes = '(%s)' % ', '.join(pyArgTypes)
-        pyFuncName = funcName[len(T):]
-        pyFuncName = pyFuncName[0].lower() + pyFuncName[1:]
-        wrapperCode.append(
-            '    def %s(%s):\n        return _dll().%s(%s)\n' % (pyFuncName, argNames, funcName, argNames))
-        dllCode.append('    _instance.%s.argtypes = %s' % (funcName, pyArgTypes))
-        dllCode.append('    _instance.%s.restype = %s' % (funcName, match.group(1)))
-
-    print('\n'.join(wrapperCode).replace('__m128', 'Float4').replace('from', '_from'))
-    del wrapperCode[:]
-
-print('\n'.join(dllCode).replace('__m128', 'Float4'))
+            params.append('const %s %s' % (T, name))
+    params.append('%s* result, const unsigned int resultStride, const unsigned int count' % restype)
+    return 'DLL void %sStrided(%s)' % (funcName, ', '.join(params))
+
+
+def stridedCpp(parsed, license):
+    header = [license,
+              '#pragma once',
+              '// Generated by codegen.py, do not edit.',
+              '#include "DLL.h"',
+              '',
+              '#include "Enums.h"',
+              '#include "Vector.h"',
+              '#include "Quat.h"',
+              '#include "Mat44.h"',
+              '',
+              'extern "C"',
+              '{',
+              '\t// Batch versions of the scalar functions: result[i] = Function(a[i], b[i], ...) for i < count.',
+              '\t// Every per element argument is a pointer with a stride in bytes, so fields of interleaved',
+              '\t// structures can be read and written in place. A stride of 0 repeats the first element.',
+              '\t// Strides of vectors, quaternions and matrices must be multiples of 16.',
+              '\t// A result may only alias an input in place: same start and same stride, as big as the larger of the two elements.',
+              '\t// Any other overlap, like QuatToMat44Strided over one compact buffer, overwrites inputs before they are read.']
+    source = [license,
+              '// Generated by codegen.py, do not edit.',
+              '#include "Strided.h"',
+              '#include "Friends.h"',
+              '',
+              '// Element i of a strided array',
+              'template<typename T>',
+              '__forceinline T& _StridedAt(T* data, const unsigned int stride, const unsigned int i)',
+              '{',
+              '\treturn *(T*)((char*)data + (size_t)stride * i);',
+              '}',
+              'template<typename T>',
+              '__forceinline const T& _StridedAt(const T* data, const unsigned int stride, const unsigned int i)',
+              '{',
+              '\treturn *(const T*)((const char*)data + (size_t)stride * i);',
+              '}',
+              '',
+              'extern "C"',
+              '{']
+    first = True
+    for file_name, functions in parsed:
+        functions = [(restype, funcName, args) for restype, funcName, args in functions if isStrided(restype, args)]
+        if not functions:
+            continue
+        if not first:
+            header.append('')
+            source.append('')
+        first = False
+        header.append('\t// %s.h' % file_name)
+        for restype, funcName, args in functions:
+            signature = stridedSignature(restype, funcName, args)
+            header.append('\t%s;' % signature)
+            callArgs = ', '.join('_StridedAt(%s, %sStride, i)' % (name, name) if T in STRIDED_TYPES else name for T, name in args)
+            source.extend(['\t%s' % signature,
+                           '\t{',
+                           '\t\tfor (unsigned int i = 0; i < count; ++i)',
+                           '\t\t\t_StridedAt(result, resultStride, i) = %s(%s);' % (funcName, callArgs),
+                           '\t}'])
+    header.append('}')
+    source.append('}')
+    return '\n'.join(header) + '\n', '\n'.join(source) + '\n'
+
+
+def stridedPy(parsed):
+    register = ['def _registerStrided(instance):']
+    wrappers = []
+    for file_name, functions in parsed:
+        register.append('    # %s.h' % file_name)
+        for restype, funcName, args in functions:
+            if not isStrided(restype, args):
+                continue
+            argTypes = []
+            for T, name in args:
+                if T in STRIDED_TYPES:
+                    argTypes.append('ctypes.c_void_p, ctypes.c_uint')
+                else:
+                    argTypes.append(UNIFORM_TYPES[T])
+            argTypes.append('ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint')
+            register.append('    instance.%sStrided.argtypes = (%s)' % (funcName, ', '.join(argTypes)))
+            register.append('    instance.%sStrided.restype = None' % funcName)
+
+            names = [pyName(name) for T, name in args]
+            strided = [(pyName(name), STRIDED_TYPES[T]) for T, name in args if T in STRIDED_TYPES]
+            callArgs = []
+            for T, name in args:
+                if T in STRIDED_TYPES:
+                    callArgs.append('%s[0], %s[1]' % (pyName(name), pyName(name)))
+                else:
+                    callArgs.append(pyName(name))
+            wrapper = ['def %s%sStrided(%s, out=None):' % (funcName[0].lower(), funcName[1:], ', '.join(names)),
+                       '    [%s], count = _stridedArgs(%s)' % (', '.join(n for n, w in strided),
+                                                                ', '.join("(%s, %d, '%s')" % (n, w, n) for n, w in strided)),
+                       "    out, result = _stridedOut(out, count, %d, 'out')" % STRIDED_RESULT_TYPES[restype],
+                       '    _dll().%sStrided(%s, result[0], result[1], count)' % (funcName, ', '.join(callArgs)),
+                       '    return out']
+            wrappers.append('\n'.join(wrapper))
+    return BEGIN_MARKER + '# Generated by codegen.py, do not edit.\n' + '\n'.join(register) + '\n\n\n' + '\n\n\n'.join(wrappers) + '\n' + END_MARKER
+
+
+def isBenchmarked(restype, args):
+    return restype in BENCHMARK_RESULT_TYPES and all(T in BENCHMARK_TYPES for T, name in args)
+
+
+def benchmarkCpp(parsed, license):
+    # The component wise exports of Vector.cpp are not in any header, so declare them from their definitions
+    hidden = [f for f in parse('Vector.cpp', definitionPat) if isBenchmarked(f[0], f[2])]
+    declared = set(funcName for file_name, functions in parsed for restype, funcName, args in functions)
+    hidden = [f for f in hidden if f[1] not in declared]
+    code = [license,
+            '// Generated by codegen.py, do not edit.',
+            '#include "Benchmark.h"',
+            '#include <MMath/MMath.h>',
+            '#include <MMath/SIMD.h>',
+            '#include <MMath/Friends.h>',
+            '#include <MMath/Strided.h>',
+            '',
+            '// Exported by Vector.cpp for the bindings, but not declared in a header',
+            'extern "C"',
+            '{']
+    for restype, funcName, args in hidden:
+        code.append('	DLL %s %s(%s);' % (restype, funcName, ', '.join('const %s %s' % a for a in args)))
+    code.extend(['}',
+                 '',
+                 'void RunScalarBenchmarks()',
+                 '{'])
+    for file_name, functions in parsed + [('Vector.cpp', hidden)]:
+        functions = [f for f in functions if isBenchmarked(f[0], f[2])]
+        if not functions:
+            continue
+        code.append('	// %s' % (file_name if '.' in file_name else file_name + '.h'))
+        for restype, funcName, args in functions:
+            code.append('	BenchmarkScalar("%s", &%s);' % (funcName, funcName))
+    code.extend(['}',
+                 '',
+                 'void RunStridedBenchmarks()',
+                 '{'])
+    for file_name, functions in parsed:
+        if file_name not in keys:
+            continue
+        functions = [f for f in functions if isStrided(f[0], f[2])]
+        if not functions:
+            continue
+        code.append('	// %s.h' % file_name)
+        for restype, funcName, args in functions:
+            callArgs = []
+            for slot, (T, name) in enumerate(args):
+                if T in STRIDED_TYPES:
+                    callArgs.append('BenchmarkInput<%s>(%d), sizeof(%s)' % (T, slot, T))
+                else:
+                    callArgs.append('BenchmarkInput<%s>(%d)[0]' % (T, slot))
+            callArgs.append('BenchmarkOutput<%s>(), sizeof(%s), count' % (restype, restype))
+            code.append('	BenchmarkBatch("%sStrided", [](const unsigned int count) { %sStrided(%s); });' % (funcName, funcName, ', '.join(callArgs)))
+    code.append('}')
+    return '\n'.join(code) + '\n'
+
+
+def main():
+    parsed = [(file_name, list(parse(file_name))) for file_name in keys]
+    scalarBindings(parsed)
+
+    # reuse the license block of an existing header
+    with open(os.path.join(root, 'MMath', 'DLL.h')) as fh:
+        code = fh.read()
+    license = code[:code.index('**/') + 3]
+
+    header, source = stridedCpp(parsed, license)
+    with open(os.path.join(root, 'MMath', 'Strided.h'), 'w', newline='\n') as fh:
+        fh.write(header)
+    with open(os.path.join(root, 'MMath', 'Strided.cpp'), 'w', newline='\n') as fh:
+        fh.write(source)
+
+    benchmarkParsed = [(file_name, list(parse(file_name))) for file_name in BENCHMARK_KEYS]
+    with open(os.path.join(root, 'Benchmark', 'Generated.cpp'), 'w', newline='\n') as fh:
+        fh.write(benchmarkCpp(benchmarkParsed, license))
+
+    path = os.path.join(root, 'mmath.py')
+    with open(path) as fh:
+        code = fh.read()
+    start = code.index(BEGIN_MARKER)
+    end = code.index(END_MARKER) + len(END_MARKER)
+    with open(path, 'w', newline='\n') as fh:
+        fh.write(code[:start] + stridedPy(parsed) + code[end:])
+
+
+if __name__ == '__main__':
+    main()
@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 """
 import os
 import ctypes
+import numbers
 from MMath import menum
 from math import pi as PI
 
@@ -57,6 +58,16 @@ class Mat44ValidationFlags(menum.Enum, int):
         return ctypes.c_int.from_param(*args)
 
 
+class ENormalizeMode(menum.Enum, int):
+    Fast = 0
+    Refined = 1
+    Exact = 2
+
+    @classmethod
+    def from_param(cls, *args):
+        return ctypes.c_int.from_param(*args)
+
+
 def _dll():
     global _instance
     if _instance is not None:
@@ -160,6 +171,8 @@ def _dll():
     _instance.QuatMagnitude.restype = ctypes.c_float
     _instance.QuatNormalized.argtypes = (Quat, Quat)
     _instance.QuatNormalized.restype = Quat
+    _instance.QuatNormalizedMode.argtypes = (Quat, Quat, ENormalizeMode)
+    _instance.QuatNormalizedMode.restype = Quat
     _instance.QuatInversed.argtypes = (Quat,)
     _instance.QuatInversed.restype = Quat
     _instance.QuatConjugated.argtypes = (Quat,)
@@ -179,6 +192,8 @@ def _dll():
     _instance.Vec4Magnitude.restype = ctypes.c_float
     _instance.Vec4Normalized.argtypes = (Float4, Float4)
     _instance.Vec4Normalized.restype = Vec4
+    _instance.Vec4NormalizedMode.argtypes = (Float4, Float4, ENormalizeMode)
+    _instance.Vec4NormalizedMode.restype = Vec4
     _instance.Vec4NormalizedUnsafe.argtypes = (Float4,)
     _instance.Vec4NormalizedUnsafe.restype = Vec4
     _instance.Vec4Perpendicular.argtypes = (Float4,)
@@ -193,6 +208,8 @@ def _dll():
     _instance.Vec3Magnitude.restype = ctypes.c_float
     _instance.Vec3Normalized.argtypes = (Float4, Float4)
     _instance.Vec3Normalized.restype = Vec3
+    _instance.Vec3NormalizedMode.argtypes = (Float4, Float4, ENormalizeMode)
+    _instance.Vec3NormalizedMode.restype = Vec3
     _instance.Vec3NormalizedUnsafe.argtypes = (Float4,)
     _instance.Vec3NormalizedUnsafe.restype = Vec3
     _instance.Vec3Perpendicular.argtypes = (Float4,)
@@ -207,6 +224,8 @@ def _dll():
     _instance.Vec2Magnitude.restype = ctypes.c_float
     _instance.Vec2Normalized.argtypes = (Float4, Float4)
     _instance.Vec2Normalized.restype = Vec2
+    _instance.Vec2NormalizedMode.argtypes = (Float4, Float4, ENormalizeMode)
+    _instance.Vec2NormalizedMode.restype = Vec2
     _instance.Vec2NormalizedUnsafe.argtypes = (Float4,)
     _instance.Vec2NormalizedUnsafe.restype = Vec2
     _instance.Vec2Perpendicular.argtypes = (Float4,)
@@ -216,6 +235,28 @@ def _dll():
     _instance.QuatToMat44.restype = Mat44
     _instance.Mat44ToQuat.argtypes = (Mat44,)
     _instance.Mat44ToQuat.restype = Quat
+    _instance.Mat44ToQuatMode.argtypes = (Mat44, ENormalizeMode)
+    _instance.Mat44ToQuatMode.restype = Quat
+    # Batch functions, buffers are passed as plain addresses, see _floatBuffer
+    _instance.Mat44MulArray.argtypes = (ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint)
+    _instance.Mat44MulArray.restype = None
+    _instance.Mat44InversedArray.argtypes = (ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint)
+    _instance.Mat44InversedArray.restype = None
+    _instance.Mat44InversedCheckedArray.argtypes = (ctypes.c_void_p, ctypes.c_float, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint)
+    _instance.Mat44InversedCheckedArray.restype = None
+    _instance.Mat44VectorTransformArray.argtypes = (Mat44, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint)
+    _instance.Mat44VectorTransformArray.restype = None
+    _instance.Mat44TRSArray.argtypes = (ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ERotateOrder, ctypes.c_void_p, ctypes.c_uint)
+    _instance.Mat44TRSArray.restype = None
+    _instance.Mat44ToTRSArray.argtypes = (ctypes.c_void_p, ERotateOrder, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint)
+    _instance.Mat44ToTRSArray.restype = None
+    _instance.QuatToMat44Array.argtypes = (ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint)
+    _instance.QuatToMat44Array.restype = None
+    _instance.Mat44ToQuatArray.argtypes = (ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint)
+    _instance.Mat44ToQuatArray.restype = None
+    _instance.QuatNormalizedArray.argtypes = (ctypes.c_void_p, Quat, ctypes.c_void_p, ctypes.c_uint, ENormalizeMode)
+    _instance.QuatNormalizedArray.restype = None
+    _registerStrided(_instance)
     # Vector.cpp
     _instance.VecAdd.argtypes = (Float4, Float4)
     _instance.VecAdd.restype = Float4
@@ -691,6 +732,9 @@ class Mat44(ctypes.Union):
     def toQuat(self):
         return _dll().Mat44ToQuat(self)
 
+    def toQuatMode(self, mode):
+        return _dll().Mat44ToQuatMode(self, mode)
+
 
 class Quat(Float4):
     @staticmethod
@@ -724,6 +768,9 @@ class Quat(Float4):
     def normalized(self, fallback):
         return _dll().QuatNormalized(self, fallback)
 
+    def normalizedMode(self, fallback, mode):
+        return _dll().QuatNormalizedMode(self, fallback, mode)
+
     def inversed(self):
         return _dll().QuatInversed(self)
 
@@ -756,6 +803,9 @@ class Vec4(Float4):
     def normalized(self, fallback):
         return _dll().Vec4Normalized(self, fallback)
 
+    def normalizedMode(self, fallback, mode):
+        return _dll().Vec4NormalizedMode(self, fallback, mode)
+
     def normalizedUnsafe(self):
         return _dll().Vec4NormalizedUnsafe(self)
 
@@ -779,6 +829,9 @@ class Vec3(Float4):
     def normalized(self, fallback):
         return _dll().Vec3Normalized(self, fallback)
 
+    def normalizedMode(self, fallback, mode):
+        return _dll().Vec3NormalizedMode(self, fallback, mode)
+
     def normalizedUnsafe(self):
         return _dll().Vec3NormalizedUnsafe(self)
 
@@ -802,6 +855,9 @@ class Vec2(Float4):
     def normalized(self, fallback):
         return _dll().Vec2Normalized(self, fallback)
 
+    def normalizedMode(self, fallback, mode):
+        return _dll().Vec2NormalizedMode(self, fallback, mode)
+
     def normalizedUnsafe(self):
         return _dll().Vec2NormalizedUnsafe(self)
 
@@ -809,6 +865,941 @@ class Vec2(Float4):
         return _dll().Vec2Perpendicular(self)
 
 
+# Batch API
+# These take any C contiguous float32 buffer (numpy arrays, array.array('f'), ctypes float arrays) of shape (N, 16)
+# for matrices, or (N, 4) for vectors and quaternions, flat buffers holding a multiple of 16 or 4 floats also work.
+# Each function makes a single foreign call and reads / writes the buffers in place, without copying.
+# The C side uses aligned loads so buffers must start on a 16 byte boundary, which numpy and ctypes allocations do.
+# When out is omitted a new buffer is allocated, a numpy array if numpy is available and a ctypes array otherwise.
+# Outputs may be the same buffer as an input.
+def _floatBuffer(obj, width, name, writable=False):
+    # returns (address, element count) for a buffer of float32 elements that are width floats wide
+    try:
+        view = memoryview(obj)
+    except TypeError:
+        raise TypeError('%s must support the buffer protocol, got %s' % (name, type(obj).__name__))
+    if view.format.lstrip('@=<') != 'f' or view.itemsize != 4:
+        raise TypeError('%s must hold float32 values, got format %r' % (name, view.format))
+    if not view.c_contiguous:
+        raise ValueError('%s must be C contiguous' % name)
+    if writable and view.readonly:
+        raise ValueError('%s must be writable' % name)
+    inner = 1
+    for n in view.shape[1:]:
+        inner *= n
+    if view.ndim == 0 or (view.ndim > 1 and inner != width) or (view.nbytes // 4) % width:
+        raise ValueError('%s must have shape (N, %d), got %s' % (name, width, tuple(view.shape)))
+    count = view.nbytes // (4 * width)
+    if count > 0xFFFFFFFF:
+        raise ValueError('%s holds too many elements' % name)
+    if hasattr(obj, '__array_interface__'):
+        address = obj.__array_interface__['data'][0]
+    elif view.readonly:
+        raise TypeError('%s is a read-only buffer without __array_interface__, its address can not be taken' % name)
+    else:
+        address = ctypes.addressof((ctypes.c_char * view.nbytes).from_buffer(obj))
+    if address % 16:
+        raise ValueError('%s must be 16 byte aligned' % name)
+    return address, count
+
+
+def _outBuffer(out, count, width, name):
+    if out is None:
+        try:
+            import numpy
+            out = numpy.empty((count, width), numpy.float32)
+        except ImportError:
+            out = (ctypes.c_float * width * count)()
+    address, outCount = _floatBuffer(out, width, name, True)
+    if outCount != count:
+        raise ValueError('%s holds %d elements, expected %d' % (name, outCount, count))
+    return out, address
+
+
+def _sameCount(a, b, nameA, nameB):
+    if a != b:
+        raise ValueError('%s and %s hold a different number of elements (%d, %d)' % (nameA, nameB, a, b))
+
+
+def mat44MulArray(children, parents, out=None):
+    # out[i] = children[i] * parents[i], like Mat44.parented
+    a, count = _floatBuffer(children, 16, 'children')
+    b, parentCount = _floatBuffer(parents, 16, 'parents')
+    _sameCount(count, parentCount, 'children', 'parents')
+    out, r = _outBuffer(out, count, 16, 'out')
+    _dll().Mat44MulArray(a, b, r, count)
+    return out
+
+
+def mat44InversedArray(matrices, out=None):
+    a, count = _floatBuffer(matrices, 16, 'matrices')
+    out, r = _outBuffer(out, count, 16, 'out')
+    _dll().Mat44InversedArray(a, r, count)
+    return out
+
+
+def mat44InversedCheckedArray(matrices, epsilon=1e-6, out=None, determinants=None):
+    # returns (out, determinants, singular) where singular lists the indices of the matrices that could not be
+    # inverted reliably, their inverse is all zeros, see Mat44InversedCheckedArray in Mat44.h for what epsilon means
+    a, count = _floatBuffer(matrices, 16, 'matrices')
+    out, r = _outBuffer(out, count, 16, 'out')
+    determinants, d = _outBuffer(determinants, count, 1, 'determinants')
+    mask = (ctypes.c_ubyte * ((count + 7) // 8))()
+    _dll().Mat44InversedCheckedArray(a, epsilon, r, d, mask, count)
+    singular = [i * 8 + bit for i, bits in enumerate(mask) if bits for bit in range(8) if bits & (1 << bit) and i * 8 + bit < count]
+    return out, determinants, singular
+
+
+def mat44VectorTransformArray(m, vectors, out=None):
+    # transforms all vectors by one matrix, m is a Mat44 or a buffer of 16 floats
+    if not isinstance(m, Mat44):
+        _floatBuffer(m, 16, 'm')
+        m = Mat44.from_buffer_copy(m)
+    a, count = _floatBuffer(vectors, 4, 'vectors')
+    out, r = _outBuffer(out, count, 4, 'out')
+    _dll().Mat44VectorTransformArray(m, a, r, count)
+    return out
+
+
+def mat44TRSArray(translates, radians, scales, rotateOrder, out=None):
+    t, count = _floatBuffer(translates, 4, 'translates')
+    r, radiansCount = _floatBuffer(radians, 4, 'radians')
+    s, scalesCount = _floatBuffer(scales, 4, 'scales')
+    _sameCount(count, radiansCount, 'translates', 'radians')
+    _sameCount(count, scalesCount, 'translates', 'scales')
+    out, o = _outBuffer(out, count, 16, 'out')
+    _dll().Mat44TRSArray(t, r, s, rotateOrder, o, count)
+    return out
+
+
+def mat44ToTRSArray(matrices, rotateOrder, translates=None, radians=None, scales=None):
+    # returns (translates, radians, scales), assumes the matrices have no shear
+    a, count = _floatBuffer(matrices, 16, 'matrices')
+    translates, t = _outBuffer(translates, count, 4, 'translates')
+    radians, r = _outBuffer(radians, count, 4, 'radians')
+    scales, s = _outBuffer(scales, count, 4, 'scales')
+    _dll().Mat44ToTRSArray(a, rotateOrder, t, r, s, count)
+    return translates, radians, scales
+
+
+def quatToMat44Array(quats, out=None):
+    a, count = _floatBuffer(quats, 4, 'quats')
+    out, r = _outBuffer(out, count, 16, 'out')
+    _dll().QuatToMat44Array(a, r, count)
+    return out
+
+
+def mat44ToQuatArray(matrices, out=None):
+    a, count = _floatBuffer(matrices, 16, 'matrices')
+    out, r = _outBuffer(out, count, 4, 'out')
+    _dll().Mat44ToQuatArray(a, r, count)
+    return out
+
+
+def quatNormalizedArray(quats, mode, fallback=None, out=None):
+    a, count = _floatBuffer(quats, 4, 'quats')
+    out, r = _outBuffer(out, count, 4, 'out')
+    _dll().QuatNormalizedArray(a, Quat.identity() if fallback is None else fallback, r, count, mode)
+    return out
+
+
+# Strided batch API
+# codegen.py generates a <function>Strided variant of every scalar function below, e.g.
+# mat44MulStrided(rhs, lhs, out=None) or vec3DotStrided(a, b, out=None).
+# Every argument is a float32 buffer (or a numpy view into a larger array) of shape (N,) for floats,
+# (N, 4) for vectors and quaternions, (N, 16) or (N, 4, 4) for matrices, where the rows may be strided.
+# A single value (a float, Float4, Mat44, or a buffer holding one element) is used for every element.
+# Vectors, quaternions and matrices must be 16 byte aligned and have a stride that is a multiple of 16.
+def _alignedCopy(obj):
+    # ctypes only aligns structures to 4 bytes, the C side wants 16
+    size = ctypes.sizeof(obj)
+    keepAlive = (ctypes.c_char * (size + 15))()
+    address = (ctypes.addressof(keepAlive) + 15) & ~15
+    ctypes.memmove(address, ctypes.addressof(obj), size)
+    return address, keepAlive
+
+
+def _stridedBuffer(obj, width, name, writable=False):
+    # returns (address, stride in bytes, element count, object to keep alive), count is None for a single value
+    if not writable:
+        if width == 1 and isinstance(obj, numbers.Real):
+            keepAlive = ctypes.c_float(obj)
+            return ctypes.addressof(keepAlive), 0, None, keepAlive
+        if isinstance(obj, (Float4, Mat44)) and ctypes.sizeof(obj) == width * 4:
+            address, keepAlive = _alignedCopy(obj)
+            return address, 0, None, keepAlive
+    try:
+        view = memoryview(obj)
+    except TypeError:
+        raise TypeError('%s must be a float32 buffer, got %s' % (name, type(obj).__name__))
+    if view.format.lstrip('@=<') != 'f' or view.itemsize != 4:
+        raise TypeError('%s must hold float32 values, got format %r' % (name, view.format))
+    if writable and view.readonly:
+        raise ValueError('%s must be writable' % name)
+    if view.ndim == 1 and width > 1:
+        # flat buffer of elements
+        if view.strides[0] != 4 or view.shape[0] % width:
+            raise ValueError('%s must be a contiguous multiple of %d floats or have shape (N, %d)' % (name, width, width))
+        count = view.shape[0] // width
+        stride = width * 4
+    else:
+        inner = 1
+        innerStride = 4
+        for n, s in reversed(list(zip(view.shape[1:], view.strides[1:]))):
+            if n > 1 and s != innerStride:
+                raise ValueError('%s must have contiguous elements' % name)
+            inner *= n
+            innerStride *= n
+        if view.ndim == 0 or inner != width:
+            raise ValueError('%s must have shape (N, %d), got %s' % (name, width, tuple(view.shape)))
+        count = view.shape[0]
+        stride = view.strides[0]
+    if stride < 0 or stride > 0xFFFFFFFF or count > 0xFFFFFFFF:
+        raise ValueError('%s must have a positive stride below 4GB and less than 2^32 elements' % name)
+    if hasattr(obj, '__array_interface__'):
+        address = obj.__array_interface__['data'][0]
+    elif view.readonly or not view.c_contiguous:
+        raise TypeError('%s must be a numpy array, or a writable contiguous buffer' % name)
+    else:
+        address = ctypes.addressof((ctypes.c_char * view.nbytes).from_buffer(obj))
+    if width > 1 and (address % 16 or stride % 16):
+        raise ValueError('%s must be 16 byte aligned with a stride that is a multiple of 16' % name)
+    if count == 1 and not writable:
+        return address, 0, None, obj
+    return address, stride, count, obj
+
+
+def _stridedArgs(*args):
+    # args are (obj, width, name), returns ([(address, stride, keepAlive), ...], element count)
+    result = []
+    count = None
+    for obj, width, name in args:
+        address, stride, n, keepAlive = _stridedBuffer(obj, width, name)
+        if n is not None:
+            if count is None:
+                count, countName = n, name
+            elif n != count:
+                raise ValueError('%s holds %d elements but %s holds %d' % (name, n, countName, count))
+        result.append((address, stride, keepAlive))
+    return result, 1 if count is None else count
+
+
+def _stridedOut(out, count, width, name):
+    if out is None:
+        try:
+            import numpy
+            out = numpy.empty((count, width) if width > 1 else (count,), numpy.float32)
+        except ImportError:
+            out = (ctypes.c_float * width * count)() if width > 1 else (ctypes.c_float * count)()
+    address, stride, n, keepAlive = _stridedBuffer(out, width, name, True)
+    if n != count:
+        raise ValueError('%s holds %d elements, expected %d' % (name, n, count))
+    return out, (address, stride, keepAlive)
+
+
+# <codegen:strided>
+# Generated by codegen.py, do not edit.
+def _registerStrided(instance):
+    # Mat44.h
+    instance.Mat44TranslateStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44TranslateStrided.restype = None
+    instance.Mat44RotateXStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44RotateXStrided.restype = None
+    instance.Mat44RotateYStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44RotateYStrided.restype = None
+    instance.Mat44RotateZStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44RotateZStrided.restype = None
+    instance.Mat44ScaleStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44ScaleStrided.restype = None
+    instance.Mat44Scale2Strided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44Scale2Strided.restype = None
+    instance.Mat44MulStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44MulStrided.restype = None
+    instance.Mat44InversedStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44InversedStrided.restype = None
+    instance.Mat44InversedFastStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44InversedFastStrided.restype = None
+    instance.Mat44InversedFastNoScaleStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44InversedFastNoScaleStrided.restype = None
+    instance.Mat44TransposedStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44TransposedStrided.restype = None
+    instance.Mat44DeterminantStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44DeterminantStrided.restype = None
+    instance.Mat44VectorTransformStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44VectorTransformStrided.restype = None
+    instance.Mat44ToEulerStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ERotateOrder, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44ToEulerStrided.restype = None
+    instance.Mat44AxisAngleStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44AxisAngleStrided.restype = None
+    instance.Mat44AlignStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44AlignStrided.restype = None
+    instance.Mat44RotateTowardsStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44RotateTowardsStrided.restype = None
+    instance.Mat44LookAtStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, EAxis, EAxis, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44LookAtStrided.restype = None
+    instance.Mat44FromVectorsStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44FromVectorsStrided.restype = None
+    instance.Mat44ToTop33Strided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44ToTop33Strided.restype = None
+    instance.Mat44DeltaStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44DeltaStrided.restype = None
+    instance.Mat44RotateStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ERotateOrder, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44RotateStrided.restype = None
+    instance.Mat44Rotate2Strided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ERotateOrder, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44Rotate2Strided.restype = None
+    instance.EulerToMat44Strided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ERotateOrder, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.EulerToMat44Strided.restype = None
+    instance.Mat44TranslateRotateStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ERotateOrder, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44TranslateRotateStrided.restype = None
+    instance.Mat44TranslateRotate2Strided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ERotateOrder, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44TranslateRotate2Strided.restype = None
+    instance.Mat44TRSStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ERotateOrder, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44TRSStrided.restype = None
+    instance.Mat44TRS2Strided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ERotateOrder, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44TRS2Strided.restype = None
+    instance.Mat44ParentedStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44ParentedStrided.restype = None
+    instance.Mat44MakeValidStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, Mat44ValidationFlags, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44MakeValidStrided.restype = None
+    instance.Mat44ToScaleStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44ToScaleStrided.restype = None
+    instance.Mat44ToTranslateStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44ToTranslateStrided.restype = None
+    instance.Mat44FrustumStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44FrustumStrided.restype = None
+    instance.Mat44PerspectiveXStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44PerspectiveXStrided.restype = None
+    instance.Mat44PerspectiveYStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44PerspectiveYStrided.restype = None
+    instance.Mat44OrthographicStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44OrthographicStrided.restype = None
+    instance.Mat44OrthoSymmetricStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44OrthoSymmetricStrided.restype = None
+    # Quat.h
+    instance.QuatRotateXStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatRotateXStrided.restype = None
+    instance.QuatRotateYStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatRotateYStrided.restype = None
+    instance.QuatRotateZStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatRotateZStrided.restype = None
+    instance.QuatMulStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatMulStrided.restype = None
+    instance.QuatDotStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatDotStrided.restype = None
+    instance.QuatSqrMagnitudeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatSqrMagnitudeStrided.restype = None
+    instance.QuatMagnitudeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatMagnitudeStrided.restype = None
+    instance.QuatNormalizedStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatNormalizedStrided.restype = None
+    instance.QuatNormalizedModeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ENormalizeMode, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatNormalizedModeStrided.restype = None
+    instance.QuatInversedStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatInversedStrided.restype = None
+    instance.QuatConjugatedStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatConjugatedStrided.restype = None
+    instance.QuatSlerpStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatSlerpStrided.restype = None
+    instance.QuatVectorTransformStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatVectorTransformStrided.restype = None
+    instance.QuatToEulerStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ERotateOrder, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatToEulerStrided.restype = None
+    # Vector.h
+    instance.Vec4DotStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec4DotStrided.restype = None
+    instance.Vec4SqrMagnitudeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec4SqrMagnitudeStrided.restype = None
+    instance.Vec4MagnitudeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec4MagnitudeStrided.restype = None
+    instance.Vec4NormalizedStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec4NormalizedStrided.restype = None
+    instance.Vec4NormalizedModeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ENormalizeMode, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec4NormalizedModeStrided.restype = None
+    instance.Vec4NormalizedUnsafeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec4NormalizedUnsafeStrided.restype = None
+    instance.Vec4PerpendicularStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec4PerpendicularStrided.restype = None
+    instance.Vec3DotStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec3DotStrided.restype = None
+    instance.Vec3CrossStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec3CrossStrided.restype = None
+    instance.Vec3SqrMagnitudeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec3SqrMagnitudeStrided.restype = None
+    instance.Vec3MagnitudeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec3MagnitudeStrided.restype = None
+    instance.Vec3NormalizedStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec3NormalizedStrided.restype = None
+    instance.Vec3NormalizedModeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ENormalizeMode, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec3NormalizedModeStrided.restype = None
+    instance.Vec3NormalizedUnsafeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec3NormalizedUnsafeStrided.restype = None
+    instance.Vec3PerpendicularStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec3PerpendicularStrided.restype = None
+    instance.Vec2DotStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec2DotStrided.restype = None
+    instance.Vec2CrossStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec2CrossStrided.restype = None
+    instance.Vec2SqrMagnitudeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec2SqrMagnitudeStrided.restype = None
+    instance.Vec2MagnitudeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec2MagnitudeStrided.restype = None
+    instance.Vec2NormalizedStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec2NormalizedStrided.restype = None
+    instance.Vec2NormalizedModeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ENormalizeMode, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec2NormalizedModeStrided.restype = None
+    instance.Vec2NormalizedUnsafeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec2NormalizedUnsafeStrided.restype = None
+    instance.Vec2PerpendicularStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Vec2PerpendicularStrided.restype = None
+    # Friends.h
+    instance.QuatToMat44Strided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.QuatToMat44Strided.restype = None
+    instance.Mat44ToQuatStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44ToQuatStrided.restype = None
+    instance.Mat44ToQuatModeStrided.argtypes = (ctypes.c_void_p, ctypes.c_uint, ENormalizeMode, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
+    instance.Mat44ToQuatModeStrided.restype = None
+
+
+def mat44TranslateStrided(x, y, z, out=None):
+    [x, y, z], count = _stridedArgs((x, 1, 'x'), (y, 1, 'y'), (z, 1, 'z'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44TranslateStrided(x[0], x[1], y[0], y[1], z[0], z[1], result[0], result[1], count)
+    return out
+
+
+def mat44RotateXStrided(radians, out=None):
+    [radians], count = _stridedArgs((radians, 1, 'radians'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44RotateXStrided(radians[0], radians[1], result[0], result[1], count)
+    return out
+
+
+def mat44RotateYStrided(radians, out=None):
+    [radians], count = _stridedArgs((radians, 1, 'radians'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44RotateYStrided(radians[0], radians[1], result[0], result[1], count)
+    return out
+
+
+def mat44RotateZStrided(radians, out=None):
+    [radians], count = _stridedArgs((radians, 1, 'radians'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44RotateZStrided(radians[0], radians[1], result[0], result[1], count)
+    return out
+
+
+def mat44ScaleStrided(x, y, z, out=None):
+    [x, y, z], count = _stridedArgs((x, 1, 'x'), (y, 1, 'y'), (z, 1, 'z'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44ScaleStrided(x[0], x[1], y[0], y[1], z[0], z[1], result[0], result[1], count)
+    return out
+
+
+def mat44Scale2Strided(scale, out=None):
+    [scale], count = _stridedArgs((scale, 4, 'scale'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44Scale2Strided(scale[0], scale[1], result[0], result[1], count)
+    return out
+
+
+def mat44MulStrided(rhs, lhs, out=None):
+    [rhs, lhs], count = _stridedArgs((rhs, 16, 'rhs'), (lhs, 16, 'lhs'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44MulStrided(rhs[0], rhs[1], lhs[0], lhs[1], result[0], result[1], count)
+    return out
+
+
+def mat44InversedStrided(m, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44InversedStrided(m[0], m[1], result[0], result[1], count)
+    return out
+
+
+def mat44InversedFastStrided(m, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44InversedFastStrided(m[0], m[1], result[0], result[1], count)
+    return out
+
+
+def mat44InversedFastNoScaleStrided(m, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44InversedFastNoScaleStrided(m[0], m[1], result[0], result[1], count)
+    return out
+
+
+def mat44TransposedStrided(m, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44TransposedStrided(m[0], m[1], result[0], result[1], count)
+    return out
+
+
+def mat44DeterminantStrided(m, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Mat44DeterminantStrided(m[0], m[1], result[0], result[1], count)
+    return out
+
+
+def mat44VectorTransformStrided(m, v, out=None):
+    [m, v], count = _stridedArgs((m, 16, 'm'), (v, 4, 'v'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Mat44VectorTransformStrided(m[0], m[1], v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def mat44ToEulerStrided(m, ro, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Mat44ToEulerStrided(m[0], m[1], ro, result[0], result[1], count)
+    return out
+
+
+def mat44AxisAngleStrided(axis, radians, out=None):
+    [axis, radians], count = _stridedArgs((axis, 4, 'axis'), (radians, 1, 'radians'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44AxisAngleStrided(axis[0], axis[1], radians[0], radians[1], result[0], result[1], count)
+    return out
+
+
+def mat44AlignStrided(_from, to, out=None):
+    [_from, to], count = _stridedArgs((_from, 4, '_from'), (to, 4, 'to'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44AlignStrided(_from[0], _from[1], to[0], to[1], result[0], result[1], count)
+    return out
+
+
+def mat44RotateTowardsStrided(_from, to, out=None):
+    [_from, to], count = _stridedArgs((_from, 4, '_from'), (to, 4, 'to'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44RotateTowardsStrided(_from[0], _from[1], to[0], to[1], result[0], result[1], count)
+    return out
+
+
+def mat44LookAtStrided(targetDirection, upDirection, forward, upAxis, out=None):
+    [targetDirection, upDirection], count = _stridedArgs((targetDirection, 4, 'targetDirection'), (upDirection, 4, 'upDirection'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44LookAtStrided(targetDirection[0], targetDirection[1], upDirection[0], upDirection[1], forward, upAxis, result[0], result[1], count)
+    return out
+
+
+def mat44FromVectorsStrided(c0, c1, c2, translate, out=None):
+    [c0, c1, c2, translate], count = _stridedArgs((c0, 4, 'c0'), (c1, 4, 'c1'), (c2, 4, 'c2'), (translate, 4, 'translate'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44FromVectorsStrided(c0[0], c0[1], c1[0], c1[1], c2[0], c2[1], translate[0], translate[1], result[0], result[1], count)
+    return out
+
+
+def mat44ToTop33Strided(m, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44ToTop33Strided(m[0], m[1], result[0], result[1], count)
+    return out
+
+
+def mat44DeltaStrided(m, newParent, out=None):
+    [m, newParent], count = _stridedArgs((m, 16, 'm'), (newParent, 16, 'newParent'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44DeltaStrided(m[0], m[1], newParent[0], newParent[1], result[0], result[1], count)
+    return out
+
+
+def mat44RotateStrided(radiansX, radiansY, radiansZ, rotateOrder, out=None):
+    [radiansX, radiansY, radiansZ], count = _stridedArgs((radiansX, 1, 'radiansX'), (radiansY, 1, 'radiansY'), (radiansZ, 1, 'radiansZ'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44RotateStrided(radiansX[0], radiansX[1], radiansY[0], radiansY[1], radiansZ[0], radiansZ[1], rotateOrder, result[0], result[1], count)
+    return out
+
+
+def mat44Rotate2Strided(radians, rotateOrder, out=None):
+    [radians], count = _stridedArgs((radians, 4, 'radians'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44Rotate2Strided(radians[0], radians[1], rotateOrder, result[0], result[1], count)
+    return out
+
+
+def eulerToMat44Strided(radians, rotateOrder, out=None):
+    [radians], count = _stridedArgs((radians, 4, 'radians'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().EulerToMat44Strided(radians[0], radians[1], rotateOrder, result[0], result[1], count)
+    return out
+
+
+def mat44TranslateRotateStrided(x, y, z, radiansX, radiansY, radiansZ, rotateOrder, out=None):
+    [x, y, z, radiansX, radiansY, radiansZ], count = _stridedArgs((x, 1, 'x'), (y, 1, 'y'), (z, 1, 'z'), (radiansX, 1, 'radiansX'), (radiansY, 1, 'radiansY'), (radiansZ, 1, 'radiansZ'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44TranslateRotateStrided(x[0], x[1], y[0], y[1], z[0], z[1], radiansX[0], radiansX[1], radiansY[0], radiansY[1], radiansZ[0], radiansZ[1], rotateOrder, result[0], result[1], count)
+    return out
+
+
+def mat44TranslateRotate2Strided(translate, radians, rotateOrder, out=None):
+    [translate, radians], count = _stridedArgs((translate, 4, 'translate'), (radians, 4, 'radians'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44TranslateRotate2Strided(translate[0], translate[1], radians[0], radians[1], rotateOrder, result[0], result[1], count)
+    return out
+
+
+def mat44TRSStrided(x, y, z, radiansX, radiansY, radiansZ, scaleX, scaleY, scaleZ, rotateOrder, out=None):
+    [x, y, z, radiansX, radiansY, radiansZ, scaleX, scaleY, scaleZ], count = _stridedArgs((x, 1, 'x'), (y, 1, 'y'), (z, 1, 'z'), (radiansX, 1, 'radiansX'), (radiansY, 1, 'radiansY'), (radiansZ, 1, 'radiansZ'), (scaleX, 1, 'scaleX'), (scaleY, 1, 'scaleY'), (scaleZ, 1, 'scaleZ'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44TRSStrided(x[0], x[1], y[0], y[1], z[0], z[1], radiansX[0], radiansX[1], radiansY[0], radiansY[1], radiansZ[0], radiansZ[1], scaleX[0], scaleX[1], scaleY[0], scaleY[1], scaleZ[0], scaleZ[1], rotateOrder, result[0], result[1], count)
+    return out
+
+
+def mat44TRS2Strided(translate, radians, scale, rotateOrder, out=None):
+    [translate, radians, scale], count = _stridedArgs((translate, 4, 'translate'), (radians, 4, 'radians'), (scale, 4, 'scale'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44TRS2Strided(translate[0], translate[1], radians[0], radians[1], scale[0], scale[1], rotateOrder, result[0], result[1], count)
+    return out
+
+
+def mat44ParentedStrided(child, parent, out=None):
+    [child, parent], count = _stridedArgs((child, 16, 'child'), (parent, 16, 'parent'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44ParentedStrided(child[0], child[1], parent[0], parent[1], result[0], result[1], count)
+    return out
+
+
+def mat44MakeValidStrided(m, flags, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44MakeValidStrided(m[0], m[1], flags, result[0], result[1], count)
+    return out
+
+
+def mat44ToScaleStrided(m, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Mat44ToScaleStrided(m[0], m[1], result[0], result[1], count)
+    return out
+
+
+def mat44ToTranslateStrided(m, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Mat44ToTranslateStrided(m[0], m[1], result[0], result[1], count)
+    return out
+
+
+def mat44FrustumStrided(left, right, top, bottom, near, far, out=None):
+    [left, right, top, bottom, near, far], count = _stridedArgs((left, 1, 'left'), (right, 1, 'right'), (top, 1, 'top'), (bottom, 1, 'bottom'), (near, 1, 'near'), (far, 1, 'far'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44FrustumStrided(left[0], left[1], right[0], right[1], top[0], top[1], bottom[0], bottom[1], near[0], near[1], far[0], far[1], result[0], result[1], count)
+    return out
+
+
+def mat44PerspectiveXStrided(horizontalFieldOfViewRadians, aspectRatio, near, far, out=None):
+    [horizontalFieldOfViewRadians, aspectRatio, near, far], count = _stridedArgs((horizontalFieldOfViewRadians, 1, 'horizontalFieldOfViewRadians'), (aspectRatio, 1, 'aspectRatio'), (near, 1, 'near'), (far, 1, 'far'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44PerspectiveXStrided(horizontalFieldOfViewRadians[0], horizontalFieldOfViewRadians[1], aspectRatio[0], aspectRatio[1], near[0], near[1], far[0], far[1], result[0], result[1], count)
+    return out
+
+
+def mat44PerspectiveYStrided(verticalFieldOfViewRadians, aspectRatio, near, far, out=None):
+    [verticalFieldOfViewRadians, aspectRatio, near, far], count = _stridedArgs((verticalFieldOfViewRadians, 1, 'verticalFieldOfViewRadians'), (aspectRatio, 1, 'aspectRatio'), (near, 1, 'near'), (far, 1, 'far'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44PerspectiveYStrided(verticalFieldOfViewRadians[0], verticalFieldOfViewRadians[1], aspectRatio[0], aspectRatio[1], near[0], near[1], far[0], far[1], result[0], result[1], count)
+    return out
+
+
+def mat44OrthographicStrided(left, right, top, bottom, near, far, out=None):
+    [left, right, top, bottom, near, far], count = _stridedArgs((left, 1, 'left'), (right, 1, 'right'), (top, 1, 'top'), (bottom, 1, 'bottom'), (near, 1, 'near'), (far, 1, 'far'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44OrthographicStrided(left[0], left[1], right[0], right[1], top[0], top[1], bottom[0], bottom[1], near[0], near[1], far[0], far[1], result[0], result[1], count)
+    return out
+
+
+def mat44OrthoSymmetricStrided(width, height, near, far, out=None):
+    [width, height, near, far], count = _stridedArgs((width, 1, 'width'), (height, 1, 'height'), (near, 1, 'near'), (far, 1, 'far'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().Mat44OrthoSymmetricStrided(width[0], width[1], height[0], height[1], near[0], near[1], far[0], far[1], result[0], result[1], count)
+    return out
+
+
+def quatRotateXStrided(radians, out=None):
+    [radians], count = _stridedArgs((radians, 1, 'radians'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatRotateXStrided(radians[0], radians[1], result[0], result[1], count)
+    return out
+
+
+def quatRotateYStrided(radians, out=None):
+    [radians], count = _stridedArgs((radians, 1, 'radians'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatRotateYStrided(radians[0], radians[1], result[0], result[1], count)
+    return out
+
+
+def quatRotateZStrided(radians, out=None):
+    [radians], count = _stridedArgs((radians, 1, 'radians'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatRotateZStrided(radians[0], radians[1], result[0], result[1], count)
+    return out
+
+
+def quatMulStrided(lhs, rhs, out=None):
+    [lhs, rhs], count = _stridedArgs((lhs, 4, 'lhs'), (rhs, 4, 'rhs'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatMulStrided(lhs[0], lhs[1], rhs[0], rhs[1], result[0], result[1], count)
+    return out
+
+
+def quatDotStrided(a, b, out=None):
+    [a, b], count = _stridedArgs((a, 4, 'a'), (b, 4, 'b'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().QuatDotStrided(a[0], a[1], b[0], b[1], result[0], result[1], count)
+    return out
+
+
+def quatSqrMagnitudeStrided(q, out=None):
+    [q], count = _stridedArgs((q, 4, 'q'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().QuatSqrMagnitudeStrided(q[0], q[1], result[0], result[1], count)
+    return out
+
+
+def quatMagnitudeStrided(q, out=None):
+    [q], count = _stridedArgs((q, 4, 'q'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().QuatMagnitudeStrided(q[0], q[1], result[0], result[1], count)
+    return out
+
+
+def quatNormalizedStrided(q, fallback, out=None):
+    [q, fallback], count = _stridedArgs((q, 4, 'q'), (fallback, 4, 'fallback'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatNormalizedStrided(q[0], q[1], fallback[0], fallback[1], result[0], result[1], count)
+    return out
+
+
+def quatNormalizedModeStrided(q, fallback, mode, out=None):
+    [q, fallback], count = _stridedArgs((q, 4, 'q'), (fallback, 4, 'fallback'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatNormalizedModeStrided(q[0], q[1], fallback[0], fallback[1], mode, result[0], result[1], count)
+    return out
+
+
+def quatInversedStrided(q, out=None):
+    [q], count = _stridedArgs((q, 4, 'q'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatInversedStrided(q[0], q[1], result[0], result[1], count)
+    return out
+
+
+def quatConjugatedStrided(q, out=None):
+    [q], count = _stridedArgs((q, 4, 'q'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatConjugatedStrided(q[0], q[1], result[0], result[1], count)
+    return out
+
+
+def quatSlerpStrided(l, r, t, out=None):
+    [l, r, t], count = _stridedArgs((l, 4, 'l'), (r, 4, 'r'), (t, 1, 't'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatSlerpStrided(l[0], l[1], r[0], r[1], t[0], t[1], result[0], result[1], count)
+    return out
+
+
+def quatVectorTransformStrided(q, v, out=None):
+    [q, v], count = _stridedArgs((q, 4, 'q'), (v, 4, 'v'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatVectorTransformStrided(q[0], q[1], v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def quatToEulerStrided(q, order, out=None):
+    [q], count = _stridedArgs((q, 4, 'q'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().QuatToEulerStrided(q[0], q[1], order, result[0], result[1], count)
+    return out
+
+
+def vec4DotStrided(a, b, out=None):
+    [a, b], count = _stridedArgs((a, 4, 'a'), (b, 4, 'b'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec4DotStrided(a[0], a[1], b[0], b[1], result[0], result[1], count)
+    return out
+
+
+def vec4SqrMagnitudeStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec4SqrMagnitudeStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec4MagnitudeStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec4MagnitudeStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec4NormalizedStrided(v, fallback, out=None):
+    [v, fallback], count = _stridedArgs((v, 4, 'v'), (fallback, 4, 'fallback'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec4NormalizedStrided(v[0], v[1], fallback[0], fallback[1], result[0], result[1], count)
+    return out
+
+
+def vec4NormalizedModeStrided(v, fallback, mode, out=None):
+    [v, fallback], count = _stridedArgs((v, 4, 'v'), (fallback, 4, 'fallback'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec4NormalizedModeStrided(v[0], v[1], fallback[0], fallback[1], mode, result[0], result[1], count)
+    return out
+
+
+def vec4NormalizedUnsafeStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec4NormalizedUnsafeStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec4PerpendicularStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec4PerpendicularStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec3DotStrided(a, b, out=None):
+    [a, b], count = _stridedArgs((a, 4, 'a'), (b, 4, 'b'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec3DotStrided(a[0], a[1], b[0], b[1], result[0], result[1], count)
+    return out
+
+
+def vec3CrossStrided(a, b, out=None):
+    [a, b], count = _stridedArgs((a, 4, 'a'), (b, 4, 'b'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec3CrossStrided(a[0], a[1], b[0], b[1], result[0], result[1], count)
+    return out
+
+
+def vec3SqrMagnitudeStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec3SqrMagnitudeStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec3MagnitudeStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec3MagnitudeStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec3NormalizedStrided(v, fallback, out=None):
+    [v, fallback], count = _stridedArgs((v, 4, 'v'), (fallback, 4, 'fallback'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec3NormalizedStrided(v[0], v[1], fallback[0], fallback[1], result[0], result[1], count)
+    return out
+
+
+def vec3NormalizedModeStrided(v, fallback, mode, out=None):
+    [v, fallback], count = _stridedArgs((v, 4, 'v'), (fallback, 4, 'fallback'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec3NormalizedModeStrided(v[0], v[1], fallback[0], fallback[1], mode, result[0], result[1], count)
+    return out
+
+
+def vec3NormalizedUnsafeStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec3NormalizedUnsafeStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec3PerpendicularStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec3PerpendicularStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec2DotStrided(a, b, out=None):
+    [a, b], count = _stridedArgs((a, 4, 'a'), (b, 4, 'b'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec2DotStrided(a[0], a[1], b[0], b[1], result[0], result[1], count)
+    return out
+
+
+def vec2CrossStrided(a, b, out=None):
+    [a, b], count = _stridedArgs((a, 4, 'a'), (b, 4, 'b'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec2CrossStrided(a[0], a[1], b[0], b[1], result[0], result[1], count)
+    return out
+
+
+def vec2SqrMagnitudeStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec2SqrMagnitudeStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec2MagnitudeStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 1, 'out')
+    _dll().Vec2MagnitudeStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec2NormalizedStrided(v, fallback, out=None):
+    [v, fallback], count = _stridedArgs((v, 4, 'v'), (fallback, 4, 'fallback'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec2NormalizedStrided(v[0], v[1], fallback[0], fallback[1], result[0], result[1], count)
+    return out
+
+
+def vec2NormalizedModeStrided(v, fallback, mode, out=None):
+    [v, fallback], count = _stridedArgs((v, 4, 'v'), (fallback, 4, 'fallback'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec2NormalizedModeStrided(v[0], v[1], fallback[0], fallback[1], mode, result[0], result[1], count)
+    return out
+
+
+def vec2NormalizedUnsafeStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec2NormalizedUnsafeStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def vec2PerpendicularStrided(v, out=None):
+    [v], count = _stridedArgs((v, 4, 'v'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Vec2PerpendicularStrided(v[0], v[1], result[0], result[1], count)
+    return out
+
+
+def quatToMat44Strided(q, out=None):
+    [q], count = _stridedArgs((q, 4, 'q'))
+    out, result = _stridedOut(out, count, 16, 'out')
+    _dll().QuatToMat44Strided(q[0], q[1], result[0], result[1], count)
+    return out
+
+
+def mat44ToQuatStrided(m, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Mat44ToQuatStrided(m[0], m[1], result[0], result[1], count)
+    return out
+
+
+def mat44ToQuatModeStrided(m, mode, out=None):
+    [m], count = _stridedArgs((m, 16, 'm'))
+    out, result = _stridedOut(out, count, 4, 'out')
+    _dll().Mat44ToQuatModeStrided(m[0], m[1], mode, result[0], result[1], count)
+    return out
+# </codegen:strided>
+
+
 # print Mat44.TRS(0.5, 1.5, -2.5, 0.0, 3.14159265359 * 0.5, 0.0, 1.0, 2.0, 1.0, ERotateOrder.XYZ)
 
 